@@ -1,6 +1,7 @@
 #pragma once
 
 #include <filesystem>
+#include <format>
 #include <string>
 #include <string_view>
 #include <stdexcept>
@@ -3,6 +3,8 @@
 #include <dbprove/common/docker.h>
 #include <dbprove/ux/ux.h>
 #include <dbprove/sql/sql.h>
+#include <dbprove/sql/artefact_pack.h>
+#include <dbprove/sql/connection_pool.h>
 #include <dbprove/common/log_formatter.h>
 #include <dbprove/common/file_utility.h>
 #include <dbprove/common/string.h>
@@ -11,6 +13,9 @@
 #include <iostream>
 #include <string>
 #include <thread>
+#include <atomic>
+#include <mutex>
+#include <vector>
 #include <version>
 #include <format>
 #include <ranges>
@@ -350,6 +355,233 @@ void startLocalIcebergCatalog() {
 }
 }
 
+/**
+ * Compact the artefact pack of every engine under an artefacts directory
+ * @param artefacts_directory Directory as passed to `--artefact-dir`, with one subdirectory per engine
+ */
+int compactArtefacts(const fs::path& artefacts_directory) {
+  if (!fs::is_directory(artefacts_directory)) {
+    std::cerr << "Error: artefact directory does not exist: " << artefacts_directory.string() << std::endl;
+    return 1;
+  }
+  for (const auto& entry : fs::directory_iterator(artefacts_directory)) {
+    if (!entry.is_directory()) {
+      continue;
+    }
+    const auto stats = sql::ArtefactPack::compact(entry.path());
+    PLOGI << "Compacted " << entry.path().string() << ": " << stats.entries << " artefacts, dropped "
+          << stats.stale_entries << " stale entries, imported " << stats.imported_files << " loose files ("
+          << stats.bytes_before << " -> " << stats.bytes_after << " bytes)";
+  }
+  return 0;
+}
+
+/**
+ * Options from the command line shared by every engine in the run
+ */
+struct RunOptions {
+  std::optional<std::string> host;
+  uint32_t port = 0;
+  std::optional<std::string> database;
+  std::optional<std::string> username;
+  std::optional<std::string> password;
+  std::optional<std::string> token;
+  std::string data_bucket_uri;
+  std::optional<std::string> download_dir_override;
+  std::optional<std::string> artefact_directory_override;
+  std::optional<std::string> docker_variant_arg;
+  std::optional<std::string> parquet_dir;
+  std::optional<std::string> config;
+  bool docker_mode = false;
+  uint32_t query_timeout_seconds = 0;
+  uint32_t timing_runs = 3;
+  uint32_t jobs = 1;
+  bool single_execution_explain = false;
+  bool prepared = false;
+  uint32_t pool_size = 0;
+};
+
+/// @brief Log what opening and waiting for pooled connections cost over the run
+void logPoolMetrics(const sql::Engine& engine, const sql::ConnectionPool::Metrics& metrics) {
+  const auto average_us = [](const std::chrono::microseconds total, const size_t count) {
+    return count == 0 ? 0 : total.count() / static_cast<int64_t>(count);
+  };
+  PLOGI << engine.name() << " connection pool: " << metrics.connects << " connects (avg "
+        << average_us(metrics.connect_time, metrics.connects) << " us), " << metrics.acquires << " acquires, "
+        << metrics.waits << " waited (avg " << average_us(metrics.acquire_wait, metrics.acquires) << " us, max "
+        << metrics.max_acquire_wait.count() << " us), " << metrics.discarded << " discarded";
+}
+
+/**
+ * Prove the theorems against one engine, with its own RunCtx, connection factory and proof directory
+ * @param shared_console_mutex Set when other engines print to the console at the same time
+ */
+bool proveEngine(const sql::Engine& engine, RunOptions options, const std::vector<const theorem::Theorem*>& theorems,
+                 std::mutex* shared_console_mutex) {
+  options.database = engine.defaultDatabase(options.database);
+  options.host = engine.defaultHost(options.host);
+  options.port = engine.defaultPort(options.port, options.docker_mode);
+  options.username = engine.defaultUsername(options.username);
+  options.password = engine.defaultPassword(options.password);
+  if (options.docker_mode && engine.type() == sql::Engine::Type::Postgres
+      && (!options.password.has_value() || options.password->empty())) {
+    options.password = "postgres";
+  }
+  options.token = engine.defaultToken(options.token);
+
+  PLOGI << "Using engine: " << engine.name();
+  PLOGI << "  host      : " << options.host.value();
+  PLOGI << "  port      : " << options.port;
+  PLOGI << "  database  : " << options.database.value();
+
+  auto credentials =
+      parseCredentials(
+          engine,
+          options.host.value(),
+          options.port,
+          options.database.value(),
+          options.username,
+          options.password,
+          options.token,
+          options.data_bucket_uri);
+  const auto theorem_required_variant = theoremStorageVariantRequirement(theorems);
+  const auto requested_docker_variant = parseStorageVariant(options.docker_variant_arg);
+
+  if (requested_docker_variant.has_value() && !options.docker_mode) {
+    throw std::runtime_error("--variant requires --docker");
+  }
+
+  if (engine.type() == sql::Engine::Type::Databricks
+      && requested_docker_variant == dbprove::StorageVariant::Iceberg) {
+    throw std::runtime_error(
+        "Databricks does not support the 'iceberg' storage variant. "
+        "Only 'native' (Delta) is supported.");
+  }
+
+  if (requested_docker_variant.has_value() && theorem_required_variant.has_value()
+      && *requested_docker_variant != *theorem_required_variant) {
+    throw std::runtime_error(
+        "Selected theorems require storage variant '"
+        + std::string(to_string(*theorem_required_variant))
+        + "', but '--variant " + std::string(to_string(*requested_docker_variant)) + "' was requested");
+  }
+
+  std::optional<dbprove::StorageVariant> effective_docker_variant = std::nullopt;
+  if (options.docker_mode) {
+    effective_docker_variant = requested_docker_variant;
+    if (!effective_docker_variant.has_value()) {
+      effective_docker_variant = theorem_required_variant.has_value()
+                               ? theorem_required_variant
+                               : engine.defaultStorageVariant();
+    }
+    if (!effective_docker_variant.has_value()) {
+      throw std::runtime_error(
+          "Docker mode is not supported for engine '" + engine.name()
+          + "' because there is no local docker service mapping for it");
+    }
+  }
+
+  const auto effective_storage_variant = options.docker_mode
+                                       ? *effective_docker_variant
+                                       : engine.defaultStorageVariant().value_or(dbprove::StorageVariant::Native);
+
+  auto generator_state = configureDataGeneration(
+      engine,
+      options.data_bucket_uri,
+      options.download_dir_override,
+      effective_storage_variant);
+
+  PLOGI << "Generating into directory: " << generator_state.basePath();
+
+  const bool artifact_mode = options.artefact_directory_override.has_value();
+  sql::setArtifactReplayMode(artifact_mode);
+
+  std::unique_ptr<common::DockerComposeSession> docker_session;
+  if (options.docker_mode && !artifact_mode) {
+    cleanupManagedDockerState();
+
+    if (requiresMountedTpchParquet(engine, *effective_docker_variant)) {
+      PLOGI << "Pre-staging TPCH CSV/parquet inputs under " << generator_state.basePath()
+            << " before starting docker-managed " << engine.name();
+      generator_state.ensureDatasetFiles("tpch_sf1");
+    }
+
+    if (*effective_docker_variant == dbprove::StorageVariant::Iceberg) {
+      PLOGI << "Starting local iceberg catalog sidecar";
+      startLocalIcebergCatalog();
+    }
+
+    const auto service_config = engine.dockerServiceConfig(*effective_docker_variant);
+    if (!service_config.has_value()) {
+      throw std::runtime_error(
+          "Storage variant '" + std::string(to_string(*effective_docker_variant))
+          + "' is not available for engine '" + engine.name() + "'");
+    }
+
+    PLOGI << "Docker mode enabled for engine '" << engine.name()
+          << "' using variant '" << to_string(*effective_docker_variant)
+          << "' and service '" << service_config->service_name << "'";
+    docker_session = std::make_unique<common::DockerComposeSession>();
+    docker_session->start(service_config->service_name);
+    engine.waitForDockerReady(credentials, service_config->readiness_timeout);
+  } else if (options.docker_mode && artifact_mode) {
+    PLOGI << "Artifact replay mode enabled: skipping docker service startup";
+  }
+
+  std::string engine_version = "unknown";
+  if (!artifact_mode) {
+    try {
+      sql::ConnectionFactory factory(engine, credentials, std::nullopt);
+      auto connection = factory.create();
+      engine_version = connection->version();
+      connection->close();
+    } catch (const std::exception& e) {
+      PLOGW << "Failed to retrieve engine version: " << e.what();
+    }
+  }
+
+  const auto connection_artifacts_path = artifact_mode
+                                       ? options.artefact_directory_override
+                                       : std::optional<std::string>(defaultArtifactsDirectory(engine, engine_version).string());
+
+  std::optional<fs::path> proof_directory = std::nullopt;
+  if (!artifact_mode) {
+    proof_directory = proofVersionDirectory(engine, engine_version);
+    PLOGI << "Writing theorem proof JSON files to: "
+          << fs::absolute(*proof_directory).string();
+  } else {
+    PLOGI << "Artifact mode enabled: skipping engine version check and theorem proof JSON output";
+  }
+
+  if (connection_artifacts_path) {
+    PLOGI << (artifact_mode ? "Using replay artefacts directory: " : "Writing artefacts directory: ")
+          << fs::absolute(connection_artifacts_path.value()).string();
+  }
+
+  auto input_state = theorem::RunCtx{engine, credentials, generator_state,
+                                     std::cout, engine_version, connection_artifacts_path,
+                                     effective_storage_variant,
+                                     options.query_timeout_seconds > 0 ? std::optional<uint32_t>(options.query_timeout_seconds) : std::nullopt,
+                                     options.timing_runs,
+                                     options.parquet_dir,
+                                     proof_directory,
+                                     artifact_mode,
+                                     options.config};
+  input_state.single_execution_explain = options.single_execution_explain;
+  input_state.execution_mode = options.prepared ? sql::ExecutionMode::Prepared : sql::ExecutionMode::Text;
+  input_state.jobs = options.jobs;
+  input_state.shared_console_mutex = shared_console_mutex;
+  if (options.pool_size > 0) {
+    input_state.factory.enablePooling(options.pool_size);
+  }
+
+  const auto proven = theorem::prove(theorems, input_state);
+  if (const auto* pool = input_state.factory.pool()) {
+    logPoolMetrics(engine, pool->metrics());
+  }
+  return proven;
+}
+
 int main(int argc, char** argv) {
   std::set_terminate(TerminateHandler);
 
@@ -369,21 +601,26 @@ int main(int argc, char** argv) {
   std::optional<std::string> docker_variant_arg = std::nullopt;
   std::optional<std::string> parquet_dir = std::nullopt;
   std::vector<std::string> all_theorems;
-  std::string engine_arg;
+  std::vector<std::string> engine_args;
   uint32_t port;
   uint32_t query_timeout_seconds = 0;
   uint32_t timing_runs = 3;
+  uint32_t jobs = 1;
   bool verbose = false;
   bool docker_mode = false;
   bool prepare_ee_join_scale = false;
+  bool single_execution_explain = false;
+  bool prepared = false;
+  uint32_t pool_size = 0;
   bool list_theorems = false;
   std::optional<std::string> publish_as = std::nullopt;
+  std::optional<std::string> compact_artefacts_dir = std::nullopt;
   std::optional<std::string> config_str = std::nullopt;
 
   app.set_help_flag("-?", "--help");
   app.add_option(
       "-e, --engine",
-      engine_arg);
+      engine_args, "Engine to prove against. Several comma separated engines are proven concurrently")->delimiter(',');
 
   app.add_flag("-L,--list", list_theorems, "List available theorems");
   app.add_option("--publish", publish_as, "Publish proof results to the dbprove-results repo as this publisher name");
@@ -414,6 +651,9 @@ int main(int argc, char** argv) {
   app.add_option("--artefact-dir",
                  artefact_directory_override,
                  "Directory to replay explain artefacts from. Missing artefacts are treated as errors.");
+  app.add_option("--compact-artefacts",
+                 compact_artefacts_dir,
+                 "Compact the artefact packs under this artefacts directory, dropping stale entries, then exit");
   app.add_option("--log-dir",
                  log_directory_override,
                  "Directory to write dbprove log files to");
@@ -426,11 +666,25 @@ int main(int argc, char** argv) {
                prepare_ee_join_scale,
                "Materialize EE join-scale parquet inputs on the host using in-process DuckDB");
   app.add_option("-T,--theorem",
-                 all_theorems, "Which theorems to prove")->delimiter(',');
+                 all_theorems,
+                 "Which theorems to prove. Defaults to all except those tagged OPT-IN, such as the WLM workloads, "
+                 "which run when selected by name, tag or category")->delimiter(',');
   app.add_option("--query-timeout",
                  query_timeout_seconds, "Query timeout in seconds (0 disables timeout)")->default_val(0);
   app.add_option("--timing-runs",
                  timing_runs, "Number of measured executions per query theorem")->default_val(3);
+  app.add_option("-j,--jobs",
+                 jobs, "Number of theorems to prove concurrently (CLI, EE and WLM theorems run one at a time)")->default_val(1);
+  app.add_flag("--single-execution-explain",
+               single_execution_explain,
+               "Time PLAN queries from the server measured EXPLAIN ANALYZE execution instead of running them twice");
+  app.add_flag("--prepared",
+               prepared,
+               "Prepare timed queries once and time only their executions. The prepare time is reported separately");
+  app.add_option("--pool-size",
+                 pool_size,
+                 "Reuse up to N open connections per engine instead of connecting for every run (0 disables pooling)")
+     ->default_val(0);
   app.add_option("-c,--config",
                  config_str, "Free-text string written to the 'config' field of proof JSON output")->envname("DBPROVE_CONFIG");
 
@@ -456,11 +710,32 @@ int main(int argc, char** argv) {
     return publishResults(*publish_as);
   }
 
-  const sql::Engine engine(engine_arg);
+  if (compact_artefacts_dir) {
+    plog::init<plog::DBProveFormatter>(verbose ? plog::debug : plog::info, plog::streamStdOut);
+    return compactArtefacts(*compact_artefacts_dir);
+  }
+
+  if (engine_args.empty()) {
+    engine_args.emplace_back();
+  }
+  std::vector<sql::Engine> engines;
+  for (const auto& engine_arg : engine_args) {
+    engines.emplace_back(engine_arg);
+  }
+  if (engines.size() > 1 && docker_mode) {
+    std::cerr << "Error: --docker runs every engine on the same host port, so it takes a single engine." << std::endl;
+    return 1;
+  }
+  if (engines.size() > 1 && artefact_directory_override) {
+    std::cerr << "Error: --artefact-dir replays the artefacts of a single engine." << std::endl;
+    return 1;
+  }
 
   const auto log_directory = log_directory_override
                            ? common::make_directory(*log_directory_override)
-                           : defaultLogDirectory(engine);
+                           : engines.size() == 1
+                           ? defaultLogDirectory(engines.front())
+                           : common::make_directory((proofBaseDirectory() / "logs").string());
   const std::string log_file = (log_directory / "dbprove.log").string();
   const auto log_level = verbose ? plog::debug : plog::info;
 
@@ -478,157 +753,50 @@ int main(int argc, char** argv) {
 
   ux::Terminal::configure();
 
-  database = engine.defaultDatabase(database);
-  host = engine.defaultHost(host);
-  port = engine.defaultPort(port, docker_mode);
-  username = engine.defaultUsername(username);
-  password = engine.defaultPassword(password);
-  if (docker_mode && engine.type() == sql::Engine::Type::Postgres
-      && (!password.has_value() || password->empty())) {
-    password = "postgres";
-  }
-  token = engine.defaultToken(token);
-
-  PLOGI << "Using engine: " << engine.name();
-  PLOGI << "  host      : " << host.value();
-  PLOGI << "  port      : " << port;
-  PLOGI << "  database  : " << database.value();
-
-  auto credentials =
-      parseCredentials(
-          engine,
-          host.value(),
-          port,
-          database.value(),
-          username,
-          password,
-          token,
-          data_bucket_uri);
   theorem::init();
-  auto theorems = theorem::parse(all_theorems);
-  const auto theorem_required_variant = theoremStorageVariantRequirement(theorems);
-  const auto requested_docker_variant = parseStorageVariant(docker_variant_arg);
-
-  if (requested_docker_variant.has_value() && !docker_mode) {
-    throw std::runtime_error("--variant requires --docker");
-  }
-
-  if (engine.type() == sql::Engine::Type::Databricks
-      && requested_docker_variant == dbprove::StorageVariant::Iceberg) {
-    throw std::runtime_error(
-        "Databricks does not support the 'iceberg' storage variant. "
-        "Only 'native' (Delta) is supported.");
-  }
-
-  if (requested_docker_variant.has_value() && theorem_required_variant.has_value()
-      && *requested_docker_variant != *theorem_required_variant) {
-    throw std::runtime_error(
-        "Selected theorems require storage variant '"
-        + std::string(to_string(*theorem_required_variant))
-        + "', but '--variant " + std::string(to_string(*requested_docker_variant)) + "' was requested");
-  }
-
-  std::optional<dbprove::StorageVariant> effective_docker_variant = std::nullopt;
-  if (docker_mode) {
-    effective_docker_variant = requested_docker_variant;
-    if (!effective_docker_variant.has_value()) {
-      effective_docker_variant = theorem_required_variant.has_value()
-                               ? theorem_required_variant
-                               : engine.defaultStorageVariant();
-    }
-    if (!effective_docker_variant.has_value()) {
-      throw std::runtime_error(
-          "Docker mode is not supported for engine '" + engine.name()
-          + "' because there is no local docker service mapping for it");
-    }
-  }
-
-  const auto effective_storage_variant = docker_mode
-                                       ? *effective_docker_variant
-                                       : engine.defaultStorageVariant().value_or(dbprove::StorageVariant::Native);
-
-  auto generator_state = configureDataGeneration(
-      engine,
-      data_bucket_uri,
-      download_dir_override,
-      effective_storage_variant);
-
-  PLOGI << "Generating into directory: " << generator_state.basePath();
-
-  const bool artifact_mode = artefact_directory_override.has_value();
-  sql::setArtifactReplayMode(artifact_mode);
-
-  std::unique_ptr<common::DockerComposeSession> docker_session;
-  if (docker_mode && !artifact_mode) {
-    cleanupManagedDockerState();
-
-    if (requiresMountedTpchParquet(engine, *effective_docker_variant)) {
-      PLOGI << "Pre-staging TPCH CSV/parquet inputs under " << generator_state.basePath()
-            << " before starting docker-managed " << engine.name();
-      generator_state.ensureDatasetFiles("tpch_sf1");
-    }
-
-    if (*effective_docker_variant == dbprove::StorageVariant::Iceberg) {
-      PLOGI << "Starting local iceberg catalog sidecar";
-      startLocalIcebergCatalog();
-    }
-
-    const auto service_config = engine.dockerServiceConfig(*effective_docker_variant);
-    if (!service_config.has_value()) {
-      throw std::runtime_error(
-          "Storage variant '" + std::string(to_string(*effective_docker_variant))
-          + "' is not available for engine '" + engine.name() + "'");
-    }
-
-    PLOGI << "Docker mode enabled for engine '" << engine.name()
-          << "' using variant '" << to_string(*effective_docker_variant)
-          << "' and service '" << service_config->service_name << "'";
-    docker_session = std::make_unique<common::DockerComposeSession>();
-    docker_session->start(service_config->service_name);
-    engine.waitForDockerReady(credentials, service_config->readiness_timeout);
-  } else if (docker_mode && artifact_mode) {
-    PLOGI << "Artifact replay mode enabled: skipping docker service startup";
-  }
-
-  std::string engine_version = "unknown";
-  if (!artifact_mode) {
-    try {
-      sql::ConnectionFactory factory(engine, credentials, std::nullopt);
-      auto connection = factory.create();
-      engine_version = connection->version();
-      connection->close();
-    } catch (const std::exception& e) {
-      PLOGW << "Failed to retrieve engine version: " << e.what();
+  const auto theorems = theorem::parse(all_theorems);
+  const RunOptions options{
+      .host = host,
+      .port = port,
+      .database = database,
+      .username = username,
+      .password = password,
+      .token = token,
+      .data_bucket_uri = data_bucket_uri,
+      .download_dir_override = download_dir_override,
+      .artefact_directory_override = artefact_directory_override,
+      .docker_variant_arg = docker_variant_arg,
+      .parquet_dir = parquet_dir,
+      .config = config_str,
+      .docker_mode = docker_mode,
+      .query_timeout_seconds = query_timeout_seconds,
+      .timing_runs = timing_runs,
+      .jobs = jobs,
+      .single_execution_explain = single_execution_explain,
+      .prepared = prepared,
+      .pool_size = pool_size};
+
+  if (engines.size() == 1) {
+    return proveEngine(engines.front(), options, theorems, nullptr) ? 0 : 1;
+  }
+
+  PLOGI << "Proving " << theorems.size() << " theorems on " << engines.size() << " engines concurrently";
+  std::mutex console_mutex;
+  std::atomic<bool> all_succeeded{true};
+  {
+    std::vector<std::jthread> runs;
+    for (const auto& engine : engines) {
+      runs.emplace_back([&] {
+        try {
+          if (!proveEngine(engine, options, theorems, &console_mutex)) {
+            all_succeeded = false;
+          }
+        } catch (const std::exception& e) {
+          PLOGE << "Run against " << engine.name() << " failed: " << e.what();
+          all_succeeded = false;
+        }
+      });
     }
   }
-
-  const auto connection_artifacts_path = artifact_mode
-                                       ? artefact_directory_override
-                                       : std::optional<std::string>(defaultArtifactsDirectory(engine, engine_version).string());
-
-  std::optional<fs::path> proof_directory = std::nullopt;
-  if (!artifact_mode) {
-    proof_directory = proofVersionDirectory(engine, engine_version);
-    PLOGI << "Writing theorem proof JSON files to: "
-          << fs::absolute(*proof_directory).string();
-  } else {
-    PLOGI << "Artifact mode enabled: skipping engine version check and theorem proof JSON output";
-  }
-
-  if (connection_artifacts_path) {
-    PLOGI << (artifact_mode ? "Using replay artefacts directory: " : "Writing artefacts directory: ")
-          << fs::absolute(connection_artifacts_path.value()).string();
-  }
-
-  auto input_state = theorem::RunCtx{engine, credentials, generator_state,
-                                     std::cout, engine_version, connection_artifacts_path,
-                                     effective_storage_variant,
-                                     query_timeout_seconds > 0 ? std::optional<uint32_t>(query_timeout_seconds) : std::nullopt,
-                                     timing_runs,
-                                     parquet_dir,
-                                     proof_directory,
-                                     artifact_mode,
-                                     config_str};
-
-  return theorem::prove(theorems, input_state) ? 0 : 1;
+  return all_succeeded ? 0 : 1;
 }
@@ -1,6 +1,13 @@
 #include "generator_state.h"
 
+#include <array>
+#include <atomic>
+#include <format>
 #include <fstream>
+#include <future>
+#include <map>
+#include <mutex>
+#include <thread>
 #include <vector>
 #include <zip.h>
 
@@ -23,6 +30,9 @@ namespace generator {
 namespace {
 using json = nlohmann::json;
 
+constexpr size_t max_staging_workers = 8;
+constexpr size_t max_load_connections = 4;
+
 struct ParsedBucketLocation {
   CloudProvider provider;
   std::string bucket;
@@ -108,6 +118,12 @@ void removeIfEmpty(const std::filesystem::path& path) {
   }
 }
 
+std::filesystem::path partialPath(const std::filesystem::path& path) {
+  auto partial = path;
+  partial += ".part";
+  return partial;
+}
+
 void validateZipFile(const std::filesystem::path& zip_path) {
   int err = 0;
   zip_t* archive = zip_open(zip_path.string().c_str(), ZIP_RDONLY, &err);
@@ -145,11 +161,13 @@ void extractZipEntry(const std::filesystem::path& zip_path, std::string_view ent
     throw std::runtime_error("Failed to open '" + std::string(entry_name) + "' from zip: " + zip_path.string());
   }
 
-  std::ofstream out(output_path, std::ios::binary);
+  // Extract next to the target so an interrupted run never leaves a truncated file that looks complete
+  const auto partial_path = partialPath(output_path);
+  std::ofstream out(partial_path, std::ios::binary | std::ios::trunc);
   if (!out.is_open()) {
     zip_fclose(file);
     zip_close(archive);
-    throw std::runtime_error("Failed to create extracted file: " + output_path.string());
+    throw std::runtime_error("Failed to create extracted file: " + partial_path.string());
   }
 
   std::vector<char> buffer(1 << 16);
@@ -161,46 +179,310 @@ void extractZipEntry(const std::filesystem::path& zip_path, std::string_view ent
   out.close();
   zip_fclose(file);
   zip_close(archive);
+  if (bytes_read < 0 || !out.good()) {
+    std::filesystem::remove(partial_path);
+    throw std::runtime_error("Failed to extract '" + std::string(entry_name) + "' from zip: " + zip_path.string());
+  }
+  std::filesystem::rename(partial_path, output_path);
 }
 
-void downloadObject(CloudProvider provider, std::string_view bucket_uri, std::string_view object,
-                    const std::filesystem::path& destination_path) {
-  const auto location = parseBucketLocation(bucket_uri, provider);
-  const auto full_object = joinObjectPath(location.prefix, std::string(object));
+uint32_t crc32cUpdate(uint32_t crc, const char* data, const size_t size) {
+  static const auto table = [] {
+    std::array<uint32_t, 256> t{};
+    for (uint32_t i = 0; i < t.size(); ++i) {
+      uint32_t c = i;
+      for (int bit = 0; bit < 8; ++bit) {
+        c = (c & 1) ? (c >> 1) ^ 0x82F63B78u : c >> 1;
+      }
+      t[i] = c;
+    }
+    return t;
+  }();
+  crc = ~crc;
+  for (size_t i = 0; i < size; ++i) {
+    crc = table[(crc ^ static_cast<uint8_t>(data[i])) & 0xFF] ^ (crc >> 8);
+  }
+  return ~crc;
+}
 
-  std::filesystem::create_directories(destination_path.parent_path());
-  if (provider == CloudProvider::GCS) {
-    namespace gcs = ::google::cloud::storage;
-    auto client = gcs::Client::CreateDefaultClient().value();
-    std::ofstream out(destination_path, std::ios::binary);
+/**
+ * CRC32C of a file, base64 encoded big-endian the way GCS reports it in object metadata
+ */
+std::string crc32cBase64(const std::filesystem::path& path) {
+  std::ifstream in(path, std::ios::binary);
+  if (!in.is_open()) {
+    throw std::runtime_error("Failed to open file for checksum: " + path.string());
+  }
+  std::vector<char> buffer(1 << 20);
+  uint32_t crc = 0;
+  while (in) {
+    in.read(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+    crc = crc32cUpdate(crc, buffer.data(), static_cast<size_t>(in.gcount()));
+  }
+
+  constexpr std::string_view alphabet = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+  const uint64_t bits = static_cast<uint64_t>(crc) << 16;
+  std::string encoded;
+  for (int shift = 42; shift >= 12; shift -= 6) {
+    encoded.push_back(alphabet[(bits >> shift) & 0x3F]);
+  }
+  return encoded + "==";
+}
+
+/**
+ * Download a GCS object into `partial_path`, continuing from whatever a previous attempt left behind.
+ * The object generation is pinned so a resumed download never splices two versions of the object.
+ */
+void downloadGcsObject(const std::string& bucket, const std::string& object, const std::filesystem::path& partial_path) {
+  namespace gcs = ::google::cloud::storage;
+  auto client = gcs::Client::CreateDefaultClient().value();
+  const auto metadata = client.GetObjectMetadata(bucket, object);
+  if (!metadata) {
+    throw std::runtime_error("GCS GetObjectMetadata failed for " + object + ": " + metadata.status().message());
+  }
+
+  const auto object_size = metadata->size();
+  uint64_t offset = std::filesystem::exists(partial_path) ? std::filesystem::file_size(partial_path) : 0;
+  if (offset > object_size) {
+    std::filesystem::remove(partial_path);
+    offset = 0;
+  }
+  if (offset > 0) {
+    PLOGI << "Resuming download of " << object << " at byte " << offset << " of " << object_size;
+  }
+
+  if (offset < object_size) {
+    std::ofstream out(partial_path, std::ios::binary | std::ios::app);
     if (!out.is_open()) {
-      throw std::runtime_error("Failed to open local file for writing: " + destination_path.string());
+      throw std::runtime_error("Failed to open local file for writing: " + partial_path.string());
     }
-    auto reader = client.ReadObject(location.bucket, full_object);
+    auto reader = client.ReadObject(bucket, object, gcs::Generation(metadata->generation()),
+                                    gcs::ReadFromOffset(static_cast<std::int64_t>(offset)));
     if (!reader.status().ok()) {
-      out.close();
-      std::filesystem::remove(destination_path);
       throw std::runtime_error("GCS ReadObject failed: " + reader.status().message());
     }
     out << reader.rdbuf();
     if (reader.bad() || !out.good()) {
-      out.close();
-      std::filesystem::remove(destination_path);
+      // Keep what we have, the next attempt resumes from there
       throw std::runtime_error("GCS ReadObject or file write failed during download: " + reader.status().message());
     }
-    out.close();
-    return;
   }
 
-  if (provider == CloudProvider::AWS) {
-    dbprove::common::AWSBucket(std::string(bucket_uri)).downloadFile(full_object, destination_path);
+  const auto checksum = crc32cBase64(partial_path);
+  if (checksum != metadata->crc32c()) {
+    std::filesystem::remove(partial_path);
+    throw std::runtime_error(std::format("Checksum mismatch downloading {}: expected crc32c {}, got {}", object,
+                                         metadata->crc32c(), checksum));
+  }
+}
+
+void downloadObject(CloudProvider provider, std::string_view bucket_uri, std::string_view object,
+                    const std::filesystem::path& destination_path) {
+  const auto location = parseBucketLocation(bucket_uri, provider);
+  const auto full_object = joinObjectPath(location.prefix, std::string(object));
+
+  std::filesystem::create_directories(destination_path.parent_path());
+  const auto partial_path = partialPath(destination_path);
+  if (provider == CloudProvider::GCS) {
+    downloadGcsObject(location.bucket, full_object, partial_path);
+  } else if (provider == CloudProvider::AWS) {
+    // The aws cli verifies integrity itself but cannot resume, so start the partial file over
+    std::filesystem::remove(partial_path);
+    dbprove::common::AWSBucket(std::string(bucket_uri)).downloadFile(full_object, partial_path);
+  } else {
+    throw std::runtime_error("Local table cache miss for " + std::string(object) +
+                             ", but no supported object-store provider is configured");
+  }
+  std::filesystem::rename(partial_path, destination_path);
+}
+
+/**
+ * Everything needed to stage one source file of a table
+ */
+struct FileStage {
+  std::string zip_object_path;
+  std::string parquet_object_path;
+  std::string csv_file_name;
+  std::filesystem::path zip_cache_path;
+  std::filesystem::path csv_path;
+  std::filesystem::path parquet_path;
+};
+
+std::vector<FileStage> fileStages(const std::filesystem::path& base_path, const GeneratedTable& table) {
+  const auto schema_path = dbprove::common::schemaObjectPath(table.dataset);
+  const auto base_table_name = dbprove::common::splitQualifiedTableName(table.name).table_name;
+  const auto relative_object_prefix = (schema_path.empty() ? std::string() : schema_path + "/") + base_table_name + "/";
+  const auto csv_paths = expectedCsvPaths(base_path, table);
+  const auto parquet_paths = expectedParquetPaths(base_path, table);
+
+  std::vector<FileStage> stages;
+  stages.reserve(table.expected_file_count);
+  for (size_t i = 0; i < table.expected_file_count; ++i) {
+    const auto stem = dbprove::common::tableFileStem(table.name, i, table.expected_file_count);
+    stages.push_back({.zip_object_path = relative_object_prefix + stem + ".csv.zip",
+                      .parquet_object_path = relative_object_prefix + stem + ".parquet",
+                      .csv_file_name = stem + ".csv",
+                      .zip_cache_path = downloadCachePath(base_path, table.dataset, stem + ".csv.zip"),
+                      .csv_path = csv_paths[i],
+                      .parquet_path = parquet_paths[i]});
+  }
+  return stages;
+}
+
+void stageFile(const CloudProvider provider, const std::string_view bucket_uri, const FileStage& stage) {
+  removeIfEmpty(stage.csv_path);
+  removeIfEmpty(stage.parquet_path);
+  removeIfEmpty(stage.zip_cache_path);
+
+  if (!fileExistsAndNonEmpty(stage.csv_path)) {
+    if (std::filesystem::exists(stage.zip_cache_path)) {
+      validateZipFile(stage.zip_cache_path);
+    }
+    if (!std::filesystem::exists(stage.zip_cache_path)) {
+      PLOGI << "Downloading table CSV archive " << stage.zip_object_path << " to " << stage.zip_cache_path.string();
+      downloadObject(provider, bucket_uri, stage.zip_object_path, stage.zip_cache_path);
+    }
+    std::filesystem::create_directories(stage.csv_path.parent_path());
+    extractZipEntry(stage.zip_cache_path, stage.csv_file_name, stage.csv_path);
+    PLOGI << "CSV available at: " << stage.csv_path.string();
+  }
+
+  if (!fileExistsAndNonEmpty(stage.parquet_path)) {
+    PLOGI << "Downloading table parquet " << stage.parquet_object_path << " to " << stage.parquet_path.string();
+    downloadObject(provider, bucket_uri, stage.parquet_object_path, stage.parquet_path);
+  }
+}
+
+/**
+ * Stage a file at most once per process, however many GeneratorStates (one per engine in a multi-engine run) ask
+ * for it. Later callers wait for the first one to finish, a failed attempt is retried by the next caller.
+ */
+void stageFileOnce(const CloudProvider provider, const std::string_view bucket_uri, const FileStage& stage) {
+  static std::mutex mutex;
+  static std::map<std::filesystem::path, std::shared_future<void>> staged;
+
+  std::promise<void> staging;
+  std::shared_future<void> latch;
+  {
+    std::lock_guard lock(mutex);
+    if (const auto it = staged.find(stage.csv_path); it != staged.end()) {
+      latch = it->second;
+    } else {
+      staged.emplace(stage.csv_path, staging.get_future().share());
+    }
+  }
+  if (latch.valid()) {
+    latch.get();
     return;
   }
 
-  throw std::runtime_error("Local table cache miss for " + std::string(object) +
-                           ", but no supported object-store provider is configured");
+  try {
+    stageFile(provider, bucket_uri, stage);
+  } catch (...) {
+    {
+      std::lock_guard lock(mutex);
+      staged.erase(stage.csv_path);
+    }
+    staging.set_exception(std::current_exception());
+    throw;
+  }
+  staging.set_value();
+}
+
+/// Guards the writes to the process wide table registry that GeneratorStates of concurrent engines share
+std::mutex& registryMutex() {
+  static std::mutex mutex;
+  return mutex;
 }
 
+bool isGenerated(const GeneratedTable& table) {
+  std::lock_guard lock(registryMutex());
+  return table.is_generated;
+}
+
+/**
+ * Stages the files of several tables on a bounded pool of workers.
+ *
+ * Files are handed out in table order and each worker unzips its archive as soon as it has downloaded it, so
+ * extraction overlaps the remaining downloads. `wait` returns as soon as one table's files are all staged,
+ * letting the caller load it while later tables are still downloading.
+ */
+class StagingPipeline {
+  struct Job {
+    size_t table;
+    const FileStage* stage;
+  };
+
+  const CloudProvider provider_;
+  const std::string bucket_uri_;
+  const std::vector<std::vector<FileStage>> tables_;
+  std::vector<Job> jobs_;
+  std::atomic<size_t> next_job_{0};
+  std::atomic<bool> stopping_{false};
+  std::mutex mutex_;
+  std::vector<size_t> remaining_;
+  std::vector<bool> failed_;
+  std::vector<std::promise<void>> staged_;
+  std::vector<std::future<void>> staged_futures_;
+  std::vector<std::jthread> workers_;
+
+  void work() {
+    while (!stopping_) {
+      const auto job_index = next_job_.fetch_add(1);
+      if (job_index >= jobs_.size()) {
+        return;
+      }
+      const auto& [table, stage] = jobs_[job_index];
+      try {
+        stageFileOnce(provider_, bucket_uri_, *stage);
+      } catch (...) {
+        std::lock_guard lock(mutex_);
+        if (!failed_[table]) {
+          failed_[table] = true;
+          staged_[table].set_exception(std::current_exception());
+        }
+        continue;
+      }
+      std::lock_guard lock(mutex_);
+      if (--remaining_[table] == 0 && !failed_[table]) {
+        staged_[table].set_value();
+      }
+    }
+  }
+
+public:
+  StagingPipeline(const CloudProvider provider, std::string bucket_uri, std::vector<std::vector<FileStage>> tables)
+    : provider_(provider)
+    , bucket_uri_(std::move(bucket_uri))
+    , tables_(std::move(tables))
+    , failed_(tables_.size(), false)
+    , staged_(tables_.size()) {
+    for (size_t table = 0; table < tables_.size(); ++table) {
+      remaining_.push_back(tables_[table].size());
+      staged_futures_.push_back(staged_[table].get_future());
+      if (tables_[table].empty()) {
+        staged_[table].set_value();
+      }
+      for (const auto& stage : tables_[table]) {
+        jobs_.push_back({table, &stage});
+      }
+    }
+    const auto worker_count = std::min(jobs_.size(), max_staging_workers);
+    for (size_t i = 0; i < worker_count; ++i) {
+      workers_.emplace_back([this] { work(); });
+    }
+  }
+
+  ~StagingPipeline() {
+    stopping_ = true;
+  }
+
+  /// @brief Block until all files of the table at `table_index` are staged, rethrowing the first staging error
+  void wait(const size_t table_index) {
+    staged_futures_.at(table_index).get();
+  }
+};
+
 size_t writeHttpResponse(const char* ptr, const size_t size, const size_t nmemb, void* userdata) {
   auto* buffer = static_cast<std::string*>(userdata);
   buffer->append(ptr, size * nmemb);
@@ -271,59 +553,107 @@ void GeneratorState::ensure(const std::string_view table_name, sql::ConnectionFa
 }
 
 void GeneratorState::ensure(std::span<const std::string_view> table_names, sql::ConnectionFactory& conn) {
+  std::vector<std::string_view> pending;
   for (auto table_name : table_names) {
     sql::checkTableName(table_name);
-    if (ready_tables_.contains(table_name)) {
-      continue;
+    if (!ready_tables_.contains(table_name) && std::ranges::find(pending, table_name) == pending.end()) {
+      pending.push_back(table_name);
     }
+  }
+  if (pending.empty()) {
+    return;
+  }
+  // The largest tables bound the total load time, so start (and stage) them first
+  std::ranges::stable_sort(pending, std::greater{}, [this](const std::string_view t) { return expectedRows(t); });
 
-    std::unique_ptr<sql::ConnectionBase> cn = conn.create();
-    PLOGD << "Ensuring table: " << table_name;
-
-    if (!table(table_name).is_generated) {
-      const auto parquet_paths = expectedParquetPaths(basePath_, table(table_name));
-      const bool all_parquet_ready = !parquet_paths.empty()
-          && std::ranges::all_of(parquet_paths, fileExistsAndNonEmpty);
-      if (all_parquet_ready) {
-        // Pre-materialized parquet (e.g. scale tables from --prepare-ee-join-scale)
-        PLOGI << "Pre-materialized parquet found for " << table_name << "; skipping download";
-        table(table_name).parquet_paths = parquet_paths;
-        table(table_name).is_generated = true;
-      } else {
-        PLOGD << "Table: " << table_name << " is not marked as generated. Preparing input...";
-        generate(table_name);
+  std::vector<std::string_view> staged_tables;
+  for (const auto table_name : pending) {
+    if (!isGenerated(table(table_name)) && !usePrematerialized(table_name)) {
+      PLOGD << "Table: " << table_name << " is not marked as generated. Preparing input...";
+      staged_tables.push_back(table_name);
+    }
+  }
+  dbprove::common::make_directory(basePath_.string());
+  std::vector<std::vector<FileStage>> stages;
+  for (const auto table_name : staged_tables) {
+    stages.push_back(fileStages(basePath_, table(table_name)));
+  }
+  StagingPipeline staging(cloudProvider(), dataPath(), std::move(stages));
+
+  std::mutex mutex;
+  std::exception_ptr error;
+  std::atomic<size_t> next_table{0};
+
+  const auto loadTables = [&] {
+    try {
+      const auto cn = conn.create();
+      while (true) {
+        const auto table_index = next_table.fetch_add(1);
+        if (table_index >= pending.size()) {
+          return;
+        }
+        const auto table_name = pending[table_index];
+        PLOGD << "Ensuring table: " << table_name;
+
+        if (const auto staged = std::ranges::find(staged_tables, table_name); staged != staged_tables.end()) {
+          staging.wait(static_cast<size_t>(staged - staged_tables.begin()));
+          registerGeneration(table_name, expectedCsvPaths(basePath_, table(table_name)),
+                             expectedParquetPaths(basePath_, table(table_name)));
+        }
+
+        constructIfMissing(table_name, *cn);
+        std::lock_guard lock(mutex);
+        ready_tables_.insert(std::string(table_name));
       }
+    } catch (...) {
+      std::lock_guard lock(mutex);
+      if (!error) {
+        error = std::current_exception();
+      }
+      next_table = pending.size();
     }
-
-    auto existing_rows = cn->tableRowCount(table_name);
-    const auto expected_rows = table(table_name).row_count;
-
-    if (existing_rows && *existing_rows == expected_rows) {
-      PLOGI << "Table: " << table_name << " already exists with correct " << *existing_rows << " rows";
-      ready_tables_.insert(std::string(table_name));
-      continue;
+  };
+
+  const auto connection_count = std::min(pending.size(), engine_.supportsConcurrentSessions() ? max_load_connections : 1);
+  PLOGD << "Loading " << pending.size() << " tables on " << connection_count << " connections";
+  {
+    std::vector<std::jthread> workers;
+    for (size_t i = 1; i < connection_count; ++i) {
+      workers.emplace_back(loadTables);
     }
+    loadTables();
+  }
+  if (error) {
+    std::rethrow_exception(error);
+  }
+}
 
-    if (existing_rows && expected_rows == 0 && *existing_rows > 0) {
-      PLOGI << "Table: " << table_name << " already exists with " << *existing_rows
-            << " rows; accepting existing contents because no expected row count was registered yet.";
-      table(table_name).row_count = *existing_rows;
-      ready_tables_.insert(std::string(table_name));
-      continue;
-    }
+void GeneratorState::constructIfMissing(const std::string_view table_name, sql::ConnectionBase& conn) {
+  const auto existing_rows = conn.tableRowCount(table_name);
+  const auto expected_rows = expectedRows(table_name);
 
-    if (existing_rows) {
-      throw std::runtime_error(
-          std::format("Table: {} already exists with {} rows, but {} rows were expected. "
-                      "Generator contract does not permit constructTable to rebuild existing tables.",
-                      table_name, *existing_rows, expected_rows));
-    }
+  if (existing_rows && *existing_rows == expected_rows) {
+    PLOGI << "Table: " << table_name << " already exists with correct " << *existing_rows << " rows";
+    return;
+  }
 
-    PLOGI << "Constructing table: " << table_name << " (expected: " << expected_rows << ")";
-    load(table_name, *cn);
+  if (existing_rows && expected_rows == 0 && *existing_rows > 0) {
+    PLOGI << "Table: " << table_name << " already exists with " << *existing_rows
+          << " rows; accepting existing contents because no expected row count was registered yet.";
+    std::lock_guard lock(accepted_row_counts_mutex_);
+    accepted_row_counts_.insert_or_assign(std::string(table_name), *existing_rows);
+    return;
+  }
 
-    ready_tables_.insert(std::string(table_name));
+  if (existing_rows) {
+    throw std::runtime_error(
+        std::format("Table: {} already exists with {} rows, but {} rows were expected. "
+                    "Generator contract does not permit constructTable to rebuild existing tables.",
+                    table_name, *existing_rows, expected_rows));
   }
+
+  PLOGI << "Constructing table: " << table_name << " (expected: " << expected_rows << ")";
+  load(table_name, conn);
 }
 
 void GeneratorState::ensureDataset(const std::string_view dataset_name, sql::ConnectionFactory& conn) {
@@ -435,12 +765,34 @@ void GeneratorState::ensureDatasetFiles(const std::string_view dataset_name) {
   }
 
   const auto& tables = available_datasets().at(dataset_name);
+  dbprove::common::make_directory(basePath_.string());
+  std::vector<std::vector<FileStage>> stages;
   for (const auto table_name : tables) {
     sql::checkTableName(table_name);
-    generate(table_name);
+    stages.push_back(fileStages(basePath_, table(table_name)));
+  }
+  StagingPipeline staging(cloudProvider(), dataPath(), std::move(stages));
+  for (size_t i = 0; i < tables.size(); ++i) {
+    staging.wait(i);
+    registerGeneration(tables[i], expectedCsvPaths(basePath_, table(tables[i])),
+                       expectedParquetPaths(basePath_, table(tables[i])));
   }
 }
 
+bool GeneratorState::usePrematerialized(const std::string_view table_name) {
+  const auto parquet_paths = expectedParquetPaths(basePath_, table(table_name));
+  const bool all_parquet_ready = !parquet_paths.empty() && std::ranges::all_of(parquet_paths, fileExistsAndNonEmpty);
+  if (!all_parquet_ready) {
+    return false;
+  }
+  // Pre-materialized parquet (e.g. scale tables from --prepare-ee-join-scale)
+  PLOGI << "Pre-materialized parquet found for " << table_name << "; skipping download";
+  std::lock_guard lock(registryMutex());
+  table(table_name).parquet_paths = parquet_paths;
+  table(table_name).is_generated = true;
+  return true;
+}
+
 bool GeneratorState::contains(const std::string_view table_name) {
   sql::checkTableName(table_name);
   return available_tables().contains(table_name);
@@ -457,65 +809,18 @@ sql::RowCount GeneratorState::generate(const std::string_view table_name) {
   }
 
   auto& t = table(table_name);
-  const auto target_row_count = t.row_count;
-  const auto csv_paths = expectedCsvPaths(basePath_, t);
-  const auto parquet_paths = expectedParquetPaths(basePath_, t);
-  const auto schema_path = dbprove::common::schemaObjectPath(t.dataset);
-  const auto base_table_name = dbprove::common::splitQualifiedTableName(table_name).table_name;
-
   dbprove::common::make_directory(basePath_.string());
+  StagingPipeline staging(cloudProvider(), dataPath(), {fileStages(basePath_, t)});
+  staging.wait(0);
 
-  std::vector<std::filesystem::path> ready_csv_paths;
-  std::vector<std::filesystem::path> ready_parquet_paths;
-  ready_csv_paths.reserve(t.expected_file_count);
-  ready_parquet_paths.reserve(t.expected_file_count);
-
-  for (size_t i = 0; i < t.expected_file_count; ++i) {
-    const auto stem = dbprove::common::tableFileStem(table_name, i, t.expected_file_count);
-    const auto csv_file_name = stem + ".csv";
-    const auto zip_object_name = stem + ".csv.zip";
-    const auto parquet_object_name = stem + ".parquet";
-    const auto relative_object_prefix = (schema_path.empty() ? std::string() : schema_path + "/") + base_table_name + "/";
-    const auto zip_object_path = relative_object_prefix + zip_object_name;
-    const auto parquet_object_path = relative_object_prefix + parquet_object_name;
-    const auto zip_cache_path = downloadCachePath(basePath_, t.dataset, zip_object_name);
-    const auto& csv_path = csv_paths[i];
-    const auto& parquet_path = parquet_paths[i];
-
-    removeIfEmpty(csv_path);
-    removeIfEmpty(parquet_path);
-    removeIfEmpty(zip_cache_path);
-
-    if (!fileExistsAndNonEmpty(csv_path)) {
-      if (std::filesystem::exists(zip_cache_path)) {
-        validateZipFile(zip_cache_path);
-      }
-      if (!std::filesystem::exists(zip_cache_path)) {
-        PLOGI << "Downloading table CSV archive " << zip_object_path << " to " << zip_cache_path.string();
-        downloadObject(cloudProvider(), dataPath(), zip_object_path, zip_cache_path);
-      }
-      std::filesystem::create_directories(csv_path.parent_path());
-      extractZipEntry(zip_cache_path, csv_file_name, csv_path);
-      PLOGI << "CSV available at: " << csv_path.string();
-    }
-
-    if (!fileExistsAndNonEmpty(parquet_path)) {
-      PLOGI << "Downloading table parquet " << parquet_object_path << " to " << parquet_path.string();
-      downloadObject(cloudProvider(), dataPath(), parquet_object_path, parquet_path);
-    }
-
-    ready_csv_paths.push_back(csv_path);
-    ready_parquet_paths.push_back(parquet_path);
-  }
-
-  registerGeneration(table_name, std::move(ready_csv_paths), std::move(ready_parquet_paths));
-  return target_row_count;
+  registerGeneration(table_name, expectedCsvPaths(basePath_, t), expectedParquetPaths(basePath_, t));
+  return expectedRows(table_name);
 }
 
 sql::RowCount GeneratorState::load(const std::string_view table_name, sql::ConnectionBase& conn) {
   sql::checkTableName(table_name);
   auto& t = table(table_name);
-  const auto expected_rows = t.row_count;
+  const auto expected_rows = expectedRows(table_name);
   const auto source_stems = expectedSourceStems(basePath_, t);
 
   PLOGI << "Constructing table: " << table_name << "...";
@@ -562,6 +867,7 @@ void GeneratorState::registerGeneration(std::string_view table_name, std::vector
     }
   }
 
+  std::lock_guard lock(registryMutex());
   table(table_name).csv_paths = std::move(csv_paths);
   table(table_name).parquet_paths = std::move(parquet_paths);
   table(table_name).is_generated = true;
@@ -575,11 +881,21 @@ void GeneratorState::printSummary(std::ostream& out) const {
   dbprove::ux::Header(out, "Tables Loaded");
   std::vector<dbprove::ux::RowStats> stats;
   for (const auto& table_name : ready_tables_) {
-    stats.push_back({table_name, table(table_name).row_count});
+    stats.push_back({table_name, expectedRows(table_name)});
   }
   dbprove::ux::RowStatTable(out, stats);
 }
 
+sql::RowCount GeneratorState::expectedRows(const std::string_view table_name) const {
+  {
+    std::lock_guard lock(accepted_row_counts_mutex_);
+    if (const auto accepted = accepted_row_counts_.find(table_name); accepted != accepted_row_counts_.end()) {
+      return accepted->second;
+    }
+  }
+  return table(table_name).row_count;
+}
+
 GeneratedTable& GeneratorState::table(const std::string_view table_name) const {
   sql::checkTableName(table_name);
   if (!contains(table_name)) {
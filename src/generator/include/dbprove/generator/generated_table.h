@@ -27,7 +27,7 @@ public:
   const std::string name;
   const std::string dataset;
   const std::string_view ddl;
-  sql::RowCount row_count;
+  const sql::RowCount row_count;
   const size_t expected_file_count;
   const TableMetadata metadata;
   std::vector<std::filesystem::path> csv_paths; ///< Where the CSV input files are stored
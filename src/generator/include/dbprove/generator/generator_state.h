@@ -3,6 +3,8 @@
 #include <dbprove/common/cloud_provider.h>
 #include <dbprove/common/storage_variant.h>
 #include <filesystem>
+#include <map>
+#include <mutex>
 #include <ostream>
 #include <set>
 #include <span>
@@ -50,6 +52,10 @@ class GeneratorState {
 
 
   std::set<std::string, TransparentLess> ready_tables_ = {};
+  /// Row counts accepted from existing tables registered without one. Kept per engine, since another engine's copy of
+  /// the table may hold different rows
+  std::map<std::string, sql::RowCount, TransparentLess> accepted_row_counts_ = {};
+  mutable std::mutex accepted_row_counts_mutex_;
 
 public:
   explicit GeneratorState(const sql::Engine& engine, const std::filesystem::path& basePath,
@@ -64,6 +70,9 @@ public:
 
   /**
    * Makes sure an entire dataset is available on the given connection.
+   * Source files for all tables are staged concurrently, and each table is loaded as soon as its own files are
+   * ready. Engines that allow concurrent sessions load several tables at once, largest first, on separate
+   * connections.
    * @param dataset_name Dataset registered through REGISTER_TABLE
    * @param conn Connection factory used for ensure/load operations
    */
@@ -78,7 +87,7 @@ public:
 
   /**
    * Make sure the local CSV/parquet source files for a table exist and return
-   * the expected row count.
+   * the expected row count. Interrupted downloads resume where they left off and are checksum verified.
    */
   sql::RowCount generate(std::string_view table_name);
   /**
@@ -104,6 +113,8 @@ public:
   void printSummary(std::ostream& out) const;
 
   GeneratedTable& table(std::string_view table_name) const;
+  /// @brief Rows the table should hold on this engine, 0 if unknown
+  [[nodiscard]] sql::RowCount expectedRows(std::string_view table_name) const;
   static bool contains(std::string_view table_name);
   static bool containsDataset(std::string_view dataset_name);
   [[nodiscard]] const std::filesystem::path& basePath() const { return basePath_; }
@@ -114,6 +125,10 @@ public:
   static constexpr std::string_view rowSeparator() { return rowSeparator_; }
 
 private:
+  /// @brief Register pre-materialized parquet for a table if all of it is already staged
+  bool usePrematerialized(std::string_view table_name);
+  /// @brief Construct a table on `conn` unless it already holds the expected rows
+  void constructIfMissing(std::string_view table_name, sql::ConnectionBase& conn);
   void ensure(std::string_view table_name, sql::ConnectionFactory& conn);
   void ensure(std::span<const std::string_view> table_names, sql::ConnectionFactory& conn);
 };
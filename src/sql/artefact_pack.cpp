@@ -0,0 +1,278 @@
+#include "artefact_pack.h"
+
+#include <algorithm>
+#include <charconv>
+#include <format>
+#include <stdexcept>
+#include <plog/Log.h>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+namespace sql {
+uint64_t contentHash(const std::string_view content) {
+  // FNV-1a
+  uint64_t hash = 14695981039346656037ull;
+  for (const char c : content) {
+    hash ^= static_cast<unsigned char>(c);
+    hash *= 1099511628211ull;
+  }
+  return hash;
+}
+
+namespace {
+template <typename T>
+bool parseField(const std::string_view field, T& value, const int base = 10) {
+  const auto [end, ec] = std::from_chars(field.data(), field.data() + field.size(), value, base);
+  return ec == std::errc() && end == field.data() + field.size();
+}
+
+bool isPackFile(const std::filesystem::path& path) {
+  const auto file_name = path.filename().string();
+  return file_name == ArtefactPack::pack_file_name || file_name == ArtefactPack::index_file_name;
+}
+}
+
+/**
+ * Read only mapping of the first `size` bytes of a file
+ */
+class ArtefactPack::Mapping {
+  const char* data_ = nullptr;
+  uint64_t size_ = 0;
+#ifdef _WIN32
+  HANDLE file_ = INVALID_HANDLE_VALUE;
+  HANDLE mapping_ = nullptr;
+#endif
+
+public:
+  Mapping(const std::filesystem::path& path, const uint64_t size)
+    : size_(size) {
+#ifdef _WIN32
+    file_ = CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE, nullptr,
+                        OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file_ == INVALID_HANDLE_VALUE) {
+      throw std::runtime_error("Failed to open artefact pack: " + path.string());
+    }
+    mapping_ = CreateFileMappingW(file_, nullptr, PAGE_READONLY, static_cast<DWORD>(size >> 32),
+                                  static_cast<DWORD>(size & 0xFFFFFFFF), nullptr);
+    if (mapping_ != nullptr) {
+      data_ = static_cast<const char*>(MapViewOfFile(mapping_, FILE_MAP_READ, 0, 0, static_cast<SIZE_T>(size)));
+    }
+    if (data_ == nullptr) {
+      if (mapping_ != nullptr) {
+        CloseHandle(mapping_);
+      }
+      CloseHandle(file_);
+      throw std::runtime_error("Failed to map artefact pack: " + path.string());
+    }
+#else
+    const int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+      throw std::runtime_error("Failed to open artefact pack: " + path.string());
+    }
+    void* data = mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (data == MAP_FAILED) {
+      throw std::runtime_error("Failed to map artefact pack: " + path.string());
+    }
+    data_ = static_cast<const char*>(data);
+#endif
+  }
+
+  ~Mapping() {
+#ifdef _WIN32
+    UnmapViewOfFile(data_);
+    CloseHandle(mapping_);
+    CloseHandle(file_);
+#else
+    munmap(const_cast<char*>(data_), size_);
+#endif
+  }
+
+  Mapping(const Mapping&) = delete;
+  Mapping& operator=(const Mapping&) = delete;
+
+  [[nodiscard]] const char* data() const { return data_; }
+  [[nodiscard]] uint64_t size() const { return size_; }
+};
+
+ArtefactPack& ArtefactPack::open(const std::filesystem::path& directory) {
+  static std::mutex mutex;
+  static std::map<std::filesystem::path, std::unique_ptr<ArtefactPack>> packs;
+
+  const auto key = std::filesystem::absolute(directory).lexically_normal();
+  std::lock_guard lock(mutex);
+  auto& pack = packs[key];
+  if (!pack) {
+    pack = std::make_unique<ArtefactPack>(key);
+  }
+  return *pack;
+}
+
+ArtefactPack::ArtefactPack(std::filesystem::path directory)
+  : directory_(std::move(directory)) {
+  loadIndex();
+}
+
+ArtefactPack::~ArtefactPack() = default;
+
+void ArtefactPack::loadIndex() {
+  const auto pack_path = directory_ / pack_file_name;
+  const auto index_path = directory_ / index_file_name;
+  if (!std::filesystem::exists(pack_path)) {
+    return;
+  }
+  pack_size_ = std::filesystem::file_size(pack_path);
+
+  std::ifstream index(index_path, std::ios::binary);
+  std::string line;
+  while (std::getline(index, line)) {
+    // <hash>\t<offset>\t<size>\t<key>
+    const std::string_view fields(line);
+    const auto first = fields.find('\t');
+    const auto second = fields.find('\t', first + 1);
+    const auto third = fields.find('\t', second + 1);
+    Blob blob;
+    if (third == std::string_view::npos
+        || !parseField(fields.substr(0, first), blob.hash, 16)
+        || !parseField(fields.substr(first + 1, second - first - 1), blob.offset)
+        || !parseField(fields.substr(second + 1, third - second - 1), blob.size)
+        || blob.offset + blob.size > pack_size_) {
+      PLOGW << "Ignoring damaged artefact index entry in " << index_path.string() << ": " << line;
+      continue;
+    }
+    entries_.insert_or_assign(std::string(fields.substr(third + 1)), blob);
+    const auto [begin, end] = blobs_.equal_range(blob.hash);
+    if (std::none_of(begin, end, [&](const auto& b) { return b.second.offset == blob.offset; })) {
+      blobs_.emplace(blob.hash, blob);
+    }
+  }
+}
+
+std::string_view ArtefactPack::view(const Blob& blob) {
+  if (blob.size == 0) {
+    return {};
+  }
+  if (mappings_.empty() || blob.offset + blob.size > mappings_.back()->size()) {
+    mappings_.push_back(std::make_unique<Mapping>(directory_ / pack_file_name, pack_size_));
+  }
+  return {mappings_.back()->data() + blob.offset, blob.size};
+}
+
+std::optional<std::string_view> ArtefactPack::get(const std::string_view key) {
+  std::lock_guard lock(mutex_);
+  if (const auto it = entries_.find(key); it != entries_.end()) {
+    return view(it->second);
+  }
+  if (const auto it = loose_.find(key); it != loose_.end()) {
+    return it->second;
+  }
+
+  const auto loose_path = directory_ / std::string(key);
+  std::ifstream f(loose_path, std::ios::binary);
+  if (!f.is_open()) {
+    return std::nullopt;
+  }
+  PLOGD << "Reading loose artefact " << loose_path.string();
+  auto content = std::string((std::istreambuf_iterator<char>(f)), std::istreambuf_iterator<char>());
+  return loose_.emplace(std::string(key), std::move(content)).first->second;
+}
+
+void ArtefactPack::append(const std::string_view key, const Blob& blob, const std::string_view content,
+                          const bool write_content) {
+  if (!index_out_.is_open()) {
+    std::filesystem::create_directories(directory_);
+    pack_out_.open(directory_ / pack_file_name, std::ios::binary | std::ios::app);
+    index_out_.open(directory_ / index_file_name, std::ios::binary | std::ios::app);
+    if (!pack_out_.is_open() || !index_out_.is_open()) {
+      throw std::runtime_error("Failed to open artefact pack for writing in " + directory_.string());
+    }
+  }
+  if (write_content) {
+    pack_out_.write(content.data(), static_cast<std::streamsize>(content.size()));
+    pack_out_.flush();
+    if (!pack_out_.good()) {
+      throw std::runtime_error("Failed to write artefact pack in " + directory_.string());
+    }
+    pack_size_ += content.size();
+    blobs_.emplace(blob.hash, blob);
+  }
+  // The index is written after the content it points to, so a crash leaves at worst unreferenced bytes
+  index_out_ << std::format("{:016x}\t{}\t{}\t{}\n", blob.hash, blob.offset, blob.size, key);
+  index_out_.flush();
+  entries_.insert_or_assign(std::string(key), blob);
+}
+
+void ArtefactPack::put(const std::string_view key, const std::string_view content) {
+  std::lock_guard lock(mutex_);
+  // Only finds candidate duplicates. Content is always compared before it is shared
+  const auto hash = contentHash(content);
+  if (const auto it = entries_.find(key);
+      it != entries_.end() && it->second.hash == hash && view(it->second) == content) {
+    return;
+  }
+
+  const auto [begin, end] = blobs_.equal_range(hash);
+  for (auto it = begin; it != end; ++it) {
+    if (it->second.size == content.size() && view(it->second) == content) {
+      append(key, it->second, content, false);
+      return;
+    }
+  }
+  append(key, Blob{.hash = hash, .offset = pack_size_, .size = content.size()}, content, true);
+}
+
+ArtefactPack::CompactionStats ArtefactPack::compact(const std::filesystem::path& directory) {
+  CompactionStats stats;
+  const auto pack_path = directory / pack_file_name;
+  const auto index_path = directory / index_file_name;
+  const auto staging_directory = directory / ".compacting";
+  if (std::filesystem::exists(pack_path)) {
+    stats.bytes_before = std::filesystem::file_size(pack_path);
+  }
+  std::filesystem::remove_all(staging_directory);
+
+  {
+    ArtefactPack current(directory);
+    ArtefactPack compacted(staging_directory);
+    size_t index_lines = 0;
+    if (std::ifstream index(index_path, std::ios::binary); index.is_open()) {
+      std::string line;
+      while (std::getline(index, line)) {
+        ++index_lines;
+      }
+    }
+    for (const auto& [key, blob] : current.entries_) {
+      compacted.put(key, current.view(blob));
+    }
+    stats.stale_entries = index_lines - current.entries_.size();
+
+    for (const auto& entry : std::filesystem::directory_iterator(directory)) {
+      const auto key = entry.path().filename().string();
+      if (!entry.is_regular_file() || isPackFile(entry.path()) || current.entries_.contains(key)) {
+        continue;
+      }
+      if (const auto content = current.get(key)) {
+        compacted.put(key, *content);
+        ++stats.imported_files;
+      }
+    }
+    stats.entries = compacted.entries_.size();
+  }
+
+  if (stats.entries == 0) {
+    std::filesystem::remove_all(staging_directory);
+    return stats;
+  }
+  std::filesystem::rename(staging_directory / pack_file_name, pack_path);
+  std::filesystem::rename(staging_directory / index_file_name, index_path);
+  std::filesystem::remove_all(staging_directory);
+  stats.bytes_after = std::filesystem::file_size(pack_path);
+  return stats;
+}
+}
@@ -10,6 +10,8 @@
 #include "union.h"
 #include "explain/node.h"
 #include "explain/plan.h"
+#include <algorithm>
+#include <limits>
 #include <nlohmann/json.hpp>
 #include <plog/Log.h>
 
@@ -483,12 +485,16 @@ static std::unique_ptr<Plan> buildExplainPlan(const json& root_json) {
   }
 
   double execution_time = 0.0;
-  if (root_json.contains("analyzePlanPipelines")) {
+  if (root_json.contains("analyzePlanPipelines") && !root_json["analyzePlanPipelines"].empty()) {
+    // Multi-threaded pipelines overlap, so summing their durations overstates the time. Take the wall-clock span
+    // from the first start to the last stop instead. CedarDB reports microseconds, plans hold milliseconds
+    double first_start = std::numeric_limits<double>::max();
+    double last_stop = 0.0;
     for (const auto& pipeline : root_json["analyzePlanPipelines"]) {
-      execution_time += pipeline.value("duration", 0.0);
+      first_start = std::min(first_start, pipeline.value("start", 0.0));
+      last_stop = std::max(last_stop, pipeline.value("stop", 0.0));
     }
-    // CedarDB reports durations in microseconds; convert to milliseconds
-    execution_time /= 1000.0;
+    execution_time = std::max(0.0, last_stop - first_start) / 1000.0;
   }
 
   auto plan = std::make_unique<Plan>(std::move(top_node));
@@ -220,9 +220,9 @@ ScopedAstAliases guessScopedAliasesFromAst(const std::string_view ast_explain) {
 std::string fetchClickHouseExplainAst(Connection& connection,
                                       const std::string_view statement,
                                       const std::string_view artifact_name,
-                                      const std::optional<std::string>& cached_ast) {
+                                      const std::optional<std::string_view>& cached_ast) {
   if (cached_ast.has_value()) {
-    return *cached_ast;
+    return std::string(*cached_ast);
   }
 
   const std::string explain_ast_stmt = "EXPLAIN AST\n"
@@ -240,7 +240,7 @@ std::string fetchClickHouseExplainAst(Connection& connection,
 void fetchAstAndGuessSets(Connection& connection,
                          const std::string_view statement,
                          const std::string_view artifact_name,
-                         const std::optional<std::string>& cached_ast,
+                         const std::optional<std::string_view>& cached_ast,
                          std::map<std::string, std::string>& guessed_sets,
                          ScopedAstAliases* scoped_aliases,
                          const EngineDialect* dialect,
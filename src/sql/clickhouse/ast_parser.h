@@ -19,12 +19,12 @@ ScopedAstAliases guessScopedAliasesFromAst(const std::string_view ast_explain);
 std::string fetchClickHouseExplainAst(Connection& connection,
                                       std::string_view statement,
                                       std::string_view artifact_name,
-                                      const std::optional<std::string>& cached_ast);
+                                      const std::optional<std::string_view>& cached_ast);
 
 void fetchAstAndGuessSets(Connection& connection,
                          const std::string_view statement,
                          const std::string_view artifact_name,
-                         const std::optional<std::string>& cached_ast,
+                         const std::optional<std::string_view>& cached_ast,
                          std::map<std::string, std::string>& guessed_sets,
                          ScopedAstAliases* scoped_aliases,
                          const EngineDialect* dialect,
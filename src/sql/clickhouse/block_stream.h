@@ -0,0 +1,138 @@
+#pragma once
+
+#include <clickhouse/client.h>
+
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <stdexcept>
+#include <thread>
+
+namespace ch = clickhouse;
+
+namespace sql::clickhouse {
+/**
+ * Bounded queue of blocks between the thread running `Client::SelectCancelable` and the `Result` reading them.
+ *
+ * The producer blocks once `max_queued_blocks` are waiting, so a result is held in constant memory no matter
+ * how large it is. Cancelling makes the producer's callback return false, which stops the query on the server.
+ * Spilling lifts the bound instead, so the rest of the result is read into memory and the client is free again.
+ */
+class BlockStream {
+  std::mutex mutex_;
+  std::condition_variable changed_;
+  std::deque<std::shared_ptr<ch::Block>> blocks_;
+  std::optional<size_t> column_count_;
+  bool finished_ = false;
+  bool cancelled_ = false;
+  bool spilling_ = false;
+  std::exception_ptr error_;
+  std::jthread producer_;
+
+public:
+  static constexpr size_t max_queued_blocks = 8;
+
+  BlockStream() = default;
+  BlockStream(const BlockStream&) = delete;
+  BlockStream& operator=(const BlockStream&) = delete;
+
+  ~BlockStream() {
+    cancel();
+    join();
+  }
+
+  /// @brief Run `produce` on the producer thread. It must call `finish` when done
+  void start(std::function<void(BlockStream&)> produce) {
+    producer_ = std::jthread([this, produce = std::move(produce)] { produce(*this); });
+  }
+
+  /**
+   * @brief Producer side: queue a copy of the block, waiting while the queue is full
+   * @return false if the consumer cancelled and the query should stop
+   */
+  bool push(const ch::Block& block) {
+    std::unique_lock lock(mutex_);
+    if (!column_count_) {
+      // The first block is the header, it carries the columns even when the result is empty
+      column_count_ = block.GetColumnCount();
+      changed_.notify_all();
+    }
+    if (block.GetRowCount() == 0) {
+      return !cancelled_;
+    }
+    changed_.wait(lock, [this] { return blocks_.size() < max_queued_blocks || cancelled_ || spilling_; });
+    if (cancelled_) {
+      return false;
+    }
+    blocks_.push_back(std::make_shared<ch::Block>(block));
+    changed_.notify_all();
+    return true;
+  }
+
+  void finish(std::exception_ptr error = nullptr) {
+    std::lock_guard lock(mutex_);
+    finished_ = true;
+    error_ = std::move(error);
+    changed_.notify_all();
+  }
+
+  /// @brief Consumer side: wait for the header and return the column count, rethrowing a failed query
+  size_t columnCount() {
+    std::unique_lock lock(mutex_);
+    changed_.wait(lock, [this] { return column_count_.has_value() || finished_; });
+    if (!column_count_ && error_) {
+      std::rethrow_exception(error_);
+    }
+    return column_count_.value_or(0);
+  }
+
+  /**
+   * @brief Consumer side: next block with rows, nullptr at the end of the result
+   * @throw The query's error, or if the stream was cancelled before all blocks were read
+   */
+  std::shared_ptr<ch::Block> pop() {
+    std::unique_lock lock(mutex_);
+    changed_.wait(lock, [this] { return !blocks_.empty() || finished_; });
+    if (!blocks_.empty()) {
+      auto block = std::move(blocks_.front());
+      blocks_.pop_front();
+      changed_.notify_all();
+      return block;
+    }
+    if (cancelled_) {
+      throw std::runtime_error("ClickHouse result was cancelled before all its rows were read");
+    }
+    if (error_) {
+      std::rethrow_exception(error_);
+    }
+    return nullptr;
+  }
+
+  /// @brief Queue the rest of the result in memory and wait for the query to finish
+  void spill() {
+    {
+      std::lock_guard lock(mutex_);
+      spilling_ = true;
+      changed_.notify_all();
+    }
+    join();
+  }
+
+  void cancel() {
+    std::lock_guard lock(mutex_);
+    cancelled_ = true;
+    blocks_.clear();
+    changed_.notify_all();
+  }
+
+  void join() {
+    if (producer_.joinable() && producer_.get_id() != std::this_thread::get_id()) {
+      producer_.join();
+    }
+  }
+};
+}
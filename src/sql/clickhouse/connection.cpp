@@ -3,7 +3,6 @@
 #include "result_base.h"
 #include "sql_exceptions.h"
 #include "credential.h"
-#include "block_holder.h"
 #include "group_by.h"
 #include "join.h"
 #include "literals.h"
@@ -15,6 +14,7 @@
 #include "explain/plan.h"
 #include "include/dbprove/sql/parsed_table.h"
 
+#include <array>
 #include <string_view>
 #include <fstream>
 #include <regex>
@@ -25,6 +25,7 @@
 #include "limit.h"
 #include <dbprove/common/string.h>
 #include <clickhouse/client.h>
+#include "block_stream.h"
 #include <nlohmann/json.hpp>
 #include <plog/Log.h>
 
@@ -138,7 +139,27 @@ public:
     : credential(credential) {
   }
 
+  ~Pimpl() {
+    // The client goes away with the connection, a result still streaming from it throws when read further
+    if (const auto stream = active_stream.lock()) {
+      stream->cancel();
+      stream->join();
+    }
+  }
+
+  /**
+   * The client serves one query at a time, so a result still streaming reads its remaining blocks into memory
+   * before anything else uses the client
+   */
+  void spillStream() {
+    if (const auto stream = active_stream.lock()) {
+      stream->spill();
+    }
+    active_stream.reset();
+  }
+
   ch::Client& getClient() {
+    spillStream();
     if (!client) {
       ch::ClientOptions options;
       options.SetHost(credential.host).SetPort(credential.port).SetUser(credential.username).
@@ -150,6 +171,8 @@ public:
   }
 
   std::unique_ptr<ch::Client> client;
+  std::weak_ptr<BlockStream> active_stream;
+  std::array<std::unique_ptr<Connection>, 2> explain_sessions;
 };
 
 
@@ -190,58 +213,42 @@ void Connection::execute(std::string_view statement) {
 }
 
 std::unique_ptr<ResultBase> Connection::fetchAll(const std::string_view statement) {
-  /* Clickhouse contains the Block object and expects you to process it immediately
-    in the lambda.
-    After that, the block goes out of scope and is deconstructed,
-    But we want to hang on to it and pass to Result: We do this dance
-    of taking a shared pointer (which will create a deep copy) before passing it on
-    to the constructor of Result.
-
-    ...Ugly!
-  */
-
+  /* Clickhouse hands each Block to a callback and expects it to be processed there. The callback runs on a
+   * producer thread and feeds a bounded queue, so the Result streams blocks as the server sends them
+   */
   auto& client = impl_->getClient();
-  const auto sql = trim_trailing_semicolons(statement);
-  std::vector<std::shared_ptr<ch::Block>> blocks;
-  const bool actuals_query = isActualsQuery(statement);
-  const auto timeout_seconds = actuals_query ? actualsTimeoutSeconds() : 0;
-  try {
-    if (actuals_query) {
-      client.Execute("SET max_execution_time = " + std::to_string(timeout_seconds));
-      client.Execute("SET timeout_overflow_mode = 'throw'");
-    }
-    client.Select(sql, [&](const ch::Block& b) {
-      if (b.GetRowCount() == 0) {
-        return;
-      }
-      blocks.push_back(std::make_shared<ch::Block>(b));
-    });
-    if (actuals_query) {
-      client.Execute("SET max_execution_time = 0");
-      client.Execute("SET timeout_overflow_mode = 'break'");
-    }
-  } catch (const ch::ServerException& e) {
-    if (actuals_query) {
-      try {
-        client.Execute("SET max_execution_time = 0");
-        client.Execute("SET timeout_overflow_mode = 'break'");
-      } catch (const ch::Exception&) {
-        // ignore cleanup failure
-      }
-    }
-    handleClickHouseException(client, e);
-  } catch (std::exception& e) {
-    if (actuals_query) {
+  auto sql = trim_trailing_semicolons(statement);
+  if (isActualsQuery(statement)) {
+    // Limits ride along with the query instead of costing SET round-trips before and after it
+    sql += "\nSETTINGS max_execution_time = " + std::to_string(actualsTimeoutSeconds())
+        + ", timeout_overflow_mode = 'throw'";
+  }
+
+  auto stream = std::make_shared<BlockStream>();
+  stream->start([&client, sql = std::move(sql)](BlockStream& s) {
+    try {
+      client.SelectCancelable(sql, [&s](const ch::Block& b) { return s.push(b); });
+      s.finish();
+    } catch (const ch::ServerException& e) {
       try {
-        client.Execute("SET max_execution_time = 0");
-        client.Execute("SET timeout_overflow_mode = 'break'");
-      } catch (const ch::Exception&) {
-        // ignore cleanup failure
+        handleClickHouseException(client, e);
+      } catch (...) {
+        s.finish(std::current_exception());
       }
+    } catch (std::exception& e) {
+      s.finish(std::make_exception_ptr(std::runtime_error(e.what())));
     }
-    throw std::runtime_error(e.what());
+  });
+  impl_->active_stream = stream;
+  return std::make_unique<Result>(std::move(stream));
+}
+
+Connection& Connection::explainSession(const size_t index) {
+  auto& session = impl_->explain_sessions.at(index);
+  if (!session) {
+    session = std::make_unique<Connection>(impl_->credential, engine(), artifactsPath());
   }
-  return std::make_unique<Result>(std::make_unique<BlockHolder>(blocks));
+  return *session;
 }
 
 
@@ -10,6 +10,8 @@ class Connection final : public ConnectionBase {
   class Pimpl;
   std::unique_ptr<Pimpl> impl_;
   std::vector<std::string> tableColumns(std::string_view table);
+  /// @brief Extra session to the same server, opened on first use, so EXPLAIN variants can run side by side
+  Connection& explainSession(size_t index);
 
 public:
   explicit Connection(const CredentialPassword& credential, const Engine& engine, std::optional<std::string> artifacts_path = std::nullopt);
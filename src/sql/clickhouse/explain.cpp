@@ -4,6 +4,7 @@
 #include <array>
 #include <cstdlib>
 #include <functional>
+#include <future>
 #include <limits>
 #include <optional>
 #include <ranges>
@@ -1763,10 +1764,10 @@ std::unique_ptr<Plan> buildExplainPlan(json& json, ExplainCtx& ctx) {
 std::string fetchClickHouseExplainJson(Connection& connection,
                                        const std::string_view statement,
                                        const std::string_view artifact_name,
-                                       const std::optional<std::string>& cached_json) {
+                                       const std::optional<std::string_view>& cached_json) {
   if (cached_json.has_value()) {
     PLOGI << "Using cached execution plan artifact for: " << artifact_name;
-    return *cached_json;
+    return std::string(*cached_json);
   }
 
   const std::string explain_sql = trim_trailing_semicolons(statement);
@@ -2091,9 +2092,16 @@ std::string getOrFetchClickHouseExplainQueryTree(Connection& connection,
 
 std::unique_ptr<Plan> Connection::explain(const std::string_view statement, std::optional<std::string_view> name) {
   const std::string artifact_name = name.has_value() ? std::string(*name) : std::to_string(std::hash<std::string_view>{}(statement));
+  // The three EXPLAIN variants are independent, so they run at the same time on separate sessions
+  auto ast_future = std::async(std::launch::async, [&] {
+    return getOrFetchClickHouseExplainAst(explainSession(0), statement, artifact_name);
+  });
+  auto query_tree_future = std::async(std::launch::async, [&] {
+    return getOrFetchClickHouseExplainQueryTree(explainSession(1), statement, artifact_name);
+  });
   const auto string_explain = getOrFetchClickHouseExplainJson(*this, statement, artifact_name);
-  const auto ast_explain = getOrFetchClickHouseExplainAst(*this, statement, artifact_name);
-  const auto query_tree = getOrFetchClickHouseExplainQueryTree(*this, statement, artifact_name);
+  const auto ast_explain = ast_future.get();
+  const auto query_tree = query_tree_future.get();
 
   ExplainCtx ctx;
   const auto guessed_sets = guessSetsFromAst(ast_explain, &ctx.dialect);
@@ -2127,7 +2135,8 @@ std::unique_ptr<Plan> Connection::explain(const std::string_view statement, std:
   const bool skip_actuals = skip_actuals_env != nullptr &&
                             std::string_view(skip_actuals_env) == "1";
   if (!skip_actuals) {
-    plan->fixActuals(*this);
+    constexpr size_t actuals_connections = 8;
+    plan->fixActuals(*this, actuals_connections);
   }
   return plan;
 }
@@ -13,9 +13,9 @@ namespace sql::clickhouse {
 std::string fetchClickHouseExplainQueryTree(Connection& connection,
                                             const std::string_view statement,
                                             const std::string_view artifact_name,
-                                            const std::optional<std::string>& cached_query_tree) {
+                                            const std::optional<std::string_view>& cached_query_tree) {
   if (cached_query_tree.has_value()) {
-    return *cached_query_tree;
+    return std::string(*cached_query_tree);
   }
 
   const std::string explain_query_tree_stmt = "EXPLAIN QUERY TREE\n"
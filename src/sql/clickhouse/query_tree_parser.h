@@ -25,7 +25,7 @@ struct CorrelatedExistsRelationGuess {
 std::string fetchClickHouseExplainQueryTree(Connection& connection,
                                             std::string_view statement,
                                             std::string_view artifact_name,
-                                            const std::optional<std::string>& cached_query_tree);
+                                            const std::optional<std::string_view>& cached_query_tree);
 
 size_t countUncorrelatedScalarSubqueriesInQueryTree(std::string_view query_tree);
 
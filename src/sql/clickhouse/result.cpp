@@ -1,7 +1,7 @@
 #include "result.h"
 #include "row.h"
 #include "sql_exceptions.h"
-#include "block_holder.h"
+#include "block_stream.h"
 #include <clickhouse/client.h>
 #include <utility>
 
@@ -10,41 +10,43 @@ namespace ch = clickhouse;
 namespace sql::clickhouse {
 class Result::Pimpl {
 public:
-  std::unique_ptr<BlockHolder> h;
+  std::shared_ptr<BlockStream> stream;
   std::unique_ptr<Row> row;
   ColumnCount columnCount;
-  RowCount rowCount = 0;
-  size_t currentBlockOffset = 0;
+  RowCount rowsRead = 0;
+  std::shared_ptr<ch::Block> block;
+  size_t nextRowOffset = 0;
   size_t currentRowOffset = 0;
 
-  ch::Block& currentBlock() const {
-    return *h->blocks[currentBlockOffset].get();
+  explicit Pimpl(std::shared_ptr<BlockStream> s, Result* parent)
+    : stream(std::move(s))
+    , row(std::make_unique<Row>(parent))
+    , columnCount(stream->columnCount()) {
   }
 
-  // Add other members as needed
-  explicit Pimpl(std::unique_ptr<BlockHolder> b, Result* parent)
-    : h(std::move(std::move(b)))
-    , columnCount(h->blocks.front()->GetColumnCount())
-    , row(std::make_unique<Row>(parent)
-        ) {
-    for (const auto block : h->blocks) {
-      rowCount += block->GetRowCount();
-    }
-    // THe very first row is a meta row
-    while (currentBlock().GetRowCount() == 0) {
-      currentBlockOffset++;
+  /// @brief Make sure `block` has unread rows, fetching the next block if needed. False at the end of the result
+  bool ensureRows() {
+    while (!block || nextRowOffset >= block->GetRowCount()) {
+      block = stream->pop();
+      nextRowOffset = 0;
+      if (!block) {
+        return false;
+      }
     }
+    return true;
   }
 
-  ~Pimpl() = default;
+  ch::Block& currentBlock() const {
+    return *block;
+  }
 };
 
-Result::Result(std::unique_ptr<BlockHolder> holder)
-  : impl_(std::make_unique<Pimpl>(std::move(holder), this)) {
+Result::Result(std::shared_ptr<BlockStream> stream)
+  : impl_(std::make_unique<Pimpl>(std::move(stream), this)) {
 }
 
 RowCount Result::rowCount() const {
-  return impl_->rowCount;
+  return impl_->rowsRead;
 }
 
 ColumnCount Result::columnCount() const {
@@ -54,16 +56,11 @@ ColumnCount Result::columnCount() const {
 Result::~Result() = default;
 
 const RowBase& Result::nextRow() {
-  if (currentRowIndex_ >= rowCount()) {
+  if (!impl_->ensureRows()) {
     return SentinelRow::instance();
   }
-  currentRowIndex_++;
-  if (impl_->currentRowOffset >= impl_->currentBlock().GetRowCount()) {
-    impl_->currentBlockOffset++;
-    impl_->currentRowOffset = 0;
-  } else {
-    impl_->currentRowOffset++;
-  }
+  impl_->currentRowOffset = impl_->nextRowOffset++;
+  impl_->rowsRead++;
   return *impl_->row;
 }
 
@@ -104,7 +101,7 @@ std::string DecimalToString(const ch::ColumnDecimal& col, size_t index) {
 
 SqlVariant Result::getRowValue(size_t index) const {
   const auto& b = impl_->currentBlock();
-  const auto offset = impl_->currentRowOffset - 1;
+  const auto offset = impl_->currentRowOffset;
   auto& column = *b[index];
   switch (column.GetType().GetCode()) {
     case ::clickhouse::Type::Int8:
@@ -139,4 +136,98 @@ SqlVariant Result::getRowValue(size_t index) const {
       throw InvalidTypeException("Unsupported ClickHouse Type: " + column.GetType().GetName());
   }
 }
-} // namespace sql::clickhouse
\ No newline at end of file
+namespace {
+template <typename ColumnT, typename Append>
+void copyValues(const ch::ColumnRef& values, const ch::ColumnNullable* nullable, const size_t begin,
+                const size_t end, ColumnVector& out, Append append) {
+  const auto typed = values->As<ColumnT>();
+  for (size_t i = begin; i < end; ++i) {
+    if (nullable && nullable->IsNull(i)) {
+      out.appendNull();
+      continue;
+    }
+    append(*typed, i);
+  }
+}
+
+void copyColumn(const ch::ColumnRef& column, const size_t begin, const size_t end, ColumnVector& out) {
+  auto values = column;
+  std::shared_ptr<ch::ColumnNullable> nullable;
+  if (column->GetType().GetCode() == ch::Type::Nullable) {
+    nullable = column->As<ch::ColumnNullable>();
+    values = nullable->Nested();
+  }
+  const auto append_int = [&out](const auto& c, const size_t i) { out.appendInt(static_cast<int64_t>(c.At(i))); };
+  const auto append_double = [&out](const auto& c, const size_t i) { out.appendDouble(static_cast<double>(c.At(i))); };
+  const auto append_string = [&out](const auto& c, const size_t i) { out.appendString(c.At(i)); };
+  const auto* n = nullable.get();
+  switch (values->GetType().GetCode()) {
+    case ch::Type::Int8:
+      out.setKind(SqlTypeKind::SMALLINT);
+      return copyValues<ch::ColumnInt8>(values, n, begin, end, out, append_int);
+    case ch::Type::UInt8:
+      out.setKind(SqlTypeKind::SMALLINT);
+      return copyValues<ch::ColumnUInt8>(values, n, begin, end, out, append_int);
+    case ch::Type::Int16:
+      out.setKind(SqlTypeKind::SMALLINT);
+      return copyValues<ch::ColumnInt16>(values, n, begin, end, out, append_int);
+    case ch::Type::UInt16:
+      out.setKind(SqlTypeKind::INT);
+      return copyValues<ch::ColumnUInt16>(values, n, begin, end, out, append_int);
+    case ch::Type::Int32:
+      out.setKind(SqlTypeKind::INT);
+      return copyValues<ch::ColumnInt32>(values, n, begin, end, out, append_int);
+    case ch::Type::UInt32:
+      out.setKind(SqlTypeKind::BIGINT);
+      return copyValues<ch::ColumnUInt32>(values, n, begin, end, out, append_int);
+    case ch::Type::Int64:
+      out.setKind(SqlTypeKind::BIGINT);
+      return copyValues<ch::ColumnInt64>(values, n, begin, end, out, append_int);
+    case ch::Type::UInt64:
+      // Clickhouse returns COUNT(*) as this type
+      out.setKind(SqlTypeKind::BIGINT);
+      return copyValues<ch::ColumnUInt64>(values, n, begin, end, out, append_int);
+    case ch::Type::Float32:
+      out.setKind(SqlTypeKind::REAL);
+      return copyValues<ch::ColumnFloat32>(values, n, begin, end, out, append_double);
+    case ch::Type::Float64:
+      out.setKind(SqlTypeKind::DOUBLE);
+      return copyValues<ch::ColumnFloat64>(values, n, begin, end, out, append_double);
+    case ch::Type::String:
+      out.setKind(SqlTypeKind::STRING);
+      return copyValues<ch::ColumnString>(values, n, begin, end, out, append_string);
+    case ch::Type::FixedString:
+      out.setKind(SqlTypeKind::STRING);
+      return copyValues<ch::ColumnFixedString>(values, n, begin, end, out, append_string);
+    case ch::Type::Decimal:
+    case ch::Type::Decimal32:
+    case ch::Type::Decimal64:
+    case ch::Type::Decimal128:
+      out.setKind(SqlTypeKind::DECIMAL);
+      return copyValues<ch::ColumnDecimal>(values, n, begin, end, out, [&out](const ch::ColumnDecimal& c, const size_t i) {
+        out.appendString(DecimalToString(c, i));
+      });
+    default:
+      throw InvalidTypeException("Unsupported ClickHouse Type: " + values->GetType().GetName());
+  }
+}
+}
+
+bool Result::nextBatch(ColumnBatch& batch, const size_t max_rows) {
+  batch.reset(columnCount());
+  if (!impl_->ensureRows()) {
+    return false;
+  }
+  const auto& block = impl_->currentBlock();
+  const size_t begin = impl_->nextRowOffset;
+  const size_t end = std::min<size_t>(block.GetRowCount(), begin + max_rows);
+  for (size_t i = 0; i < batch.columnCount(); ++i) {
+    auto& column = batch.column(i);
+    column.reserve(end - begin);
+    copyColumn(block[i], begin, end, column);
+  }
+  impl_->nextRowOffset = end;
+  impl_->rowsRead += end - begin;
+  return true;
+}
+} // namespace sql::clickhouse
@@ -5,18 +5,23 @@
 
 namespace sql::clickhouse {
 class Connection;
-class BlockHolder;
+class BlockStream;
 
+/**
+ * Result streamed from a bounded block queue that the query's producer thread fills.
+ * Rows can only be read once, and `rowCount` is the number of rows read so far.
+ */
 class Result : public ResultBase {
   class Pimpl;
   std::unique_ptr<Pimpl> impl_;
-  RowCount currentRowIndex_ = 0;
   SqlVariant getRowValue(size_t index) const;
 
 public:
-  explicit Result(std::unique_ptr<BlockHolder> holder);
+  /// @throw The query's error if it failed before producing its header
+  explicit Result(std::shared_ptr<BlockStream> stream);
   RowCount rowCount() const override;
   ColumnCount columnCount() const override;
+  bool nextBatch(ColumnBatch& batch, size_t max_rows = DEFAULT_BATCH_ROWS) override;
   ~Result() override;
 
 protected:
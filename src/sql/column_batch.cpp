@@ -0,0 +1,192 @@
+#include "column_batch.h"
+
+#include "sql_exceptions.h"
+
+namespace sql {
+ColumnVector::Storage ColumnVector::storageFor(const SqlTypeKind kind) {
+  switch (kind) {
+    case SqlTypeKind::SMALLINT:
+    case SqlTypeKind::INT:
+    case SqlTypeKind::BIGINT:
+      return Storage::INT64;
+    case SqlTypeKind::REAL:
+    case SqlTypeKind::DOUBLE:
+      return Storage::DOUBLE;
+    case SqlTypeKind::SQL_NULL:
+      return Storage::NONE;
+    default:
+      return Storage::STRING;
+  }
+}
+
+void ColumnVector::clear() {
+  kind_ = SqlTypeKind::SQL_NULL;
+  storage_ = Storage::NONE;
+  size_ = 0;
+  ints_.clear();
+  doubles_.clear();
+  offsets_.resize(1);
+  data_.clear();
+  nulls_.clear();
+}
+
+void ColumnVector::reserve(const size_t rows) {
+  switch (storage_) {
+    case Storage::INT64:
+      ints_.reserve(rows);
+      break;
+    case Storage::DOUBLE:
+      doubles_.reserve(rows);
+      break;
+    case Storage::STRING:
+      offsets_.reserve(rows + 1);
+      break;
+    case Storage::NONE:
+      break;
+  }
+  nulls_.reserve((rows + 63) / 64);
+}
+
+void ColumnVector::setKind(const SqlTypeKind kind) {
+  const auto storage = storageFor(kind);
+  if (storage_ != Storage::NONE && storage_ != storage) {
+    throw InvalidColumnsException("Cannot change column from " + std::string(to_string(kind_)) + " to " +
+                               std::string(to_string(kind)));
+  }
+  if (storage_ == Storage::NONE) {
+    // Rows appended so far are all NULL and need a value slot in the new storage
+    switch (storage) {
+      case Storage::INT64:
+        ints_.assign(size_, 0);
+        break;
+      case Storage::DOUBLE:
+        doubles_.assign(size_, 0.0);
+        break;
+      case Storage::STRING:
+        offsets_.assign(size_ + 1, 0);
+        break;
+      case Storage::NONE:
+        break;
+    }
+  }
+  kind_ = kind;
+  storage_ = storage;
+}
+
+void ColumnVector::growNulls() {
+  if (size_ % 64 == 0) {
+    nulls_.push_back(0);
+  }
+  ++size_;
+}
+
+void ColumnVector::appendInt(const int64_t value) {
+  if (storage_ == Storage::NONE) {
+    setKind(SqlTypeKind::BIGINT);
+  }
+  if (storage_ == Storage::DOUBLE) {
+    appendDouble(static_cast<double>(value));
+    return;
+  }
+  if (storage_ != Storage::INT64) {
+    throw InvalidColumnsException("Cannot append an integer to a " + std::string(to_string(kind_)) + " column");
+  }
+  ints_.push_back(value);
+  growNulls();
+}
+
+void ColumnVector::appendDouble(const double value) {
+  if (storage_ == Storage::NONE) {
+    setKind(SqlTypeKind::DOUBLE);
+  }
+  if (storage_ != Storage::DOUBLE) {
+    throw InvalidColumnsException("Cannot append a double to a " + std::string(to_string(kind_)) + " column");
+  }
+  doubles_.push_back(value);
+  growNulls();
+}
+
+void ColumnVector::appendString(const std::string_view value) {
+  if (storage_ == Storage::NONE) {
+    setKind(SqlTypeKind::STRING);
+  }
+  if (storage_ != Storage::STRING) {
+    throw InvalidColumnsException("Cannot append a string to a " + std::string(to_string(kind_)) + " column");
+  }
+  data_.append(value);
+  offsets_.push_back(data_.size());
+  growNulls();
+}
+
+void ColumnVector::appendNull() {
+  switch (storage_) {
+    case Storage::INT64:
+      ints_.push_back(0);
+      break;
+    case Storage::DOUBLE:
+      doubles_.push_back(0.0);
+      break;
+    case Storage::STRING:
+      offsets_.push_back(data_.size());
+      break;
+    case Storage::NONE:
+      break;
+  }
+  const auto row = size_;
+  growNulls();
+  nulls_[row / 64] |= uint64_t{1} << (row % 64);
+}
+
+void ColumnVector::append(const SqlVariant& value) {
+  if (value.is<SqlNull>()) {
+    appendNull();
+    return;
+  }
+  if (storage_ == Storage::NONE) {
+    setKind(value.kind());
+  }
+  switch (storage_) {
+    case Storage::INT64:
+      appendInt(value.asInt8());
+      return;
+    case Storage::DOUBLE:
+      if (value.is<SqlDouble>() || value.is<SqlFloat>()) {
+        appendDouble(value.asDouble());
+      } else {
+        appendDouble(static_cast<double>(value.asInt8()));
+      }
+      return;
+    default:
+      appendString(value.asString());
+  }
+}
+
+SqlVariant ColumnVector::asVariant(const size_t row) const {
+  if (isNull(row)) {
+    return SqlVariant();
+  }
+  switch (kind_) {
+    case SqlTypeKind::SMALLINT:
+      return SqlVariant(static_cast<int16_t>(ints_[row]));
+    case SqlTypeKind::INT:
+      return SqlVariant(static_cast<int32_t>(ints_[row]));
+    case SqlTypeKind::BIGINT:
+      return SqlVariant(ints_[row]);
+    case SqlTypeKind::REAL:
+      return SqlVariant(SqlFloat(static_cast<float>(doubles_[row])));
+    case SqlTypeKind::DOUBLE:
+      return SqlVariant(doubles_[row]);
+    case SqlTypeKind::DECIMAL:
+      return SqlVariant(SqlDecimal(string(row)));
+    default:
+      return SqlVariant(string(row));
+  }
+}
+
+void ColumnBatch::reset(const ColumnCount column_count) {
+  columns_.resize(column_count);
+  for (auto& column : columns_) {
+    column.clear();
+  }
+}
+}
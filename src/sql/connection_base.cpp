@@ -8,7 +8,9 @@
 #include <cctype>
 #include <algorithm>
 #include <sstream>
+#include <cmath>
 
+#include "artefact_pack.h"
 #include "sql_exceptions.h"
 #include "explain/plan.h"
 #include "embedded_sql.h"
@@ -34,12 +36,12 @@ std::string toLowerAscii(std::string value) {
   return value;
 }
 
-std::filesystem::path artefactPathWithDot(const std::filesystem::path& dir, std::string_view name, std::string_view extension) {
+std::string artefactKey(std::string_view name, std::string_view extension) {
   const auto ext = normaliseExtension(extension);
   if (ext.empty()) {
-    return dir / std::string(name);
+    return std::string(name);
   }
-  return dir / (std::string(name) + "." + ext);
+  return std::string(name) + "." + ext;
 }
 
 std::string prettyJsonIfNeeded(std::string_view extension, std::string_view content) {
@@ -158,6 +160,47 @@ std::unique_ptr<RowBase> ConnectionBase::fetchRow(const std::string_view stateme
   return first_row;
 }
 
+namespace {
+/**
+ * Stand-in for engines without a prepare API
+ */
+class TextStatement final : public PreparedStatement {
+  ConnectionBase& connection_;
+  const std::string statement_;
+
+public:
+  TextStatement(ConnectionBase& connection, const std::string_view statement)
+    : connection_(connection)
+    , statement_(statement) {
+  }
+
+  std::unique_ptr<ResultBase> fetchAll() override { return connection_.fetchAll(statement_); }
+  ExecutionMode mode() const override { return ExecutionMode::Text; }
+};
+}
+
+void ConnectionBase::ping() {
+  fetchAll("SELECT 1")->drain();
+}
+
+std::vector<BatchResult> ConnectionBase::executeBatch(const std::span<const std::string_view> statements) {
+  std::vector<BatchResult> results;
+  results.reserve(statements.size());
+  for (const auto statement : statements) {
+    try {
+      // Materialised, so no result still streams from the connection when the next statement starts
+      results.push_back({.result = fetchAll(statement)->materialise()});
+    } catch (...) {
+      results.push_back({.error = std::current_exception()});
+    }
+  }
+  return results;
+}
+
+std::unique_ptr<PreparedStatement> ConnectionBase::prepare(const std::string_view statement) {
+  return std::make_unique<TextStatement>(*this, statement);
+}
+
 SqlVariant ConnectionBase::fetchScalar(const std::string_view statement) {
   const auto row = fetchRow(statement);
   if (row->columnCount() != 1) {
@@ -170,6 +213,28 @@ std::unique_ptr<explain::Plan> ConnectionBase::explain(const std::string_view st
   return nullptr;
 }
 
+MeasuredPlan ConnectionBase::explainAndMeasure(const std::string_view statement, const std::optional<std::string_view> name) {
+  const auto format = measuredExplainFormat();
+  if (!format) {
+    return {.plan = explain(statement, name)};
+  }
+  const std::string artifact_name = name.has_value() ? std::string(*name) : std::to_string(std::hash<std::string_view>{}(statement));
+  // A cached plan was not executed now, so there is nothing to measure
+  if (getArtefact(artifact_name, *format)) {
+    return {.plan = explain(statement, name)};
+  }
+  auto plan = explain(statement, name);
+  if (!plan) {
+    return {};
+  }
+  const auto root_rows = plan->planTree().rows_actual;
+  if (std::isnan(root_rows) || std::isinf(root_rows) || root_rows < 0 || plan->execution_time <= 0) {
+    return {.plan = std::move(plan)};
+  }
+  const auto execution_time = std::chrono::microseconds(static_cast<int64_t>(plan->execution_time * 1000.0));
+  return {.plan = std::move(plan), .execution_time = execution_time, .rows = static_cast<RowCount>(root_rows)};
+}
+
 void ConnectionBase::constructTable(const std::string_view ddl,
                                     const std::span<const std::filesystem::path> source_stems,
                                     const dbprove::StorageVariant storage_variant,
@@ -303,7 +368,7 @@ void ConnectionBase::validateSourcePaths(const std::vector<std::filesystem::path
   }
 }
 
-std::optional<std::string> ConnectionBase::getArtefact(const std::string_view name, const std::string_view extension) const {
+std::optional<std::string_view> ConnectionBase::getArtefact(const std::string_view name, const std::string_view extension) const {
   if (!artifacts_path_) {
     if (artifactReplayModeEnabled()) {
       throw std::runtime_error("Artifact replay mode is enabled but no artifacts directory was configured");
@@ -311,25 +376,13 @@ std::optional<std::string> ConnectionBase::getArtefact(const std::string_view na
     return std::nullopt;
   }
 
-  const std::string engine_name = engine().internalName();
-  const auto engine_dir = std::filesystem::path(*artifacts_path_) / engine_name;
-  const auto path = artefactPathWithDot(engine_dir, name, extension);
-  if (!std::filesystem::exists(path)) {
-    if (artifactReplayModeEnabled()) {
-      throw std::runtime_error("Missing required artifact: " + path.string());
-    }
-    return std::nullopt;
+  const auto engine_dir = std::filesystem::path(*artifacts_path_) / engine().internalName();
+  const auto key = artefactKey(name, extension);
+  const auto content = ArtefactPack::open(engine_dir).get(key);
+  if (!content && artifactReplayModeEnabled()) {
+    throw MissingArtefactException((engine_dir / key).string());
   }
-
-  std::ifstream f(path);
-  if (!f.is_open()) {
-    if (artifactReplayModeEnabled()) {
-      throw std::runtime_error("Failed to open required artifact: " + path.string());
-    }
-    return std::nullopt;
-  }
-
-  return std::string((std::istreambuf_iterator<char>(f)), std::istreambuf_iterator<char>());
+  return content;
 }
 
 void ConnectionBase::storeArtefact(const std::string_view name, const std::string_view extension, const std::string_view content) const {
@@ -337,18 +390,15 @@ void ConnectionBase::storeArtefact(const std::string_view name, const std::strin
     return;
   }
 
-  const std::string engine_name = engine().internalName();
-  const auto engine_dir = std::filesystem::path(*artifacts_path_) / engine_name;
-  std::filesystem::create_directories(engine_dir);
-  const auto path = artefactPathWithDot(engine_dir, name, extension);
+  const auto engine_dir = std::filesystem::path(*artifacts_path_) / engine().internalName();
+  const auto key = artefactKey(name, extension);
   const auto formatted_content = prettyContentIfNeeded(extension, content);
 
-  PLOGD << "Storing artefact to " << path.string();
-  std::ofstream f(path);
-  if (!f.is_open()) {
-    PLOGE << "Failed to open artefact file for writing: " << path.string();
-    return;
+  PLOGD << "Storing artefact " << key << " in " << engine_dir.string();
+  try {
+    ArtefactPack::open(engine_dir).put(key, formatted_content);
+  } catch (const std::exception& e) {
+    PLOGE << "Failed to store artefact " << key << ": " << e.what();
   }
-  f << formatted_content;
 }
 }
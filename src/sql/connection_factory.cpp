@@ -1,4 +1,5 @@
 #include "connection_factory.h"
+#include "connection_pool.h"
 #include "duckdb/connection.h"
 #ifndef DBPROVE_DUCKDB_ONLY
 #include "cedardb/connection.h"
@@ -15,6 +16,23 @@
 #endif
 
 namespace sql {
+void ConnectionFactory::enablePooling(const size_t max_size) {
+  pool_ = ConnectionPool::shared(*this, max_size);
+}
+
+ConnectionLease ConnectionFactory::acquire() {
+  if (pool_) {
+    return pool_->acquire();
+  }
+  return ConnectionLease(create(), nullptr);
+}
+
+void ConnectionFactory::prewarm(const size_t count) {
+  if (pool_) {
+    pool_->prewarm(count);
+  }
+}
+
 std::unique_ptr<ConnectionBase> ConnectionFactory::create() {
   connectionCount_.fetch_add(1);
   const auto type = engine_.type();
@@ -50,8 +68,7 @@ std::unique_ptr<ConnectionBase> ConnectionFactory::create() {
       return std::make_unique<duckdb::Connection>(std::get<CredentialFile>(credential_), engine_, artifacts_path_);
 #ifndef DBPROVE_DUCKDB_ONLY
     case Engine::Type::DataFusion:
-      // DataFusion intentionally reuses one process-wide driver session across
-      // factory.create() calls. See src/sql/datafusion/README.md.
+      // Each connection owns its own CLI session. See src/sql/datafusion/README.md.
       return std::make_unique<datafusion::Connection>(std::get<CredentialNone>(credential_), engine_, artifacts_path_);
     case Engine::Type::Databricks:
       return std::make_unique<databricks::Connection>(std::get<CredentialAccessToken>(credential_), engine_, artifacts_path_);
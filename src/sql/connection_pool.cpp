@@ -0,0 +1,237 @@
+#include "connection_pool.h"
+#include "connection_base.h"
+
+#include <functional>
+#include <map>
+#include <type_traits>
+#include <variant>
+#include <plog/Log.h>
+
+namespace sql {
+namespace {
+/// @brief Pools are shared by factories that would open identical connections
+std::string poolKey(const ConnectionFactory& factory) {
+  std::string key = factory.engine().name() + "|" + factory.artifactsPath().value_or("") + "|";
+  std::visit([&key]<typename T>(const T& credential) {
+    if constexpr (std::is_same_v<T, CredentialFile>) {
+      key += credential.path;
+    } else if constexpr (std::is_same_v<T, CredentialPassword>) {
+      key += credential.username + "@" + credential.host + ":" + std::to_string(credential.port) + "/"
+          + credential.database + "#" + std::to_string(std::hash<std::string>{}(credential.password.value_or("")));
+    } else if constexpr (std::is_same_v<T, CredentialNone>) {
+      key += credential.name;
+    } else {
+      key += credential.endpoint_url + "/" + credential.database + "#"
+          + std::to_string(std::hash<std::string>{}(credential.token));
+    }
+  }, factory.credential());
+  return key;
+}
+
+std::chrono::microseconds elapsedSince(const std::chrono::steady_clock::time_point start) {
+  return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start);
+}
+}
+
+ConnectionLease::ConnectionLease(std::unique_ptr<ConnectionBase> connection, std::shared_ptr<ConnectionPool> pool)
+  : connection_(std::move(connection))
+  , pool_(std::move(pool)) {
+}
+
+ConnectionLease::~ConnectionLease() {
+  release();
+}
+
+ConnectionLease::ConnectionLease(ConnectionLease&& other) noexcept = default;
+
+ConnectionLease& ConnectionLease::operator=(ConnectionLease&& other) noexcept {
+  if (this != &other) {
+    release();
+    connection_ = std::move(other.connection_);
+    pool_ = std::move(other.pool_);
+  }
+  return *this;
+}
+
+void ConnectionLease::release() {
+  if (!connection_) {
+    return;
+  }
+  if (pool_) {
+    pool_->release(std::move(connection_));
+    pool_.reset();
+    return;
+  }
+  try {
+    connection_->close();
+  } catch (const std::exception& e) {
+    PLOGW << "Failed to close connection: " << e.what();
+  }
+  connection_.reset();
+}
+
+ConnectionPool::ConnectionPool(const ConnectionFactory& factory, const size_t max_size)
+  : factory_(factory.engine(), factory.credential(), factory.artifactsPath())
+  , max_size_(std::max<size_t>(max_size, 1)) {
+}
+
+ConnectionPool::~ConnectionPool() {
+  for (auto& [connection, since] : idle_) {
+    try {
+      connection->close();
+    } catch (const std::exception& e) {
+      PLOGW << "Failed to close pooled connection: " << e.what();
+    }
+  }
+}
+
+std::shared_ptr<ConnectionPool> ConnectionPool::shared(const ConnectionFactory& factory, const size_t max_size) {
+  // Pools die with the last factory using them, so connections are closed while the drivers are still around
+  static std::mutex mutex;
+  static std::map<std::string, std::weak_ptr<ConnectionPool>> pools;
+
+  std::lock_guard lock(mutex);
+  auto& entry = pools[poolKey(factory)];
+  if (auto pool = entry.lock()) {
+    pool->grow(max_size);
+    return pool;
+  }
+  auto pool = std::make_shared<ConnectionPool>(factory, max_size);
+  entry = pool;
+  return pool;
+}
+
+std::unique_ptr<ConnectionBase> ConnectionPool::connect() {
+  const auto start = std::chrono::steady_clock::now();
+  auto connection = factory_.create();
+  // Drivers open their session lazily, the first round-trip makes sure the cost is counted here
+  connection->ping();
+  const auto connect_time = elapsedSince(start);
+
+  std::lock_guard lock(mutex_);
+  ++metrics_.connects;
+  metrics_.connect_time += connect_time;
+  return connection;
+}
+
+ConnectionLease ConnectionPool::acquire() {
+  const auto start = std::chrono::steady_clock::now();
+  std::unique_lock lock(mutex_);
+  bool waited = false;
+  while (idle_.empty() && open_ >= max_size_) {
+    if (!waited) {
+      waited = true;
+      ++metrics_.waiting;
+    }
+    released_.wait(lock);
+  }
+  metrics_.waiting -= waited ? 1 : 0;
+  const auto wait = elapsedSince(start);
+  ++metrics_.acquires;
+  metrics_.waits += waited ? 1 : 0;
+  metrics_.acquire_wait += wait;
+  metrics_.max_acquire_wait = std::max(metrics_.max_acquire_wait, wait);
+
+  if (idle_.empty()) {
+    ++open_;
+  } else {
+    auto idle = std::move(idle_.back());
+    idle_.pop_back();
+    lock.unlock();
+    if (std::chrono::steady_clock::now() - idle.since < health_check_after) {
+      return ConnectionLease(std::move(idle.connection), shared_from_this());
+    }
+    try {
+      idle.connection->ping();
+      return ConnectionLease(std::move(idle.connection), shared_from_this());
+    } catch (const std::exception& e) {
+      PLOGW << "Discarding pooled " << factory_.engine().name() << " connection that failed its health check: "
+          << e.what();
+    }
+    // The slot of the discarded connection goes to its replacement
+    lock.lock();
+    ++metrics_.discarded;
+  }
+  lock.unlock();
+
+  try {
+    return ConnectionLease(connect(), shared_from_this());
+  } catch (...) {
+    lock.lock();
+    --open_;
+    released_.notify_one();
+    throw;
+  }
+}
+
+void ConnectionPool::release(std::unique_ptr<ConnectionBase> connection) {
+  try {
+    connection->resetSession();
+  } catch (const std::exception& e) {
+    PLOGW << "Discarding pooled " << factory_.engine().name() << " connection that could not be reset: " << e.what();
+    connection.reset();
+  }
+
+  std::lock_guard lock(mutex_);
+  if (connection) {
+    idle_.push_back({std::move(connection), std::chrono::steady_clock::now()});
+  } else {
+    ++metrics_.discarded;
+    --open_;
+  }
+  released_.notify_one();
+}
+
+void ConnectionPool::prewarm(const size_t count) {
+  grow(count);
+  std::vector<std::unique_ptr<ConnectionBase>> opened;
+  {
+    std::lock_guard lock(mutex_);
+    if (open_ >= count) {
+      return;
+    }
+    opened.resize(count - open_);
+    open_ = count;
+  }
+
+  const auto start = std::chrono::steady_clock::now();
+  size_t failed = 0;
+  for (auto& connection : opened) {
+    try {
+      connection = connect();
+    } catch (const std::exception& e) {
+      PLOGW << "Failed to prewarm " << factory_.engine().name() << " connection: " << e.what();
+      ++failed;
+    }
+  }
+  PLOGD << "Prewarmed " << opened.size() - failed << " " << factory_.engine().name() << " connections in "
+        << elapsedSince(start).count() << " us";
+
+  std::lock_guard lock(mutex_);
+  open_ -= failed;
+  for (auto& connection : opened) {
+    if (connection) {
+      idle_.push_back({std::move(connection), std::chrono::steady_clock::now()});
+    }
+  }
+  released_.notify_all();
+}
+
+void ConnectionPool::grow(const size_t max_size) {
+  std::lock_guard lock(mutex_);
+  if (max_size > max_size_) {
+    max_size_ = max_size;
+    released_.notify_all();
+  }
+}
+
+ConnectionPool::Metrics ConnectionPool::metrics() const {
+  std::lock_guard lock(mutex_);
+  return metrics_;
+}
+
+size_t ConnectionPool::maxSize() const {
+  std::lock_guard lock(mutex_);
+  return max_size_;
+}
+}
@@ -1,12 +1,14 @@
 #include "connection.h"
 
 #include "include/dbprove/sql/parsed_table.h"
+#include <algorithm>
 #include <array>
 #include <chrono>
 #include <cstdio>
 #include <cstdlib>
 #include <filesystem>
 #include <fstream>
+#include <functional>
 #include <limits>
 #include <mutex>
 #include <optional>
@@ -95,6 +97,20 @@ std::string readTextFile(const std::filesystem::path& path) {
   return buffer.str();
 }
 
+/**
+ * Statements appended to the bootstrap file by this process. Sessions replay the ones registered after they
+ * started, so a table created on one connection is visible on every other.
+ */
+struct BootstrapRegistry {
+  std::mutex mutex;
+  std::vector<std::string> statements;
+};
+
+BootstrapRegistry& bootstrapRegistry() {
+  static BootstrapRegistry registry;
+  return registry;
+}
+
 void appendBootstrapStatement(std::string_view statement) {
   const auto path = bootstrapSqlHostPath();
   std::string existing;
@@ -120,58 +136,92 @@ void appendBootstrapStatement(std::string_view statement) {
   }
 }
 
+void registerBootstrapStatement(std::string_view statement) {
+  auto& registry = bootstrapRegistry();
+  std::lock_guard lock(registry.mutex);
+  appendBootstrapStatement(statement);
+  registry.statements.emplace_back(statement);
+}
+
+std::vector<std::string> bootstrapStatementsSince(const size_t index) {
+  auto& registry = bootstrapRegistry();
+  std::lock_guard lock(registry.mutex);
+  if (index >= registry.statements.size()) {
+    return {};
+  }
+  return {registry.statements.begin() + static_cast<std::ptrdiff_t>(index), registry.statements.end()};
+}
+
+size_t bootstrapStatementCount() {
+  auto& registry = bootstrapRegistry();
+  std::lock_guard lock(registry.mutex);
+  return registry.statements.size();
+}
+
+void waitForDataFusionBootstrapOnce() {
+  static std::once_flag ready;
+  std::call_once(ready, waitForDataFusionBootstrap);
+}
+
+using RowCallback = std::function<void(ordered_json&& row)>;
+constexpr std::string_view kEndOfResultColumn = "dbprove_end_of_result";
+
 std::string normalizeCliStatement(std::string_view sql);
 std::string describeExitCode(int exit_code);
 
 #ifndef _WIN32
+/// @brief Upper bound on running CLI sessions
+constexpr size_t kMaxSessions = 4;
+/// @brief Memory pool of the container, split evenly between the sessions in use at the same time
+constexpr size_t kMemoryPoolMiB = 7500;
+
+/**
+ * One `datafusion-cli` process running in nd-json mode, so every result row arrives as exactly one line.
+ *
+ * Each statement is followed by a sentinel SELECT whose single row marks the end of the result. That frames
+ * the output explicitly: rows are parsed once as they arrive, and errors are reported after the sentinel with the
+ * session still in sync.
+ */
 class PersistentCliSession {
   pid_t pid_ = -1;
   FILE* input_ = nullptr;
   FILE* output_ = nullptr;
+  char* line_buffer_ = nullptr;
+  size_t line_capacity_ = 0;
 
-  static std::string sessionCommand() {
+  static std::string sessionCommand(const size_t memory_mib) {
     return composeExecPrefix() +
            " exec -T " + shell_quote(std::string(kDataFusionComposeService)) + " sh -lc " +
            shell_quote("TMPDIR=/workspace/datafusion-spill "
-                       "exec /opt/datafusion-cli/bin/datafusion-cli --format json --quiet "
-                       "--mem-pool-type fair -b 100000 -m 7500m -r /workspace/datafusion-bootstrap.sql");
-  }
-
-  static std::string trimLine(std::string line) {
-    while (!line.empty() && (line.back() == '\n' || line.back() == '\r')) {
-      line.pop_back();
-    }
-    return line;
+                       "exec /opt/datafusion-cli/bin/datafusion-cli --format nd-json --quiet "
+                       "--mem-pool-type fair -b 100000 -m " + std::to_string(memory_mib) + "m "
+                       "-r /workspace/datafusion-bootstrap.sql");
   }
 
-  static bool isJsonPayload(std::string_view line) {
-    const auto trimmed = trim_string(line);
-    return !trimmed.empty() && (trimmed.front() == '[' || trimmed.front() == '{');
+  static std::string sentinelStatement() {
+    return "SELECT 1 AS " + std::string(kEndOfResultColumn) + ";\n";
   }
 
-  static bool isCompleteJsonPayload(std::string_view payload) {
-    try {
-      const auto parsed = json::parse(payload.begin(), payload.end());
-      static_cast<void>(parsed);
-      return true;
-    } catch (const json::parse_error&) {
-      return false;
+  static std::string_view trimLine(std::string_view line) {
+    while (!line.empty() && (line.back() == '\n' || line.back() == '\r')) {
+      line.remove_suffix(1);
     }
+    return line;
   }
 
   static std::string describeWaitStatus(const int status) {
     if (WIFSIGNALED(status)) {
       return "Persistent DataFusion session terminated by signal "
-             + std::to_string(WTERMSIG(status)) + " before producing JSON output";
+             + std::to_string(WTERMSIG(status)) + " before completing the query";
     }
     if (WIFEXITED(status)) {
       return describeExitCode(WEXITSTATUS(status));
     }
-    return "Persistent DataFusion session ended before producing JSON output";
+    return "Persistent DataFusion session ended before completing the query";
   }
 
 public:
-  PersistentCliSession() {
+  explicit PersistentCliSession(const size_t memory_mib) {
     int stdin_pipe[2];
     int stdout_pipe[2];
     if (pipe(stdin_pipe) != 0 || pipe(stdout_pipe) != 0) {
@@ -195,7 +245,7 @@ public:
       ::close(stdin_pipe[1]);
       ::close(stdout_pipe[0]);
       ::close(stdout_pipe[1]);
-      execl("/bin/sh", "sh", "-lc", sessionCommand().c_str(), static_cast<char*>(nullptr));
+      execl("/bin/sh", "sh", "-lc", sessionCommand(memory_mib).c_str(), static_cast<char*>(nullptr));
       _exit(127);
     }
 
@@ -211,6 +261,11 @@ public:
 
   ~PersistentCliSession() {
     close();
+    free(line_buffer_);
+  }
+
+  [[nodiscard]] bool isOpen() const {
+    return input_ != nullptr && output_ != nullptr && pid_ > 0;
   }
 
   void close() {
@@ -234,44 +289,49 @@ public:
     }
   }
 
-  std::string runJsonQuery(std::string_view sql) {
-    if (input_ == nullptr || output_ == nullptr) {
+  /**
+   * Run one statement, handing each result row to `on_row` as it is read
+   * @throw std::runtime_error with the CLI error text if the statement failed
+   */
+  void runQuery(std::string_view sql, const RowCallback& on_row) {
+    if (!isOpen()) {
       throw std::runtime_error("Persistent DataFusion session is not open");
     }
 
-    const std::string statement = normalizeCliStatement(sql);
+    const std::string statement = normalizeCliStatement(sql) + sentinelStatement();
     if (fwrite(statement.data(), 1, statement.size(), input_) != statement.size()) {
       throw std::runtime_error("Failed to write query to persistent DataFusion session");
     }
     fflush(input_);
 
-    std::array<char, 65536> buffer{};
-    std::string json_payload;
-    while (fgets(buffer.data(), static_cast<int>(buffer.size()), output_) != nullptr) {
-      std::string line = trimLine(buffer.data());
+    std::string error;
+    ssize_t length = 0;
+    while ((length = ::getline(&line_buffer_, &line_capacity_, output_)) > 0) {
+      const auto line = trimLine(std::string_view(line_buffer_, static_cast<size_t>(length)));
       if (line.empty()) {
         continue;
       }
-      if (line == trimLine(std::string(statement))) {
-        continue;
-      }
-      if (!json_payload.empty()) {
-        json_payload += line;
-        if (isCompleteJsonPayload(json_payload)) {
-          return json_payload;
+      if (line.front() == '{') {
+        auto row = ordered_json::parse(line, nullptr, false);
+        if (row.is_discarded()) {
+          throw ProtocolException("Failed to parse DataFusion nd-json row: " + std::string(line));
         }
-        continue;
-      }
-      if (isJsonPayload(line)) {
-        json_payload = line;
-        if (isCompleteJsonPayload(json_payload)) {
-          return json_payload;
+        if (row.size() == 1 && row.contains(kEndOfResultColumn)) {
+          if (!error.empty()) {
+            throw std::runtime_error(error);
+          }
+          return;
+        }
+        if (error.empty()) {
+          on_row(std::move(row));
         }
         continue;
       }
       const auto trimmed = trim_string(line);
       if (trimmed.starts_with("Error") || trimmed.starts_with("error")) {
-        throw std::runtime_error(line);
+        error = error.empty() ? std::string(line) : error + "\n" + std::string(line);
+      } else if (!error.empty()) {
+        error += "\n" + std::string(line);
       }
     }
 
@@ -283,10 +343,96 @@ public:
         throw std::runtime_error(describeWaitStatus(status));
       }
     }
-
-    throw std::runtime_error("Persistent DataFusion session ended before producing JSON output");
+    close();
+    throw std::runtime_error(error.empty() ? "Persistent DataFusion session ended before completing the query" : error);
   }
 };
+
+/**
+ * A CLI session and the connections using it. Each connection takes the slot with the fewest users, so up to
+ * `kMaxSessions` connections have a session of their own and any beyond that take turns, one statement at a time.
+ */
+struct SessionSlot {
+  /// @brief Held while a statement runs on the session
+  std::mutex mutex;
+  std::unique_ptr<PersistentCliSession> session;
+  size_t bootstrap_applied = 0;
+  /// @brief Memory pool the session was started with
+  size_t memory_mib = 0;
+  size_t connections = 0;
+};
+
+struct SessionSlots {
+  std::mutex mutex;
+  std::array<SessionSlot, kMaxSessions> slots;
+};
+
+SessionSlots& sessionSlots() {
+  static SessionSlots slots;
+  return slots;
+}
+
+/// @brief Memory each session gets while the slots in use share the pool. Caller holds the pool mutex
+size_t sessionMemoryMiB(const SessionSlots& pool) {
+  const auto in_use = std::ranges::count_if(pool.slots, [](const SessionSlot& slot) { return slot.connections > 0; });
+  return kMemoryPoolMiB / std::max<size_t>(in_use, 1);
+}
+
+/// @brief (Re)start the session of the slot. Caller holds the slot mutex
+void startSession(SessionSlot& slot, const size_t memory_mib) {
+  slot.session.reset();
+  // Snapshot before starting: the new process reads the bootstrap file itself, replaying a little extra is harmless
+  slot.bootstrap_applied = bootstrapStatementCount();
+  slot.session = std::make_unique<PersistentCliSession>(memory_mib);
+  slot.memory_mib = memory_mib;
+}
+
+/**
+ * Restart idle sessions whose memory pool no longer matches the number of slots in use, so a lone session has the
+ * whole pool and concurrent ones split it. A session running a statement keeps its size until the next rebalance.
+ * Caller holds the pool mutex
+ */
+void rebalanceSessions(SessionSlots& pool) {
+  const auto memory_mib = sessionMemoryMiB(pool);
+  for (auto& slot : pool.slots) {
+    if (!slot.session || slot.memory_mib == memory_mib) {
+      continue;
+    }
+    std::unique_lock slot_lock(slot.mutex, std::try_to_lock);
+    if (slot_lock.owns_lock()) {
+      startSession(slot, memory_mib);
+    }
+  }
+}
+
+SessionSlot& acquireSessionSlot() {
+  auto& pool = sessionSlots();
+  std::lock_guard lock(pool.mutex);
+  auto& slot = *std::ranges::min_element(pool.slots, {}, &SessionSlot::connections);
+  ++slot.connections;
+  rebalanceSessions(pool);
+  return slot;
+}
+
+void releaseSessionSlot(SessionSlot& slot) {
+  auto& pool = sessionSlots();
+  {
+    std::lock_guard lock(pool.mutex);
+    if (--slot.connections > 0) {
+      return;
+    }
+  }
+  {
+    // Take the slot before the pool, so acquiring a slot never waits for a statement to finish
+    std::lock_guard slot_lock(slot.mutex);
+    std::lock_guard lock(pool.mutex);
+    if (slot.connections == 0) {
+      slot.session.reset();
+    }
+  }
+  std::lock_guard lock(pool.mutex);
+  rebalanceSessions(pool);
+}
 #endif
 
 CommandResult runCommand(std::string_view command) {
@@ -534,42 +680,93 @@ class Connection::Pimpl {
   CredentialNone credential_;
   mutable std::recursive_mutex mutex_;
 #ifndef _WIN32
-  std::unique_ptr<PersistentCliSession> session_;
+  SessionSlot* slot_ = nullptr;
 #endif
 
   static std::string bootstrapSqlPath() { return "/workspace/datafusion-bootstrap.sql"; }
 
  public:
   explicit Pimpl(CredentialNone credential) : credential_(std::move(credential)) {
-    waitForDataFusionBootstrap();
-  }
-
-  void resetSession() {
+    waitForDataFusionBootstrapOnce();
 #ifndef _WIN32
-    if (session_) {
-      session_->close();
-      session_.reset();
+    // Start the session up front, so its startup is not timed as part of the first statement
+    try {
+      std::lock_guard lock(slot().mutex);
+      session();
+    } catch (...) {
+      release();
+      throw;
     }
 #endif
   }
 
-  void executeDDLInPersistentSession(std::string_view ddl) {
+  ~Pimpl() {
+    release();
+  }
+
+  /// @brief Stop using the session, it is stopped once no other connection uses it
+  void release() {
 #ifndef _WIN32
-    // DDL produces no output in quiet mode, so append SELECT 1 as a sentinel
-    // that yields a confirmable JSON response after the DDL is processed.
-    session().runJsonQuery(std::string(ddl) + "; SELECT 1");
+    if (slot_) {
+      releaseSessionSlot(*slot_);
+      slot_ = nullptr;
+    }
 #endif
   }
 
 #ifndef _WIN32
+  SessionSlot& slot() {
+    if (!slot_) {
+      slot_ = &acquireSessionSlot();
+    }
+    return *slot_;
+  }
+
+  /// @brief Replace the session after its process went away or lost sync. Caller holds the slot mutex
+  void resetSession() {
+    if (slot_ && slot_->session) {
+      slot_->session->close();
+      slot_->session.reset();
+    }
+  }
+
+  /**
+   * The CLI session of this connection's slot, started if needed and brought up to date with any DDL other
+   * connections registered since it started. Caller holds the slot mutex
+   */
   PersistentCliSession& session() {
-    if (!session_) {
-      session_ = std::make_unique<PersistentCliSession>();
+    auto& slot = this->slot();
+    if (!slot.session) {
+      auto& pool = sessionSlots();
+      std::unique_lock lock(pool.mutex);
+      const auto memory_mib = sessionMemoryMiB(pool);
+      lock.unlock();
+      startSession(slot, memory_mib);
     }
-    return *session_;
+    for (const auto& statement : bootstrapStatementsSince(slot.bootstrap_applied)) {
+      ++slot.bootstrap_applied;
+      slot.session->runQuery(statement, [](ordered_json&&) {});
+    }
+    return *slot.session;
   }
 #endif
 
+  /// @brief Register DDL for every session (current and future) and apply it to this one
+  void registerDDL(std::string_view ddl) {
+    registerBootstrapStatement(ddl);
+#ifndef _WIN32
+    std::lock_guard lock(slot().mutex);
+    try {
+      session();
+    } catch (const std::runtime_error& e) {
+      if (slot_->session && !slot_->session->isOpen()) {
+        resetSession();
+      }
+      throwForCommandError(credential_, ddl, 1, e.what());
+    }
+#endif
+  }
+
   std::recursive_mutex& mutex() const {
     return mutex_;
   }
@@ -607,18 +804,31 @@ class Connection::Pimpl {
 #endif
   }
 
-  std::string runPersistentJsonQuery(std::string_view sql) {
+  void runQuery(std::string_view sql, const RowCallback& on_row) {
 #ifdef _WIN32
     const auto result = runCli(rewriteStatement(sql));
     if (result.exit_code != 0) {
       throwForCommandError(credential_, sql, result.exit_code, result.output);
     }
-    return trimOutput(result.output);
+    auto payload = ordered_json::parse(trimOutput(result.output), nullptr, false);
+    if (payload.is_discarded() || !payload.is_array()) {
+      throw ProtocolException("Expected DataFusion CLI to return a JSON array");
+    }
+    for (auto& row : payload) {
+      on_row(std::move(row));
+    }
 #else
+    std::lock_guard lock(slot().mutex);
     try {
-      return session().runJsonQuery(rewriteStatement(sql));
-    } catch (const std::runtime_error& e) {
+      session().runQuery(rewriteStatement(sql), on_row);
+    } catch (const ProtocolException&) {
       resetSession();
+      throw;
+    } catch (const std::runtime_error& e) {
+      // SQL errors leave the session in sync; only replace it if the process went away
+      if (slot_->session && !slot_->session->isOpen()) {
+        resetSession();
+      }
       throwForCommandError(credential_, sql, 1, e.what());
     }
 #endif
@@ -628,10 +838,7 @@ class Connection::Pimpl {
 Connection::Connection(const CredentialNone& credential, const Engine& engine,
                        std::optional<std::string> artifacts_path)
     : ConnectionBase(credential, engine, std::move(artifacts_path)),
-      impl_([](const CredentialNone& singleton_credential) {
-        static const auto singleton = std::make_shared<Pimpl>(singleton_credential);
-        return singleton;
-      }(credential)) {}
+      impl_(std::make_unique<Pimpl>(credential)) {}
 
 Connection::~Connection() = default;
 
@@ -655,22 +862,10 @@ void Connection::execute(std::string_view statement) {
 
 std::unique_ptr<ResultBase> Connection::fetchJsonQuery(std::string_view statement) {
   const std::lock_guard<std::recursive_mutex> lock(driverMutex());
-  const auto raw_output = trimOutput(impl_->runPersistentJsonQuery(statement));
-  ordered_json payload;
-  try {
-    payload = ordered_json::parse(raw_output);
-  } catch (const std::exception& e) {
-    throw ProtocolException("Failed to parse DataFusion JSON output: " + std::string(e.what()));
-  }
-
-  if (!payload.is_array()) {
-    throw ProtocolException("Expected DataFusion CLI to return a JSON array");
-  }
-
   std::vector<std::vector<SqlVariant>> rows;
   std::vector<std::string> column_names;
   std::vector<SqlTypeKind> column_types;
-  for (const auto& row_json : payload) {
+  impl_->runQuery(statement, [&](ordered_json&& row_json) {
     if (!row_json.is_object()) {
       throw ProtocolException("Expected DataFusion row payload to be an object");
     }
@@ -693,7 +888,7 @@ std::unique_ptr<ResultBase> Connection::fetchJsonQuery(std::string_view statemen
       row.push_back(std::move(variant));
     }
     rows.push_back(std::move(row));
-  }
+  });
 
   return std::make_unique<Result>(std::move(rows), std::move(column_types));
 }
@@ -728,12 +923,9 @@ void Connection::constructTable(std::string_view ddl,
   const auto create_table = "CREATE EXTERNAL TABLE IF NOT EXISTS " + std::string(table)
                           + " STORED AS PARQUET LOCATION '" + parquet_path.string() + "'";
   if (!split.schema_name.empty()) {
-    const auto create_schema = "CREATE SCHEMA IF NOT EXISTS " + split.schema_name;
-    appendBootstrapStatement(create_schema);
-    impl_->executeDDLInPersistentSession(create_schema);
+    impl_->registerDDL("CREATE SCHEMA IF NOT EXISTS " + split.schema_name);
   }
-  appendBootstrapStatement(create_table);
-  impl_->executeDDLInPersistentSession(create_table);
+  impl_->registerDDL(create_table);
 }
 
 void Connection::analyse(std::string_view table_name) {
@@ -747,7 +939,10 @@ std::string Connection::version() {
   return fetchScalar("SELECT version()").asString();
 }
 
-void Connection::close() {}
+void Connection::close() {
+  const std::lock_guard<std::recursive_mutex> lock(driverMutex());
+  impl_->release();
+}
 
 json Connection::fetchPhysicalPlanJson(std::string_view statement) const {
   const std::lock_guard<std::recursive_mutex> lock(driverMutex());
@@ -9,7 +9,7 @@
 namespace sql::datafusion {
 class Connection final : public ConnectionBase {
   class Pimpl;
-  std::shared_ptr<Pimpl> impl_;
+  std::unique_ptr<Pimpl> impl_;
 
   std::unique_ptr<ResultBase> fetchJsonQuery(std::string_view statement);
   nlohmann::json fetchPhysicalPlanJson(std::string_view statement) const;
@@ -165,11 +165,30 @@ public:
   }
 
   [[nodiscard]] std::unique_ptr<::duckdb::QueryResult> execute(const std::string_view statement) const {
+    return guarded([this, statement]() {
+      const auto mapped_statement = connection.mapTypes(statement);
+      return db_connection->Query(std::string(mapped_statement));
+    });
+  }
+
+  [[nodiscard]] std::unique_ptr<::duckdb::PreparedStatement> prepare(const std::string_view statement) const {
+    check_connection();
+    auto prepared = db_connection->Prepare(connection.mapTypes(statement));
+    if (prepared->HasError()) {
+      throw SyntaxException(prepared->GetError(), statement);
+    }
+    return prepared;
+  }
+
+  /**
+   * Run a DuckDB call producing a result, turning DuckDB errors into ours and enforcing the query timeout
+   */
+  template <typename Run>
+  [[nodiscard]] std::unique_ptr<::duckdb::QueryResult> guarded(Run run) const {
     check_connection();
-    auto do_execute = [this, statement]() {
+    auto do_execute = [this, &run]() {
       try {
-        const auto mapped_statement = connection.mapTypes(statement);
-        auto result = db_connection->Query(std::string(mapped_statement));
+        auto result = run();
 
         handleDuckError(result.get());
         return result;
@@ -226,6 +245,36 @@ std::unique_ptr<ResultBase> Connection::fetchAll(const std::string_view statemen
   return std::make_unique<Result>(holder);
 }
 
+/**
+ * Statement parsed and bound once by DuckDB, executed without going through the parser again
+ */
+class Connection::Statement final : public PreparedStatement {
+  Pimpl& impl_;
+  std::unique_ptr<::duckdb::PreparedStatement> prepared_;
+
+public:
+  Statement(Pimpl& impl, const std::string_view statement)
+    : impl_(impl)
+    , prepared_(impl.prepare(statement)) {
+  }
+
+  std::unique_ptr<ResultBase> fetchAll() override {
+    auto result = impl_.guarded([this]() {
+      ::duckdb::vector<::duckdb::Value> values;
+      // Result reads materialised results only
+      return prepared_->Execute(values, false);
+    });
+    ResultHolder holder = ResultHolder{std::move(result)};
+    return std::make_unique<Result>(holder);
+  }
+
+  ExecutionMode mode() const override { return ExecutionMode::Prepared; }
+};
+
+std::unique_ptr<PreparedStatement> Connection::prepare(const std::string_view statement) {
+  return std::make_unique<Statement>(*impl_, statement);
+}
+
 void Connection::bulkLoad(const std::string_view table, const std::vector<std::filesystem::path> source_paths) {
   if (source_paths.empty()) {
     throw std::invalid_argument("No source paths provided for bulk load");
@@ -5,6 +5,7 @@ namespace sql::duckdb {
 class Connection final : public ConnectionBase {
   class Pimpl;
   std::unique_ptr<Pimpl> impl_;
+  class Statement;
 
 public:
   explicit Connection(const CredentialFile& credential, const Engine& engine, std::optional<std::string> artifacts_path = std::nullopt);
@@ -14,10 +15,14 @@ public:
 
   void execute(std::string_view statement) override;
   std::unique_ptr<ResultBase> fetchAll(std::string_view statement) override;
+  std::unique_ptr<PreparedStatement> prepare(std::string_view statement) override;
   void bulkLoad(const std::string_view table, const std::vector<std::filesystem::path> source_paths) override;
   std::unique_ptr<explain::Plan> explain(std::string_view statement, std::optional<std::string_view> name = std::nullopt) override;
   std::string version() override;
   void close() override;
   bool shouldSkipDatasetTuning(std::string_view dataset) override;
+
+protected:
+  [[nodiscard]] std::optional<std::string_view> measuredExplainFormat() const override;
 };
 } // namespace sql::duckdb
@@ -447,11 +447,14 @@ std::unique_ptr<Plan> buildExplainPlan(json& json) {
   double planning_time = 0.0;
   double execution_time = 0.0;
 
+  // DuckDB reports seconds. Prefer wall clock latency over summed operator CPU time
   if (json.contains("planner")) {
-    planning_time = json["planner"].get<double>();
+    planning_time = json["planner"].get<double>() * 1000.0;
   }
-  if (json.contains("cpu_time")) {
-    execution_time = json["cpu_time"].get<double>();
+  if (json.contains("latency")) {
+    execution_time = json["latency"].get<double>() * 1000.0;
+  } else if (json.contains("cpu_time")) {
+    execution_time = json["cpu_time"].get<double>() * 1000.0;
   }
 
   auto& plan_json = json["children"];
@@ -491,4 +494,9 @@ std::unique_ptr<Plan> Connection::explain(const std::string_view statement, std:
 
   return buildExplainPlan(explain_json);
 }
+
+std::optional<std::string_view> Connection::measuredExplainFormat() const {
+  // EXPLAIN ANALYSE runs the query and profiles the execution
+  return "json";
+}
 }
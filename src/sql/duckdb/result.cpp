@@ -8,6 +8,89 @@
 
 
 namespace sql::duckdb {
+namespace {
+template <typename T, typename Append>
+void copyValues(::duckdb::Vector& vector, const size_t chunk_size, const size_t begin, const size_t end,
+                ColumnVector& out, Append append) {
+  ::duckdb::UnifiedVectorFormat format;
+  vector.ToUnifiedFormat(chunk_size, format);
+  const auto* values = ::duckdb::UnifiedVectorFormat::GetData<T>(format);
+  for (size_t i = begin; i < end; ++i) {
+    const auto index = format.sel->get_index(i);
+    if (!format.validity.RowIsValid(index)) {
+      out.appendNull();
+      continue;
+    }
+    append(values[index]);
+  }
+}
+
+template <typename T>
+void copyDecimals(::duckdb::Vector& vector, const size_t chunk_size, const size_t begin, const size_t end,
+                  ColumnVector& out, const uint16_t scale) {
+  copyValues<T>(vector, chunk_size, begin, end, out, [&out, scale](const T v) {
+    out.appendString(parseDecimal(v, scale).template get<SqlDecimal>().get());
+  });
+}
+
+void copyColumn(::duckdb::Vector& vector, const size_t chunk_size, const size_t begin, const size_t end,
+                ColumnVector& out) {
+  const auto append_int = [&out](const auto v) { out.appendInt(static_cast<int64_t>(v)); };
+  const auto append_double = [&out](const auto v) { out.appendDouble(static_cast<double>(v)); };
+  const auto& type = vector.GetType();
+  switch (type.id()) {
+    case ::duckdb::LogicalTypeId::BOOLEAN:
+      out.setKind(SqlTypeKind::SMALLINT);
+      return copyValues<bool>(vector, chunk_size, begin, end, out, append_int);
+    case ::duckdb::LogicalTypeId::TINYINT:
+      out.setKind(SqlTypeKind::SMALLINT);
+      return copyValues<int8_t>(vector, chunk_size, begin, end, out, append_int);
+    case ::duckdb::LogicalTypeId::SMALLINT:
+      out.setKind(SqlTypeKind::SMALLINT);
+      return copyValues<int16_t>(vector, chunk_size, begin, end, out, append_int);
+    case ::duckdb::LogicalTypeId::INTEGER:
+      out.setKind(SqlTypeKind::INT);
+      return copyValues<int32_t>(vector, chunk_size, begin, end, out, append_int);
+    case ::duckdb::LogicalTypeId::BIGINT:
+      out.setKind(SqlTypeKind::BIGINT);
+      return copyValues<int64_t>(vector, chunk_size, begin, end, out, append_int);
+    case ::duckdb::LogicalTypeId::FLOAT:
+      out.setKind(SqlTypeKind::REAL);
+      return copyValues<float>(vector, chunk_size, begin, end, out, append_double);
+    case ::duckdb::LogicalTypeId::DOUBLE:
+      out.setKind(SqlTypeKind::DOUBLE);
+      return copyValues<double>(vector, chunk_size, begin, end, out, append_double);
+    case ::duckdb::LogicalTypeId::VARCHAR:
+      out.setKind(SqlTypeKind::STRING);
+      return copyValues<::duckdb::string_t>(vector, chunk_size, begin, end, out, [&out](const ::duckdb::string_t v) {
+        out.appendString(std::string_view(v.GetData(), v.GetSize()));
+      });
+    case ::duckdb::LogicalTypeId::DECIMAL: {
+      out.setKind(SqlTypeKind::DECIMAL);
+      const int width = ::duckdb::DecimalType::GetWidth(type);
+      const uint16_t scale = ::duckdb::DecimalType::GetScale(type);
+      if (width <= 4) {
+        return copyDecimals<int16_t>(vector, chunk_size, begin, end, out, scale);
+      }
+      if (width <= 9) {
+        return copyDecimals<int32_t>(vector, chunk_size, begin, end, out, scale);
+      }
+      if (width <= 18) {
+        return copyDecimals<int64_t>(vector, chunk_size, begin, end, out, scale);
+      }
+      return copyDecimals<::duckdb::hugeint_t>(vector, chunk_size, begin, end, out, scale);
+    }
+    case ::duckdb::LogicalTypeId::SQLNULL:
+      for (size_t i = begin; i < end; ++i) {
+        out.appendNull();
+      }
+      return;
+    default:
+      throw InvalidTypeException("Unsupported DuckDb column type: " + type.ToString());
+  }
+}
+}
+
 class Result::Pimpl {
 public:
   Result& result;
@@ -51,6 +134,27 @@ public:
     ++nextChunkIndex;
     return currentRow_;
   }
+
+  bool nextBatch(ColumnBatch& batch, const size_t max_rows) {
+    batch.reset(columnCount_);
+    if (!currentChunk_ || nextChunkIndex >= currentChunk_->size()) {
+      currentChunk_ = duck_result_->Fetch();
+      nextChunkIndex = 0;
+    }
+    if (!currentChunk_ || currentChunk_->size() == 0) {
+      return false;
+    }
+    const size_t chunk_size = currentChunk_->size();
+    const size_t begin = nextChunkIndex;
+    const size_t end = std::min(chunk_size, begin + max_rows);
+    for (size_t i = 0; i < columnCount_; ++i) {
+      auto& column = batch.column(i);
+      column.reserve(end - begin);
+      copyColumn(currentChunk_->data[i], chunk_size, begin, end, column);
+    }
+    nextChunkIndex = end;
+    return true;
+  }
 };
 
 RowCount Result::rowNumber() const {
@@ -138,4 +242,8 @@ ColumnCount Result::columnCount() const { return impl_->columnCount_; }
 const RowBase& Result::nextRow() {
   return impl_->nextRow();
 }
+
+bool Result::nextBatch(ColumnBatch& batch, const size_t max_rows) {
+  return impl_->nextBatch(batch, max_rows);
+}
 }
@@ -22,6 +22,7 @@ public:
 
   RowCount rowCount() const override;;
   ColumnCount columnCount() const override;;
+  bool nextBatch(ColumnBatch& batch, size_t max_rows = DEFAULT_BATCH_ROWS) override;
 
 protected:
   void reset() override {
@@ -529,4 +529,14 @@ bool Engine::needsLocalFile() const {
       return true;
   }
 }
+
+bool Engine::supportsConcurrentSessions() const {
+  switch (type_) {
+    case Type::DuckDB:
+    case Type::SQLite:
+      return false;
+    default:
+      return true;
+  }
+}
 }
@@ -1,13 +1,20 @@
 #include "explain/plan.h"
 #include "cutoff.h"
 #include "dbprove/common/pretty.h"
+#include <dbprove/sql/artefact_pack.h>
 #include <dbprove/sql/connection_base.h>
+#include <dbprove/sql/connection_factory.h>
 #include <plog/Log.h>
 
+#include <atomic>
+#include <charconv>
 #include <cmath>
+#include <format>
 #include <iostream>
 #include <ranges>
 #include <rang.hpp>
+#include <thread>
+#include <unordered_map>
 
 #include "join.h"
 #include "scan.h"
@@ -408,26 +415,205 @@ void Plan::render(std::ostream& out, size_t max_width, RenderMode mode) const {
   }
 }
 
-void Plan::fixActuals(sql::ConnectionBase& connection) {
-  for (auto& node : planTree().depth_first()) {
-    const auto sql = connection.transformActualsSQL(node.actualsSql());
+namespace {
+/**
+ * One distinct actuals query and every plan node that shares it
+ */
+struct ActualsQuery {
+  std::string sql;
+  std::vector<Node*> nodes;
+  std::optional<RowCount> rows;
+};
+
+std::string datasetKey(const Credential& credential) {
+  return std::visit([]<typename T>(const T& c) -> std::string {
+    if constexpr (std::is_same_v<T, CredentialFile>) {
+      return std::filesystem::path(c.path).stem().string();
+    } else if constexpr (std::is_same_v<T, CredentialNone>) {
+      return c.name;
+    } else {
+      return c.database;
+    }
+  }, credential);
+}
+
+/// @brief Artefact name of a cached count. The artefact directory is already per engine
+std::string actualsArtefactName(const std::string& dataset, const std::string& sql) {
+  return std::format("actuals_{}_{:016x}", dataset, contentHash(sql));
+}
+
+/// @brief Cached count for `sql`, if present. The artefact stores the SQL too, so hash collisions are a miss
+std::optional<RowCount> loadCachedActuals(const ConnectionBase& connection, const std::string& name,
+                                          const std::string& sql) {
+  std::optional<std::string_view> cached;
+  try {
+    cached = connection.getArtefact(name, "actuals");
+  } catch (const MissingArtefactException&) {
+    // Replay mode requires every artefact, but a count that was never cached is counted like any other miss
+    return std::nullopt;
+  }
+  if (!cached) {
+    return std::nullopt;
+  }
+  const auto newline = cached->find('\n');
+  if (newline == std::string_view::npos || cached->substr(newline + 1) != sql) {
+    return std::nullopt;
+  }
+  int64_t rows = 0;
+  const auto [_, ec] = std::from_chars(cached->data(), cached->data() + newline, rows);
+  if (ec != std::errc()) {
+    return std::nullopt;
+  }
+  return static_cast<RowCount>(rows);
+}
+
+/// Counts sent together with `executeBatch`, so engines that pipeline statements pay one round trip per batch
+constexpr size_t actuals_batch_size = 16;
+
+void logActualsFailure(const ActualsQuery& query, const std::string_view error) {
+  const auto& node = *query.nodes.front();
+  PLOGE << "fixActuals failed for node id=" << node.id()
+      << " type=" << node.typeName()
+      << " error=" << error
+      << "\nSQL:\n"
+      << query.sql;
+}
+
+/// @brief The count in the single row, single column result of an actuals query
+RowCount countFromResult(ResultBase& result, const std::string_view sql) {
+  if (result.columnCount() != 1) {
+    throw InvalidColumnsException("Expected to find a single column in the data", sql);
+  }
+  std::optional<RowCount> count;
+  for (auto& row : result.rows()) {
+    if (count) {
+      throw InvalidRowsException("Expected to find a single row in the data, but found more than one", sql);
+    }
+    count = static_cast<RowCount>(row.asVariant(0).asInt8());
+  }
+  if (!count) {
+    throw EmptyResultException(sql);
+  }
+  return *count;
+}
+
+void countActuals(ConnectionBase& connection, std::span<ActualsQuery* const> queries) {
+  std::vector<std::string_view> statements;
+  statements.reserve(queries.size());
+  for (const auto* query : queries) {
+    statements.push_back(query->sql);
+  }
+
+  std::vector<BatchResult> results;
+  try {
+    results = connection.executeBatch(statements);
+  } catch (const std::exception& e) {
+    for (const auto* query : queries) {
+      logActualsFailure(*query, e.what());
+    }
+    return;
+  }
+  for (size_t i = 0; i < queries.size(); ++i) {
+    auto& query = *queries[i];
     try {
-      node.rows_actual = static_cast<RowCount>(connection.fetchScalar(sql).asInt8());
+      if (results[i].error) {
+        std::rethrow_exception(results[i].error);
+      }
+      query.rows = countFromResult(*results[i].result, query.sql);
     } catch (const std::exception& e) {
-      PLOGE << "fixActuals failed for node id=" << node.id()
-            << " type=" << node.typeName()
-            << " error=" << e.what()
-            << "\nSQL:\n"
-            << sql;
-      continue;
+      logActualsFailure(query, e.what());
     } catch (...) {
-      PLOGE << "fixActuals failed for node id=" << node.id()
-            << " type=" << node.typeName()
-            << " error=<unknown>"
-            << "\nSQL:\n"
-            << sql;
+      logActualsFailure(query, "<unknown>");
+    }
+  }
+}
+
+/**
+ * Run the counts on `connection` plus up to `max_connections - 1` extra connections made from the same
+ * engine and credential. Workers claim batches of queries through a shared cursor and send each batch with
+ * `executeBatch`.
+ */
+void countActualsConcurrently(ConnectionBase& connection, std::vector<ActualsQuery*>& pending,
+                              const size_t max_connections) {
+  std::vector<std::unique_ptr<ConnectionBase>> extra_connections;
+  const auto extra_count = std::min(max_connections, pending.size()) - 1;
+  if (extra_count > 0) {
+    ConnectionFactory factory(connection.engine(), connection.credential, connection.artifactsPath());
+    for (size_t i = 0; i < extra_count; ++i) {
+      try {
+        auto extra = factory.create();
+        extra->setQueryTimeout(connection.queryTimeoutSeconds());
+        extra_connections.push_back(std::move(extra));
+      } catch (const std::exception& e) {
+        PLOGW << "fixActuals continues with " << extra_connections.size() + 1
+            << " connections, failed to open another: " << e.what();
+        break;
+      }
+    }
+  }
+
+  // Small batches keep the work spread over the connections when there are few counts
+  const auto batch_size = std::clamp<size_t>(pending.size() / (2 * (extra_connections.size() + 1)), 1,
+                                             actuals_batch_size);
+  std::atomic<size_t> cursor{0};
+  const auto worker = [&pending, &cursor, batch_size](ConnectionBase& session) {
+    for (auto i = cursor.fetch_add(batch_size); i < pending.size(); i = cursor.fetch_add(batch_size)) {
+      countActuals(session, std::span(pending).subspan(i, std::min(batch_size, pending.size() - i)));
+    }
+  };
+
+  std::vector<std::jthread> threads;
+  threads.reserve(extra_connections.size());
+  for (auto& extra : extra_connections) {
+    threads.emplace_back(worker, std::ref(*extra));
+  }
+  worker(connection);
+  threads.clear();
+  for (const auto& extra : extra_connections) {
+    extra->close();
+  }
+}
+}
+
+void Plan::fixActuals(sql::ConnectionBase& connection, const size_t max_connections) {
+  std::unordered_map<std::string, ActualsQuery> queries;
+  for (auto& node : planTree().depth_first()) {
+    auto sql = connection.transformActualsSQL(node.actualsSql());
+    auto& query = queries[sql];
+    if (query.nodes.empty()) {
+      query.sql = std::move(sql);
+    }
+    query.nodes.push_back(&node);
+  }
+
+  const auto dataset = datasetKey(connection.credential);
+  std::vector<ActualsQuery*> pending;
+  for (auto& query : queries | std::views::values) {
+    query.rows = loadCachedActuals(connection, actualsArtefactName(dataset, query.sql), query.sql);
+    if (!query.rows) {
+      pending.push_back(&query);
+    }
+  }
+  PLOGI << "fixActuals: " << queries.size() << " distinct subtrees, " << queries.size() - pending.size()
+      << " cached, " << pending.size() << " to count";
+
+  if (!pending.empty()) {
+    countActualsConcurrently(connection, pending, std::max<size_t>(max_connections, 1));
+  }
+
+  for (const auto* query : pending) {
+    if (query->rows) {
+      connection.storeArtefact(actualsArtefactName(dataset, query->sql), "actuals",
+                               std::to_string(*query->rows) + "\n" + query->sql);
+    }
+  }
+  for (const auto& query : queries | std::views::values) {
+    if (!query.rows) {
       continue;
     }
+    for (auto* node : query.nodes) {
+      node->rows_actual = *query.rows;
+    }
   }
   syncSequenceRowCounts(planTree());
 }
@@ -0,0 +1,89 @@
+#pragma once
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace sql {
+/// @brief 64 bit digest that is the same on every platform and build, so it can name files that outlive the process
+uint64_t contentHash(std::string_view content);
+
+/**
+ * Append-only, content-addressed store for the explain artefacts of one engine and version.
+ *
+ * The pack lives in a directory next to any loose artefact files from older runs:
+ * - `artefacts.pack` holds every distinct artefact content once, back to back.
+ * - `artefacts.idx` has one tab separated line per store: content hash, offset, size and `<name>.<extension>`.
+ *   The last line for a name wins. Earlier ones are stale until `compact` drops them.
+ *
+ * The pack file is memory mapped, so artefacts are served as `std::string_view` without copying. The pack only
+ * grows and older mappings are kept when it is remapped, so views stay valid for the lifetime of the pack.
+ */
+class ArtefactPack {
+public:
+  static constexpr std::string_view pack_file_name = "artefacts.pack";
+  static constexpr std::string_view index_file_name = "artefacts.idx";
+
+  struct CompactionStats {
+    size_t entries = 0;
+    size_t stale_entries = 0;
+    size_t imported_files = 0;
+    uintmax_t bytes_before = 0;
+    uintmax_t bytes_after = 0;
+  };
+
+  /// @brief The pack in `directory`, shared by every connection in the process and never closed
+  static ArtefactPack& open(const std::filesystem::path& directory);
+
+  explicit ArtefactPack(std::filesystem::path directory);
+  ~ArtefactPack();
+  ArtefactPack(const ArtefactPack&) = delete;
+  ArtefactPack& operator=(const ArtefactPack&) = delete;
+
+  /**
+   * @brief Look up an artefact, falling back to a loose `<directory>/<key>` file written by older versions
+   * @param key `<name>.<extension>` of the artefact
+   * @return View of the content, valid as long as the pack, nullopt if there is no such artefact
+   */
+  std::optional<std::string_view> get(std::string_view key);
+
+  /// @brief Store `content` under `key`. Content already in the pack is referenced instead of written again
+  void put(std::string_view key, std::string_view content);
+
+  /**
+   * @brief Rewrite the pack in `directory` keeping only the content that live entries refer to.
+   *
+   * Loose artefact files that are not in the pack yet are imported, the files themselves are left alone.
+   * Must not run while another process uses the pack.
+   */
+  static CompactionStats compact(const std::filesystem::path& directory);
+
+private:
+  struct Blob {
+    uint64_t hash = 0;
+    uint64_t offset = 0;
+    uint64_t size = 0;
+  };
+  class Mapping;
+
+  void loadIndex();
+  std::string_view view(const Blob& blob);
+  void append(std::string_view key, const Blob& blob, std::string_view content, bool write_content);
+
+  const std::filesystem::path directory_;
+  std::mutex mutex_;
+  std::map<std::string, Blob, std::less<>> entries_;
+  std::multimap<uint64_t, Blob> blobs_;
+  std::vector<std::unique_ptr<Mapping>> mappings_;
+  std::map<std::string, std::string, std::less<>> loose_;
+  uint64_t pack_size_ = 0;
+  std::ofstream pack_out_;
+  std::ofstream index_out_;
+};
+}
@@ -0,0 +1,101 @@
+#pragma once
+#include <cstdint>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "sql_type.h"
+
+namespace sql {
+/**
+ * Contiguous values of one result column inside a `ColumnBatch`.
+ *
+ * Integer kinds are widened into one `int64_t` array and floating point kinds into one `double` array.
+ * Everything else, including DECIMAL and temporal kinds, is stored as text: all bytes in one buffer with
+ * `offsets()` marking where each row starts, so row `i` spans `[offsets()[i], offsets()[i + 1])`.
+ * NULL rows have their bit set in `nullBitmap()` and hold a zero or empty string in the value slot.
+ */
+class ColumnVector {
+public:
+  enum class Storage {
+    NONE,
+    INT64,
+    DOUBLE,
+    STRING
+  };
+
+private:
+  SqlTypeKind kind_ = SqlTypeKind::SQL_NULL;
+  Storage storage_ = Storage::NONE;
+  size_t size_ = 0;
+  std::vector<int64_t> ints_;
+  std::vector<double> doubles_;
+  std::vector<uint64_t> offsets_{0};
+  std::string data_;
+  std::vector<uint64_t> nulls_;
+
+  void growNulls();
+
+public:
+  /// @brief Storage used for values of the kind
+  static Storage storageFor(SqlTypeKind kind);
+
+  /// @brief Drop all values and the kind but keep the allocated capacity
+  void clear();
+  void reserve(size_t rows);
+
+  /**
+   * @brief Fix the kind of the column. Drivers that know the result schema call this before appending.
+   * Columns whose kind is not set take the kind of the first non-NULL value appended.
+   */
+  void setKind(SqlTypeKind kind);
+
+  [[nodiscard]] SqlTypeKind kind() const { return kind_; }
+  [[nodiscard]] Storage storage() const { return storage_; }
+  [[nodiscard]] size_t size() const { return size_; }
+
+  void appendInt(int64_t value);
+  void appendDouble(double value);
+  void appendString(std::string_view value);
+  void appendNull();
+  /// @brief Slow path for drivers that only produce `SqlVariant`
+  void append(const SqlVariant& value);
+
+  [[nodiscard]] bool isNull(const size_t row) const {
+    return (nulls_[row / 64] >> (row % 64)) & 1;
+  }
+
+  [[nodiscard]] std::span<const int64_t> ints() const { return ints_; }
+  [[nodiscard]] std::span<const double> doubles() const { return doubles_; }
+  [[nodiscard]] std::span<const uint64_t> offsets() const { return offsets_; }
+  [[nodiscard]] std::string_view data() const { return data_; }
+  /// @brief One bit per row, least significant bit first. A set bit marks a NULL
+  [[nodiscard]] std::span<const uint64_t> nullBitmap() const { return nulls_; }
+
+  [[nodiscard]] std::string_view string(const size_t row) const {
+    return std::string_view(data_).substr(offsets_[row], offsets_[row + 1] - offsets_[row]);
+  }
+
+  /// @brief Value of the row as a `SqlVariant`, for callers still working row by row
+  [[nodiscard]] SqlVariant asVariant(size_t row) const;
+};
+
+/**
+ * A slice of a result laid out column by column. Returned by `ResultBase::nextBatch`.
+ *
+ * A batch is meant to be reused across calls, so buffers only grow once.
+ */
+class ColumnBatch {
+  std::vector<ColumnVector> columns_;
+
+public:
+  /// @brief Prepare for `column_count` columns and drop all values
+  void reset(ColumnCount column_count);
+
+  [[nodiscard]] RowCount rowCount() const { return columns_.empty() ? 0 : columns_.front().size(); }
+  [[nodiscard]] ColumnCount columnCount() const { return columns_.size(); }
+  [[nodiscard]] ColumnVector& column(const size_t index) { return columns_.at(index); }
+  [[nodiscard]] const ColumnVector& column(const size_t index) const { return columns_.at(index); }
+};
+}
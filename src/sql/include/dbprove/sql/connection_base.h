@@ -3,9 +3,12 @@
 #include "credential.h"
 #include "sql_type.h"
 #include "result_base.h"
+#include "prepared_statement.h"
 #include "row_base.h"
 #include <dbprove/common/storage_variant.h>
 
+#include <chrono>
+#include <exception>
 #include <memory>
 #include <span>
 #include <string>
@@ -19,6 +22,27 @@ class Plan;
 }
 
 namespace sql {
+/**
+ * A query plan together with what the server measured while executing the query to produce it
+ */
+struct MeasuredPlan {
+  std::unique_ptr<explain::Plan> plan;
+  /// Server measured execution time, nullopt if the plan did not come from executing the query (e.g. a cached artefact)
+  std::optional<std::chrono::microseconds> execution_time;
+  /// Rows returned by the plan root, nullopt under the same conditions as `execution_time`
+  std::optional<RowCount> rows;
+};
+
+/**
+ * Outcome of one statement sent with `ConnectionBase::executeBatch`
+ */
+struct BatchResult {
+  /// Rows returned by the statement, with no columns for statements that return none. nullptr if it failed
+  std::unique_ptr<ResultBase> result;
+  /// Why the statement failed, nullptr if it succeeded
+  std::exception_ptr error;
+};
+
 void setArtifactReplayMode(bool enabled);
 bool artifactReplayModeEnabled();
 
@@ -46,6 +70,20 @@ public:
    */
   virtual std::string version() { return ""; };
 
+  /**
+   * @brief Round-trip to the engine, opening the session if it is not open yet
+   * @throw If the engine cannot be reached
+   * @note The default runs `SELECT 1`
+   */
+  virtual void ping();
+
+  /**
+   * @brief Put the session back to its state after connecting before a pooled connection is handed out again
+   * @throw If the session cannot be reset, the pool then discards the connection
+   * @note The default only clears the query timeout. Drivers whose engine can reset `SET` state override this
+   */
+  virtual void resetSession() { setQueryTimeout(std::nullopt); }
+
   /// @brief Run statement and return
   virtual void execute(std::string_view statement) = 0;
   /// @brief Fetches a single result from the database.
@@ -57,11 +95,34 @@ public:
   /// @throw If the statement doesn't return a single row with a single column.
   virtual SqlVariant fetchScalar(std::string_view statement);
 
+  /**
+   * @brief Run independent statements, sending as many as the engine allows before waiting for their results.
+   *
+   * A failing statement does not stop the ones after it. Every entry must be a single statement.
+   * @return One entry per statement, in the same order
+   * @note The default runs the statements one after the other with `fetchAll`, reading each result into memory
+   * before the next statement starts
+   */
+  virtual std::vector<BatchResult> executeBatch(std::span<const std::string_view> statements);
+
+  /**
+   * @brief Parse the statement once so it can be executed repeatedly without sending and parsing the text again
+   * @note The default re-sends the text on every execution and reports `ExecutionMode::Text`
+   */
+  virtual std::unique_ptr<PreparedStatement> prepare(std::string_view statement);
+
   /**
    * @brief Run the query, discarding results and returning the query plan
    */
   virtual std::unique_ptr<explain::Plan> explain(std::string_view statement, std::optional<std::string_view> name = std::nullopt);
 
+  /**
+   * @brief Explain the statement and, for engines whose explain executes the query, also return the server
+   * measured execution time and root row count, so the caller does not need to run the query a second time.
+   * @note Plans are only measured on engines that return a `measuredExplainFormat`
+   */
+  MeasuredPlan explainAndMeasure(std::string_view statement, std::optional<std::string_view> name = std::nullopt);
+
   /** @brief If bulk load API is available, use that to load file.
    * @note If no bulk load API is available, the implementation must fall back to INSERT
    * and read the file manually
@@ -154,22 +215,31 @@ public:
   std::string mapTypes(std::string_view statement) const;
 
   /**
-   * @brief Get the artefact from the file system.
+   * @brief Get the artefact from the engine's artefact pack, or a loose file written by an older version.
    * @param name Base name of the artefact
    * @param extension Extension to look for (with or without the dot)
-   * @return The contents of the artefact if it exists, nullopt otherwise.
+   * @return View of the artefact, valid for the rest of the process, if it exists, nullopt otherwise.
    */
-  std::optional<std::string> getArtefact(std::string_view name, std::string_view extension) const;
+  std::optional<std::string_view> getArtefact(std::string_view name, std::string_view extension) const;
 
   /**
-   * @brief Store the artefact on the file system.
+   * @brief Store the artefact in the engine's artefact pack.
    * @param name Base name of the artefact
    * @param extension Extension to use (with or without the dot)
    * @param content The content of the artefact to store.
    */
   void storeArtefact(std::string_view name, std::string_view extension, std::string_view content) const;
 
+  /// @brief Directory artefacts are read from and written to, if any
+  [[nodiscard]] const std::optional<std::string>& artifactsPath() const { return artifacts_path_; }
+
 protected:
+  /**
+   * @brief Artefact format `explain` caches plans in, for engines whose explain executes the statement and fills in
+   * `execution_time` (milliseconds) and actual row counts. A plan served from that cache was not executed now.
+   * @note The default is nothing, so `explainAndMeasure` does not measure
+   */
+  [[nodiscard]] virtual std::optional<std::string_view> measuredExplainFormat() const { return std::nullopt; }
   const std::optional<std::string> artifacts_path_;
   std::optional<uint32_t> query_timeout_seconds_;
   static void validateSourcePaths(const std::vector<std::filesystem::path>& source_paths);
@@ -2,11 +2,14 @@
 #include "connection_base.h"
 #include "engine.h"
 #include "credential.h"
+#include "connection_lease.h"
 #include <atomic>
+#include <memory>
 
 
 namespace sql {
 class ConnectionBase;
+class ConnectionPool;
 
 /// @brief Factory class for creating connections using a specific engine
 /// New driver implementors of engines must extend this factory class and the `Engine` enum
@@ -15,6 +18,7 @@ class ConnectionFactory {
   const Engine engine_;
   const std::optional<std::string> artifacts_path_;
   std::atomic<size_t> connectionCount_{0};
+  std::shared_ptr<ConnectionPool> pool_;
 
 public:
   ConnectionFactory(const Engine& engine, const Credential& credential,
@@ -28,12 +32,32 @@ public:
     : credential_(other.credential_)
     , engine_(other.engine_)
     , artifacts_path_(other.artifacts_path_)
-    , connectionCount_(other.connectionCount_.load()) {
+    , connectionCount_(other.connectionCount_.load())
+    , pool_(other.pool_) {
   }
 
   ConnectionFactory() : credential_(CredentialNone()), engine_(Engine::Type::Utopia) {}
 
+  /// @brief A new connection, never pooled
   std::unique_ptr<ConnectionBase> create();
+
+  /**
+   * @brief Hand out connections from a pool of at most `max_size`, shared with every factory for the same
+   * engine, credential and artefact directory that enables pooling
+   */
+  void enablePooling(size_t max_size);
+
+  /// @brief A connection from the pool if pooling is enabled, otherwise a new connection closed when the lease ends
+  ConnectionLease acquire();
+
+  /// @brief Open `count` pooled connections ahead of a concurrent run. Does nothing without pooling
+  void prewarm(size_t count);
+
+  /// @brief The pool, nullptr if pooling is not enabled
+  [[nodiscard]] const ConnectionPool* pool() const { return pool_.get(); }
+
   const Engine& engine() const { return engine_; }
+  const Credential& credential() const { return credential_; }
+  const std::optional<std::string>& artifactsPath() const { return artifacts_path_; }
 };
 } // namespace sql
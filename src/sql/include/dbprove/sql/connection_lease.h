@@ -0,0 +1,32 @@
+#pragma once
+#include <memory>
+
+namespace sql {
+class ConnectionBase;
+class ConnectionPool;
+
+/**
+ * A connection handed out by `ConnectionFactory::acquire`.
+ *
+ * When the lease ends, a pooled connection goes back to its pool. An unpooled one is closed.
+ */
+class ConnectionLease {
+  std::unique_ptr<ConnectionBase> connection_;
+  std::shared_ptr<ConnectionPool> pool_;
+
+public:
+  ConnectionLease(std::unique_ptr<ConnectionBase> connection, std::shared_ptr<ConnectionPool> pool);
+  ~ConnectionLease();
+  ConnectionLease(ConnectionLease&& other) noexcept;
+  ConnectionLease& operator=(ConnectionLease&& other) noexcept;
+  ConnectionLease(const ConnectionLease&) = delete;
+  ConnectionLease& operator=(const ConnectionLease&) = delete;
+
+  [[nodiscard]] ConnectionBase* get() const { return connection_.get(); }
+  ConnectionBase* operator->() const { return connection_.get(); }
+  ConnectionBase& operator*() const { return *connection_; }
+
+private:
+  void release();
+};
+}
@@ -0,0 +1,84 @@
+#pragma once
+#include "connection_factory.h"
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace sql {
+/**
+ * Bounded pool of open connections to one engine with one credential.
+ *
+ * Factories with the same engine, credential and artefact directory share a pool, see `shared`.
+ * A connection that has been idle for a while is pinged before it is handed out again, and every returned
+ * connection has its session reset with `ConnectionBase::resetSession`. PostgreSQL runs `RESET ALL` and MariaDB
+ * `mysql_reset_connection`. Other engines only clear the query timeout, so there settings changed with `SET` carry
+ * over to the next lease. A connection that fails its reset is discarded.
+ */
+class ConnectionPool : public std::enable_shared_from_this<ConnectionPool> {
+public:
+  struct Metrics {
+    /// Connections opened by the pool
+    size_t connects = 0;
+    /// Time spent opening them, including the first round-trip
+    std::chrono::microseconds connect_time{0};
+    size_t acquires = 0;
+    /// Acquires that found every connection leased and had to wait for one
+    size_t waits = 0;
+    /// Acquires waiting right now
+    size_t waiting = 0;
+    std::chrono::microseconds acquire_wait{0};
+    std::chrono::microseconds max_acquire_wait{0};
+    /// Idle connections dropped because they failed their health check or reset
+    size_t discarded = 0;
+  };
+
+  /// @brief Idle connections younger than this are handed out without a health check
+  static constexpr std::chrono::seconds health_check_after{1};
+
+  ConnectionPool(const ConnectionFactory& factory, size_t max_size);
+  ~ConnectionPool();
+  ConnectionPool(const ConnectionPool&) = delete;
+  ConnectionPool& operator=(const ConnectionPool&) = delete;
+
+  /**
+   * @brief The live pool for the engine, credential and artefact directory of `factory`, created if there is none
+   * @param max_size Bound of a new pool. An existing pool is grown to it if smaller
+   */
+  static std::shared_ptr<ConnectionPool> shared(const ConnectionFactory& factory, size_t max_size);
+
+  /// @brief Lease a connection, waiting for one to come back if `maxSize` are leased already
+  ConnectionLease acquire();
+
+  /**
+   * @brief Open connections until `count` are open, so a concurrent run does not pay for connecting.
+   *
+   * The pool is grown to `count` if it is smaller, because the run will lease that many at the same time.
+   */
+  void prewarm(size_t count);
+
+  [[nodiscard]] Metrics metrics() const;
+  [[nodiscard]] size_t maxSize() const;
+
+private:
+  friend class ConnectionLease;
+  struct Idle {
+    std::unique_ptr<ConnectionBase> connection;
+    std::chrono::steady_clock::time_point since;
+  };
+
+  std::unique_ptr<ConnectionBase> connect();
+  void release(std::unique_ptr<ConnectionBase> connection);
+  void grow(size_t max_size);
+
+  ConnectionFactory factory_;
+  size_t max_size_;
+  mutable std::mutex mutex_;
+  std::condition_variable released_;
+  std::vector<Idle> idle_;
+  /// Idle and leased connections, plus connections being opened
+  size_t open_ = 0;
+  Metrics metrics_;
+};
+}
@@ -103,6 +103,12 @@ public:
    */
   [[nodiscard]] bool needsLocalFile() const;
 
+  /**
+   * @brief Can several connections to this engine work on the same database at the same time?
+   * @return False for embedded engines where a second session would contend for the same file or process state.
+   */
+  [[nodiscard]] bool supportsConcurrentSessions() const;
+
   Credential parseCredentials(
       const std::string& host,
       uint16_t port,
@@ -67,6 +67,7 @@ public:
    * @return true if we could
    */
   bool canEstimate() const;
+  /// Server reported times in milliseconds, 0 if the engine does not report them
   double planning_time = 0.0;
   double execution_time = 0.0;
 
@@ -106,7 +107,12 @@ public:
   /**
    * Execute actuals SQL and update node row counts.
    * This is best-effort: query failures are ignored and remaining nodes continue.
+   *
+   * Identical subtrees are counted once. Counts are cached as artefacts keyed by engine, dataset and
+   * SQL hash, so re-runs only count what is not known yet.
+   * @param connection Connection used for counting and the template for any extra connections
+   * @param max_connections Upper bound on concurrent counting sessions, including `connection`
    */
-  void fixActuals(sql::ConnectionBase& connection);
+  void fixActuals(sql::ConnectionBase& connection, size_t max_connections = 1);
 };
 }
@@ -0,0 +1,33 @@
+#pragma once
+#include "result_base.h"
+#include <magic_enum/magic_enum.hpp>
+#include <memory>
+#include <string_view>
+
+namespace sql {
+/**
+ * How a statement is sent to the engine
+ */
+enum class ExecutionMode {
+  /// Full SQL text on every execution, so the engine parses and plans each time
+  Text,
+  /// Parsed once by the engine, then executed by handle
+  Prepared
+};
+
+inline std::string_view to_string(const ExecutionMode mode) { return magic_enum::enum_name(mode); }
+
+/**
+ * A statement parsed once and executed any number of times on the connection that made it.
+ *
+ * Must not outlive that connection, and only one result from it may be open at a time.
+ */
+class PreparedStatement {
+public:
+  virtual ~PreparedStatement() = default;
+  /// @brief Execute the statement and return its result
+  virtual std::unique_ptr<ResultBase> fetchAll() = 0;
+  /// @brief `Text` when the engine has no prepare and every execution re-sends the SQL
+  [[nodiscard]] virtual ExecutionMode mode() const = 0;
+};
+}
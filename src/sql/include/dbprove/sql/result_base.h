@@ -1,5 +1,6 @@
 #pragma once
 #include <memory>
+#include "column_batch.h"
 #include "row_iterator.h"
 #include "row_base.h"
 
@@ -33,7 +34,28 @@ public:
    * the rowCount is not available until all rows have been spooled
    */
   void drain();
+  /// @brief Render every row, followed by the number of rows read
   std::string dump();
+
+  /**
+   * @brief Read the remaining rows into memory, so the connection is free for the next statement
+   * @return A result holding those rows. This result is drained
+   */
+  std::unique_ptr<ResultBase> materialise();
+
+  /**
+   * @brief Fetch up to `max_rows` of the remaining rows column by column.
+   *
+   * Drivers with a columnar wire format override this to copy values without building a `SqlVariant` per
+   * cell. The default implementation goes through `nextRow`. A result is consumed either row by row or
+   * batch by batch; mixing the two on the same result is not supported.
+   * @param batch Filled with the rows. Reuse it across calls to keep its buffers
+   * @param max_rows Upper bound on rows in the batch. Drivers may return fewer
+   * @return false once the result is exhausted and `batch` is empty
+   */
+  virtual bool nextBatch(ColumnBatch& batch, size_t max_rows = DEFAULT_BATCH_ROWS);
+
+  static constexpr size_t DEFAULT_BATCH_ROWS = 2048;
 protected:
   /// @brief return the next row or nullptr if no more rows
   virtual const RowBase& nextRow() = 0;
@@ -47,6 +69,35 @@ protected:
 };
 
 
+/**
+ * Rows held in memory, made by `ResultBase::materialise`
+ */
+class MaterialisedResult final : public ResultBase {
+  std::vector<std::unique_ptr<MaterialisedRow>> rows_;
+  ColumnCount column_count_;
+  size_t next_row_ = 0;
+
+public:
+  MaterialisedResult(std::vector<std::unique_ptr<MaterialisedRow>> rows, ColumnCount column_count,
+                     std::vector<SqlTypeKind> column_types);
+
+  RowCount rowCount() const override {
+    return rows_.size();
+  }
+
+  ColumnCount columnCount() const override {
+    return column_count_;
+  }
+
+protected:
+  const RowBase& nextRow() override;
+
+  void reset() override {
+    next_row_ = 0;
+  }
+};
+
+
 /// @brief Sentinel to mark end of row iteration
 class SentinelResult final : public ResultBase {
 protected:
@@ -207,6 +207,16 @@ public:
   }
 };
 
+/**
+ * Artifact replay mode needs an artefact that was never stored
+ */
+class MissingArtefactException final : public std::runtime_error {
+public:
+  explicit MissingArtefactException(const std::string& path)
+    : std::runtime_error("Missing required artifact: " + path) {
+  }
+};
+
 class InvalidColumnsException final : public Exception {
 public:
   explicit InvalidColumnsException(const std::string& error, const std::string_view statement)
@@ -1,29 +1,71 @@
 #include "connection.h"
 #include "result.h"
 #include "sql_exceptions.h"
+#include "stream.h"
+#include <dbprove/common/table_data_conventions.h>
 #include <mysql/mysql.h>
+#include <plog/Log.h>
+
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <thread>
 
 
 namespace sql::mariadb {
+namespace {
+constexpr size_t max_load_sessions = 4;
+
+struct LoadStats {
+  uint64_t bytes = 0;
+  uint64_t rows = 0;
+};
+
+double secondsSince(const std::chrono::steady_clock::time_point start) {
+  return std::max(std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count(), 1e-6);
+}
+}
+
 class Connection::Pimpl {
 public:
+  Connection& connection;
   CredentialPassword credential;
   Engine engine;
   MYSQL* conn;
+  /// Result still reading from `conn`, it must be finished before the next statement
+  std::weak_ptr<Stream> open_stream;
 
-  explicit Pimpl(CredentialPassword credential, Engine engine)
-    : credential(credential)
+  explicit Pimpl(Connection& connection, CredentialPassword credential, Engine engine)
+    : connection(connection)
+    , credential(credential)
     , engine(engine) {
-    conn = mysql_init(nullptr);
-    if (!conn) {
+    conn = connect();
+  }
+
+  /**
+   * @brief Open a new session with this connection's credential. The caller owns the result
+   * @param local_infile Let the session read client files with LOAD DATA LOCAL INFILE. Only bulk load sessions do
+   */
+  [[nodiscard]] MYSQL* connect(const bool local_infile = false) const {
+    MYSQL* session = mysql_init(nullptr);
+    if (!session) {
       throw std::runtime_error("Failed to initialize construct MySQL connection");
     }
-    if (!mysql_real_connect(conn, credential.host.c_str(), credential.username.c_str(),
+    if (local_infile) {
+      constexpr unsigned int enable = 1;
+      mysql_options(session, MYSQL_OPT_LOCAL_INFILE, &enable);
+    }
+#ifdef DBPROVE_MARIADB_NONBLOCK
+    mysql_options(session, MYSQL_OPT_NONBLOCK, nullptr);
+#endif
+    if (!mysql_real_connect(session, credential.host.c_str(), credential.username.c_str(),
                             credential.password.value_or("").c_str(), credential.database.c_str(), credential.port,
                             nullptr, 0)) {
-      std::string error_msg = mysql_error(conn);
+      std::string error_msg = mysql_error(session);
+      mysql_close(session);
       throw ConnectionException(credential, error_msg);
     }
+    return session;
   }
 
   void check_connection_not_closed() {
@@ -33,11 +75,15 @@ public:
   }
 
   void check_error(int error) {
+    check_error(error, conn);
+  }
+
+  static void check_error(int error, MYSQL* session) {
     if (error == 0) {
       return;
     }
-    const std::string error_msg = mysql_error(conn);
-    const auto error_code = mysql_errno(conn);
+    const std::string error_msg = mysql_error(session);
+    const auto error_code = mysql_errno(session);
     switch (error_code) {
       // TODO: Fill this in
       default:
@@ -45,8 +91,51 @@ public:
     }
   }
 
+  /// @brief Give the connection back from a result that is still being read, keeping its rows readable
+  void finishOpenStream() {
+    if (const auto stream = open_stream.lock()) {
+      PLOGD << "Statement sent before the previous result was read, buffering the rest of it";
+      stream->spill();
+    }
+    open_stream.reset();
+  }
+
+  /// @brief Deadline of a statement starting now, if the connection has a query timeout
+  std::optional<Deadline> deadline() const {
+    const auto timeout_seconds = connection.queryTimeoutSeconds();
+    if (!timeout_seconds.has_value()) {
+      return std::nullopt;
+    }
+    return Deadline{
+        .at = std::chrono::steady_clock::now() + std::chrono::seconds(*timeout_seconds),
+        .timeout_seconds = *timeout_seconds,
+        .cancel = [this, thread_id = mysql_thread_id(conn)] { killQuery(thread_id); }
+    };
+  }
+
+  /// @brief Stop the statement running on another session. The session itself stays open
+  void killQuery(const unsigned long thread_id) const {
+    try {
+      MYSQL* session = connect();
+      if (mysql_query(session, ("KILL QUERY " + std::to_string(thread_id)).c_str()) != 0) {
+        PLOGW << "Failed to cancel MySQL query on thread " << thread_id << ": " << mysql_error(session);
+      }
+      mysql_close(session);
+    } catch (const std::exception& e) {
+      PLOGW << "Failed to cancel MySQL query on thread " << thread_id << ": " << e.what();
+    }
+  }
+
+  /// @brief Put session and user variables back to their defaults and drop temporary tables, keeping the session
+  void resetSession() {
+    check_connection_not_closed();
+    finishOpenStream();
+    check_error(mysql_reset_connection(conn));
+  }
+
   void executeRaw(const std::string_view statement) {
     check_connection_not_closed();
+    finishOpenStream();
     if (mysql_query(conn, statement.data())) {
       std::string error_msg = mysql_error(conn);
     }
@@ -54,16 +143,102 @@ public:
 
   std::unique_ptr<Result> execute(const std::string_view statement) {
     check_connection_not_closed();
-    check_error(mysql_query(conn, statement.data()));
+    finishOpenStream();
+    auto statement_deadline = deadline();
+    check_error(realQuery(conn, statement, statement_deadline));
 
-    auto result = mysql_store_result(conn);
+    // Rows are read as the caller asks for them instead of buffering the whole result first
+    auto result = mysql_use_result(conn);
     if (!result) {
       check_error(1);
     }
-    return std::make_unique<Result>(result);
+    auto stream = std::make_shared<Stream>(conn, result, std::move(statement_deadline));
+    open_stream = stream;
+    return std::make_unique<Result>(std::move(stream));
+  }
+
+  static void query(MYSQL* session, const std::string_view statement) {
+    check_error(mysql_real_query(session, statement.data(), statement.size()), session);
+  }
+
+  static std::string quoteLiteral(MYSQL* session, const std::string_view value) {
+    std::string escaped(value.size() * 2 + 1, '\0');
+    escaped.resize(mysql_real_escape_string(session, escaped.data(), value.data(), value.size()));
+    return "'" + escaped + "'";
+  }
+
+  /// @brief Column names of `table` in declaration order
+  std::vector<std::string> tableColumns(const std::string_view table) {
+    check_connection_not_closed();
+    finishOpenStream();
+    const auto [schema_name, table_name] = dbprove::common::splitQualifiedTableName(table);
+    const auto schema = schema_name.empty() ? std::string("DATABASE()") : quoteLiteral(conn, schema_name);
+    query(conn, "SELECT COLUMN_NAME FROM information_schema.COLUMNS"
+                " WHERE TABLE_SCHEMA = " + schema + " AND TABLE_NAME = " + quoteLiteral(conn, table_name) +
+                " ORDER BY ORDINAL_POSITION");
+    MYSQL_RES* result = mysql_store_result(conn);
+    if (!result) {
+      check_error(1);
+    }
+    std::vector<std::string> columns;
+    while (const MYSQL_ROW row = mysql_fetch_row(result)) {
+      columns.emplace_back(row[0]);
+    }
+    mysql_free_result(result);
+    if (columns.empty()) {
+      throw InvalidObjectException("Cannot bulk load into " + std::string(table) + ", the table does not exist");
+    }
+    return columns;
+  }
+
+  /**
+   * @brief LOAD DATA statement for one of the pipe separated files staged by the generator.
+   *
+   * Fields are read into user variables first, so the empty fields the generator writes for NULL become NULL
+   * instead of empty strings and zeros.
+   */
+  static std::string loadStatement(MYSQL* session, const std::string_view table,
+                                   const std::vector<std::string>& columns, const std::filesystem::path& path) {
+    std::string variables;
+    std::string assignments;
+    for (size_t i = 0; i < columns.size(); ++i) {
+      const auto variable = "@c" + std::to_string(i);
+      variables += (i == 0 ? "" : ", ") + variable;
+      assignments += (i == 0 ? "" : ", ") + ("`" + columns[i] + "` = NULLIF(" + variable + ", '')");
+    }
+    return "LOAD DATA LOCAL INFILE " + quoteLiteral(session, path.string()) + " INTO TABLE " + std::string(table) +
+           " CHARACTER SET utf8mb4"
+           " FIELDS TERMINATED BY '|' OPTIONALLY ENCLOSED BY '\"' ESCAPED BY ''"
+           " LINES TERMINATED BY '\\n'"
+           " IGNORE 1 LINES"
+           " (" + variables + ") SET " + assignments;
+  }
+
+  static LoadStats loadFile(MYSQL* session, const std::string_view table, const std::vector<std::string>& columns,
+                            const std::filesystem::path& path) {
+    const auto start = std::chrono::steady_clock::now();
+    query(session, loadStatement(session, table, columns, path));
+
+    const LoadStats stats{.bytes = std::filesystem::file_size(path), .rows = mysql_affected_rows(session)};
+    if (const auto warnings = mysql_warning_count(session); warnings > 0) {
+      PLOGW << "Loading " << path.string() << " into " << table << " raised " << warnings << " warnings";
+    }
+    const auto seconds = secondsSince(start);
+    const auto mb = static_cast<double>(stats.bytes) / (1024.0 * 1024.0);
+    PLOGI << "Loaded " << path.filename().string() << " into " << table << ": " << stats.rows << " rows, " << mb
+        << " MB in " << seconds << " s (" << mb / seconds << " MB/s)";
+    return stats;
+  }
+
+  /// @brief Skip per row uniqueness and foreign key checks on a session that only loads trusted data
+  static void prepareLoadSession(MYSQL* session) {
+    query(session, "SET SESSION unique_checks = 0, foreign_key_checks = 0");
   }
 
   void close() {
+    if (const auto stream = open_stream.lock()) {
+      stream->abandon();
+    }
     if (conn) {
       mysql_close(conn);
       conn = nullptr;
@@ -77,7 +252,7 @@ public:
 
 Connection::Connection(const Credential& credential, const Engine& engine, std::optional<std::string> artifacts_path)
   : ConnectionBase(credential, engine, std::move(artifacts_path))
-  , impl_(std::make_unique<Pimpl>(std::get<CredentialPassword>(credential), engine)) {
+  , impl_(std::make_unique<Pimpl>(*this, std::get<CredentialPassword>(credential), engine)) {
 }
 
 Connection::~Connection() {
@@ -93,6 +268,88 @@ std::unique_ptr<ResultBase> Connection::fetchAll(const std::string_view statemen
 
 void Connection::bulkLoad(const std::string_view table, const std::vector<std::filesystem::path> source_paths) {
   validateSourcePaths(source_paths);
+  impl_->check_connection_not_closed();
+  const auto columns = impl_->tableColumns(table);
+
+  // Files are loaded on dedicated sessions, the only ones allowed to read client files. Tables staged as several
+  // files are fanned out over several of them, each claiming the next file
+  const auto session_count = std::min(source_paths.size(), max_load_sessions);
+  std::vector<MYSQL*> sessions;
+  std::vector<std::thread> workers;
+  std::atomic<size_t> next_file{0};
+  std::atomic<uint64_t> total_bytes{0};
+  std::atomic<uint64_t> total_rows{0};
+  std::mutex error_mutex;
+  std::exception_ptr first_error;
+
+  const auto worker = [&](MYSQL* session) {
+    try {
+      Pimpl::prepareLoadSession(session);
+      for (auto i = next_file.fetch_add(1); i < source_paths.size(); i = next_file.fetch_add(1)) {
+        const auto stats = Pimpl::loadFile(session, table, columns, source_paths[i]);
+        total_bytes += stats.bytes;
+        total_rows += stats.rows;
+      }
+    } catch (...) {
+      std::lock_guard lock(error_mutex);
+      if (!first_error) {
+        first_error = std::current_exception();
+      }
+      next_file = source_paths.size();
+    }
+  };
+
+  const auto start = std::chrono::steady_clock::now();
+  sessions.push_back(impl_->connect(true));
+  try {
+    while (sessions.size() < session_count) {
+      sessions.push_back(impl_->connect(true));
+    }
+  } catch (const std::exception& e) {
+    PLOGW << "Loading " << table << " on " << sessions.size() << " sessions, could not open more: " << e.what();
+  }
+  try {
+    // Non-unique indexes are rebuilt once at the end instead of maintained row by row. InnoDB ignores this
+    Pimpl::query(impl_->conn, "ALTER TABLE " + std::string(table) + " DISABLE KEYS");
+  } catch (...) {
+    for (auto* session : sessions) {
+      mysql_close(session);
+    }
+    throw;
+  }
+  for (size_t i = 1; i < sessions.size(); ++i) {
+    workers.emplace_back(worker, sessions[i]);
+  }
+  worker(sessions.front());
+  for (auto& w : workers) {
+    w.join();
+  }
+  for (auto* session : sessions) {
+    mysql_close(session);
+  }
+  try {
+    const auto rebuild_start = std::chrono::steady_clock::now();
+    Pimpl::query(impl_->conn, "ALTER TABLE " + std::string(table) + " ENABLE KEYS");
+    PLOGD << "Rebuilt keys of " << table << " in " << secondsSince(rebuild_start) << " s";
+  } catch (...) {
+    if (!first_error) {
+      throw;
+    }
+  }
+  if (first_error) {
+    std::rethrow_exception(first_error);
+  }
+
+  const auto seconds = secondsSince(start);
+  const auto mb = static_cast<double>(total_bytes) / (1024.0 * 1024.0);
+  PLOGI << "Loaded " << table << ": " << total_rows << " rows, " << mb << " MB in " << seconds << " s ("
+      << mb / seconds << " MB/s, " << static_cast<double>(total_rows) / seconds << " rows/s) over "
+      << sessions.size() << " sessions";
+}
+
+void Connection::resetSession() {
+  ConnectionBase::resetSession();
+  impl_->resetSession();
 }
 
 void Connection::close() {
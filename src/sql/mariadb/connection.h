@@ -13,6 +13,7 @@ public:
   void execute(std::string_view statement) override;
   std::unique_ptr<ResultBase> fetchAll(std::string_view statement) override;
   void bulkLoad(const std::string_view table, const std::vector<std::filesystem::path> source_paths) override;
+  void resetSession() override;
   void close() override;
 };
 }
\ No newline at end of file
@@ -4,6 +4,7 @@
 
 #include "row.h"
 #include "sql_exceptions.h"
+#include "stream.h"
 #include <duckdb.hpp>
 #include <mysql/mysql.h>
 
@@ -11,30 +12,24 @@
 namespace sql::mariadb {
 class Result::Pimpl {
 public:
-  MYSQL_RES* result_;
+  std::shared_ptr<Stream> stream_;
   const ColumnCount columnCount_;
-  const RowCount rowCount_;
   std::unique_ptr<Row> currentRow_;
-  MYSQL_ROW currentRowData;
 
-  explicit Pimpl(void* handle, Result* result)
-    : result_(static_cast<MYSQL_RES*>(handle))
-    , columnCount_(mysql_num_fields(result_))
-    , rowCount_(mysql_num_rows(result_))
+  explicit Pimpl(std::shared_ptr<Stream> stream, Result* result)
+    : stream_(std::move(stream))
+    , columnCount_(mysql_num_fields(stream_->result()))
     , currentRow_(std::make_unique<Row>(result)) {
   }
-
-  ~Pimpl() {
-    mysql_free_result(result_);
-  };
 };
 
 const char* Result::columnData(const size_t index) const {
-  return impl_->currentRowData[index];
+  // Ask the stream every time, it moves the row out of the result when another statement needs the connection
+  return impl_->stream_->current()[index];
 }
 
-Result::Result(void* mysql_result)
-  : impl_(std::make_unique<Pimpl>(mysql_result, this)) {
+Result::Result(std::shared_ptr<Stream> stream)
+  : impl_(std::make_unique<Pimpl>(std::move(stream), this)) {
   const static std::map<enum_field_types, SqlTypeKind> type_map = {
       {MYSQL_TYPE_SHORT, SqlTypeKind::SMALLINT},
       {MYSQL_TYPE_LONG, SqlTypeKind::INT},
@@ -46,7 +41,7 @@ Result::Result(void* mysql_result)
       {MYSQL_TYPE_DECIMAL, SqlTypeKind::DECIMAL}
   };
 
-  const MYSQL_FIELD* fields = mysql_fetch_fields(impl_->result_);
+  const MYSQL_FIELD* fields = mysql_fetch_fields(impl_->stream_->result());
   for (size_t i = 0; i < columnCount(); ++i) {
     auto mysql_type = fields[i].type;
     if (!type_map.contains(mysql_type)) {
@@ -57,7 +52,7 @@ Result::Result(void* mysql_result)
 }
 
 RowCount Result::rowCount() const {
-  return impl_->rowCount_;
+  return currentRowIndex_;
 }
 
 ColumnCount Result::columnCount() const {
@@ -68,11 +63,10 @@ Result::~Result() {
 }
 
 const RowBase& Result::nextRow() {
-  if (currentRowIndex_ >= rowCount()) {
+  if (!impl_->stream_->next()) {
     return SentinelRow::instance();
   }
-  impl_->currentRowData = mysql_fetch_row(impl_->result_);
   ++currentRowIndex_;
   return *impl_->currentRow_;
 }
-}
+}
\ No newline at end of file
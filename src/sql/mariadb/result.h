@@ -5,7 +5,13 @@
 
 namespace sql::mariadb {
 class Row;
+class Stream;
 
+/**
+ * Result streamed from the server one row at a time.
+ *
+ * `rowCount()` counts the rows returned so far and is only final after `drain()`.
+ */
 class Result final : public ResultBase {
   friend class Row;
   class Pimpl;
@@ -15,7 +21,7 @@ class Result final : public ResultBase {
   const char* columnData(size_t index) const;
 
 public:
-  explicit Result(void* mysql_result);
+  explicit Result(std::shared_ptr<Stream> stream);
   RowCount rowCount() const override;
   ColumnCount columnCount() const override;
   ~Result() override;
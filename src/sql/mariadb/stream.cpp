@@ -0,0 +1,200 @@
+#include "stream.h"
+#include "sql_exceptions.h"
+
+#include <cerrno>
+#include <stdexcept>
+
+#ifdef DBPROVE_MARIADB_NONBLOCK
+#include <poll.h>
+#endif
+
+namespace sql::mariadb {
+namespace {
+[[noreturn]] void throwTimeout(const Deadline& deadline) {
+  throw std::runtime_error("Query timed out after " + std::to_string(deadline.timeout_seconds) + " seconds");
+}
+
+#ifdef DBPROVE_MARIADB_NONBLOCK
+/**
+ * Wait for what a non-blocking call asked for in `status`.
+ *
+ * Once the deadline passes the statement is cancelled and the wait goes on, so the call can finish and leave the
+ * connection usable.
+ * @return The events that are ready, to pass on to the `_cont` call
+ */
+int waitForSocket(MYSQL* conn, const int status, const std::optional<Deadline>& deadline, bool& timed_out) {
+  pollfd pfd{.fd = mysql_get_socket(conn), .events = 0, .revents = 0};
+  if (status & MYSQL_WAIT_READ) {
+    pfd.events |= POLLIN;
+  }
+  if (status & MYSQL_WAIT_WRITE) {
+    pfd.events |= POLLOUT;
+  }
+  if (status & MYSQL_WAIT_EXCEPT) {
+    pfd.events |= POLLPRI;
+  }
+
+  while (true) {
+    int timeout_ms = (status & MYSQL_WAIT_TIMEOUT) ? static_cast<int>(mysql_get_timeout_value_ms(conn)) : -1;
+    bool deadline_bound = false;
+    if (deadline.has_value() && !timed_out) {
+      const auto remaining = std::chrono::duration_cast<std::chrono::milliseconds>(
+          deadline->at - std::chrono::steady_clock::now()).count();
+      const auto remaining_ms = static_cast<int>(std::max<decltype(remaining)>(remaining, 0));
+      if (timeout_ms < 0 || remaining_ms < timeout_ms) {
+        timeout_ms = remaining_ms;
+        deadline_bound = true;
+      }
+    }
+
+    const int ready = poll(&pfd, 1, timeout_ms);
+    if (ready < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      throw std::runtime_error("Failed waiting on the MySQL socket");
+    }
+    if (ready > 0) {
+      int events = 0;
+      if (pfd.revents & (POLLIN | POLLHUP | POLLERR)) {
+        events |= MYSQL_WAIT_READ;
+      }
+      if (pfd.revents & POLLOUT) {
+        events |= MYSQL_WAIT_WRITE;
+      }
+      if (pfd.revents & POLLPRI) {
+        events |= MYSQL_WAIT_EXCEPT;
+      }
+      return events;
+    }
+    if (!deadline_bound) {
+      return MYSQL_WAIT_TIMEOUT;
+    }
+    timed_out = true;
+    deadline->cancel();
+  }
+}
+
+/// @brief Drive a `_start`/`_cont` pair to completion
+template <typename T, typename Start, typename Continue>
+T runNonBlocking(MYSQL* conn, const std::optional<Deadline>& deadline, Start start, Continue resume) {
+  T value{};
+  bool timed_out = false;
+  int status = start(&value);
+  while (status != 0) {
+    status = resume(&value, waitForSocket(conn, status, deadline, timed_out));
+  }
+  if (timed_out) {
+    throwTimeout(*deadline);
+  }
+  return value;
+}
+#endif
+}
+
+int realQuery(MYSQL* conn, const std::string_view statement, const std::optional<Deadline>& deadline) {
+#ifdef DBPROVE_MARIADB_NONBLOCK
+  return runNonBlocking<int>(
+      conn, deadline,
+      [&](int* ret) { return mysql_real_query_start(ret, conn, statement.data(), statement.size()); },
+      [&](int* ret, const int ready) { return mysql_real_query_cont(ret, conn, ready); });
+#else
+  return mysql_real_query(conn, statement.data(), statement.size());
+#endif
+}
+
+Stream::Stream(MYSQL* conn, MYSQL_RES* result, std::optional<Deadline> deadline)
+  : conn_(conn)
+  , result_(result)
+  , deadline_(std::move(deadline)) {
+}
+
+Stream::~Stream() {
+  abandon();
+}
+
+MYSQL_ROW Stream::fetch() {
+#ifdef DBPROVE_MARIADB_NONBLOCK
+  const auto row = runNonBlocking<MYSQL_ROW>(
+      conn_, deadline_,
+      [&](MYSQL_ROW* ret) { return mysql_fetch_row_start(ret, result_); },
+      [&](MYSQL_ROW* ret, const int ready) { return mysql_fetch_row_cont(ret, result_, ready); });
+#else
+  const auto row = mysql_fetch_row(result_);
+#endif
+  if (row == nullptr && mysql_errno(conn_) != 0) {
+    throw Exception(SqlState::INVALID, std::string(mysql_error(conn_)));
+  }
+  return row;
+}
+
+void Stream::holdCurrent(std::vector<std::optional<std::string>> row) {
+  spilled_row_ = std::move(row);
+  spilled_pointers_.resize(spilled_row_.size());
+  for (size_t i = 0; i < spilled_row_.size(); ++i) {
+    spilled_pointers_[i] = spilled_row_[i].has_value() ? spilled_row_[i]->data() : nullptr;
+  }
+  current_ = spilled_pointers_.data();
+}
+
+MYSQL_ROW Stream::next() {
+  if (!spilled_.empty()) {
+    holdCurrent(std::move(spilled_.front()));
+    spilled_.pop_front();
+    return current_;
+  }
+  current_ = nullptr;
+  if (finished_) {
+    return nullptr;
+  }
+  try {
+    if (const auto row = fetch()) {
+      current_ = row;
+      return row;
+    }
+  } catch (...) {
+    abandon();
+    throw;
+  }
+  abandon();
+  return nullptr;
+}
+
+void Stream::spill() {
+  if (finished_) {
+    return;
+  }
+  const auto column_count = mysql_num_fields(result_);
+  // The row the caller is on lives in the result, copy it before fetching more rows and freeing the result
+  if (current_ != nullptr && current_ != spilled_pointers_.data()) {
+    const auto lengths = mysql_fetch_lengths(result_);
+    std::vector<std::optional<std::string>> copy(column_count);
+    for (size_t i = 0; i < column_count; ++i) {
+      if (current_[i] != nullptr) {
+        copy[i].emplace(current_[i], lengths[i]);
+      }
+    }
+    holdCurrent(std::move(copy));
+  }
+  while (const auto row = fetch()) {
+    const auto lengths = mysql_fetch_lengths(result_);
+    auto& copy = spilled_.emplace_back(column_count);
+    for (size_t i = 0; i < column_count; ++i) {
+      if (row[i] != nullptr) {
+        copy[i].emplace(row[i], lengths[i]);
+      }
+    }
+  }
+  abandon();
+}
+
+void Stream::abandon() {
+  if (finished_) {
+    return;
+  }
+  finished_ = true;
+  // Reads and drops whatever the server still sends for this result
+  mysql_free_result(result_);
+  result_ = nullptr;
+}
+}
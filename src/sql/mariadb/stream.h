@@ -0,0 +1,74 @@
+#pragma once
+#include <mysql/mysql.h>
+
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Connector/C has non-blocking variants of the calls that wait on the server. libmysqlclient does not
+#if defined(MARIADB_PACKAGE_VERSION_ID) && !defined(_WIN32)
+#define DBPROVE_MARIADB_NONBLOCK 1
+#endif
+
+namespace sql::mariadb {
+/**
+ * Point in time after which the running statement is cancelled.
+ *
+ * Only enforced when the client library has the non-blocking API. `cancel` must stop the statement on the server
+ * from another session, the waiting call then returns with an error and a timeout is thrown.
+ */
+struct Deadline {
+  std::chrono::steady_clock::time_point at;
+  uint32_t timeout_seconds;
+  std::function<void()> cancel;
+};
+
+/// @brief Send `statement` and wait for the server to accept it. Returns the `mysql_real_query` status
+int realQuery(MYSQL* conn, std::string_view statement, const std::optional<Deadline>& deadline);
+
+/**
+ * Rows of a result read with `mysql_use_result`, so only the current row is held by the client.
+ *
+ * The connection cannot run another statement until the stream is finished. When it has to, `spill` reads the
+ * remaining rows into memory first, so the result stays readable.
+ */
+class Stream {
+  MYSQL* conn_;
+  MYSQL_RES* result_;
+  const std::optional<Deadline> deadline_;
+  bool finished_ = false;
+  std::deque<std::vector<std::optional<std::string>>> spilled_;
+  std::vector<std::optional<std::string>> spilled_row_;
+  std::vector<char*> spilled_pointers_;
+  MYSQL_ROW current_ = nullptr;
+
+  MYSQL_ROW fetch();
+  /// @brief Point `current_` at a copy of `row`, so it no longer refers to memory owned by the result
+  void holdCurrent(std::vector<std::optional<std::string>> row);
+
+public:
+  Stream(MYSQL* conn, MYSQL_RES* result, std::optional<Deadline> deadline);
+  ~Stream();
+  Stream(const Stream&) = delete;
+  Stream& operator=(const Stream&) = delete;
+
+  [[nodiscard]] MYSQL_RES* result() const { return result_; }
+
+  /// @brief The next row or nullptr once all rows were read
+  MYSQL_ROW next();
+
+  /// @brief The row last returned by `next`. Unlike that pointer, this stays valid across `spill`
+  [[nodiscard]] MYSQL_ROW current() const { return current_; }
+
+  /// @brief Read the rows still on the wire into memory and give the connection back
+  void spill();
+
+  /// @brief Discard the rows still on the wire and give the connection back
+  void abandon();
+};
+}
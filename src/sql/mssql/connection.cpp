@@ -263,6 +263,10 @@ std::unique_ptr<ResultBase> Connection::fetchAll(const std::string_view statemen
   return odbc::Connection::fetchAll(translateSQL(statement));
 }
 
+std::unique_ptr<PreparedStatement> Connection::prepare(const std::string_view statement) {
+  return odbc::Connection::prepare(translateSQL(statement));
+}
+
 const ConnectionBase::TypeMap& Connection::typeMap() const {
   static const TypeMap map = {
       {SqlTypeKind::DOUBLE, "FLOAT(53)"},
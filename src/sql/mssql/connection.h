@@ -16,6 +16,10 @@ public:
   std::unique_ptr<explain::Plan> explain(std::string_view statement, std::optional<std::string_view> name = std::nullopt) override;
   void execute(std::string_view statement) override;
   std::unique_ptr<ResultBase> fetchAll(std::string_view statement) override;
+  std::unique_ptr<PreparedStatement> prepare(std::string_view statement) override;
+
+protected:
+  [[nodiscard]] std::optional<std::string_view> measuredExplainFormat() const override;
 
 private:
   std::string fetchLivePlan(std::string_view statement);
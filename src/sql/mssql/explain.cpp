@@ -1097,7 +1097,7 @@ std::unique_ptr<explain::Plan> Connection::explain(const std::string_view statem
   const auto cached_xml = getArtefact(artifact_name, "xml");
   if (cached_xml) {
     PLOGI << "Using cached execution plan artifact for: " << artifact_name;
-    return buildExplainPlan(*cached_xml);
+    return buildExplainPlan(std::string(*cached_xml));
   }
 
   const std::string explain_string = fetchLivePlan(statement);
@@ -1105,6 +1105,11 @@ std::unique_ptr<explain::Plan> Connection::explain(const std::string_view statem
   return buildExplainPlan(explain_string);
 }
 
+std::optional<std::string_view> Connection::measuredExplainFormat() const {
+  // The live plan comes from executing the query with STATISTICS XML on
+  return "xml";
+}
+
 std::string Connection::fetchLivePlan(const std::string_view statement) {
   /* NOTE: We have to do multiple roundtrips here due to a limitation in SQL Servers handling of batches wiuth SET statements*/
   execute("SET STATISTICS XML ON");
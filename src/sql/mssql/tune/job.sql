@@ -323,43 +323,86 @@ IF OBJECT_ID(N'job.title', N'U') IS NOT NULL
     CREATE INDEX kind_id_title ON job.title (kind_id);
 
 -- Refresh statistics for JOB tables when stats are missing or stale after loading/tuning.
-DECLARE @JobTableName NVARCHAR(255);
-DECLARE @JobSQL NVARCHAR(MAX);
-
-DECLARE job_stats_cursor CURSOR FOR
-SELECT t.name
-FROM sys.tables t
-JOIN sys.schemas s ON t.schema_id = s.schema_id
-WHERE s.name = 'job'
-  AND t.name IN (
-      'aka_name', 'aka_title', 'cast_info', 'char_name', 'comp_cast_type',
-      'company_name', 'company_type', 'complete_cast', 'info_type', 'keyword',
-      'kind_type', 'link_type', 'movie_companies', 'movie_info', 'movie_info_idx',
-      'movie_keyword', 'movie_link', 'name', 'person_info', 'role_type', 'title'
-  );
-
-OPEN job_stats_cursor;
-FETCH NEXT FROM job_stats_cursor INTO @JobTableName;
-
-WHILE @@FETCH_STATUS = 0
-BEGIN
-    IF EXISTS (
-        SELECT 1
-        FROM sys.stats st
-        JOIN sys.objects o ON o.object_id = st.object_id
-        WHERE st.object_id = OBJECT_ID(N'job.' + @JobTableName)
-          AND (
-              STATS_DATE(st.object_id, st.stats_id) IS NULL
-              OR STATS_DATE(st.object_id, st.stats_id) < o.modify_date
-          )
-    )
-    BEGIN
-        SET @JobSQL = 'UPDATE STATISTICS [job].' + QUOTENAME(@JobTableName);
-        EXEC sp_executesql @JobSQL;
-    END
-
-    FETCH NEXT FROM job_stats_cursor INTO @JobTableName;
-END
-
-CLOSE job_stats_cursor;
-DEALLOCATE job_stats_cursor;
+IF EXISTS (SELECT 1 FROM sys.stats st JOIN sys.objects o ON o.object_id = st.object_id
+           WHERE o.object_id = OBJECT_ID(N'job.aka_name') AND ISNULL(STATS_DATE(st.object_id, st.stats_id), 0) < o.modify_date)
+    UPDATE STATISTICS job.aka_name;
+
+IF EXISTS (SELECT 1 FROM sys.stats st JOIN sys.objects o ON o.object_id = st.object_id
+           WHERE o.object_id = OBJECT_ID(N'job.aka_title') AND ISNULL(STATS_DATE(st.object_id, st.stats_id), 0) < o.modify_date)
+    UPDATE STATISTICS job.aka_title;
+
+IF EXISTS (SELECT 1 FROM sys.stats st JOIN sys.objects o ON o.object_id = st.object_id
+           WHERE o.object_id = OBJECT_ID(N'job.cast_info') AND ISNULL(STATS_DATE(st.object_id, st.stats_id), 0) < o.modify_date)
+    UPDATE STATISTICS job.cast_info;
+
+IF EXISTS (SELECT 1 FROM sys.stats st JOIN sys.objects o ON o.object_id = st.object_id
+           WHERE o.object_id = OBJECT_ID(N'job.char_name') AND ISNULL(STATS_DATE(st.object_id, st.stats_id), 0) < o.modify_date)
+    UPDATE STATISTICS job.char_name;
+
+IF EXISTS (SELECT 1 FROM sys.stats st JOIN sys.objects o ON o.object_id = st.object_id
+           WHERE o.object_id = OBJECT_ID(N'job.comp_cast_type') AND ISNULL(STATS_DATE(st.object_id, st.stats_id), 0) < o.modify_date)
+    UPDATE STATISTICS job.comp_cast_type;
+
+IF EXISTS (SELECT 1 FROM sys.stats st JOIN sys.objects o ON o.object_id = st.object_id
+           WHERE o.object_id = OBJECT_ID(N'job.company_name') AND ISNULL(STATS_DATE(st.object_id, st.stats_id), 0) < o.modify_date)
+    UPDATE STATISTICS job.company_name;
+
+IF EXISTS (SELECT 1 FROM sys.stats st JOIN sys.objects o ON o.object_id = st.object_id
+           WHERE o.object_id = OBJECT_ID(N'job.company_type') AND ISNULL(STATS_DATE(st.object_id, st.stats_id), 0) < o.modify_date)
+    UPDATE STATISTICS job.company_type;
+
+IF EXISTS (SELECT 1 FROM sys.stats st JOIN sys.objects o ON o.object_id = st.object_id
+           WHERE o.object_id = OBJECT_ID(N'job.complete_cast') AND ISNULL(STATS_DATE(st.object_id, st.stats_id), 0) < o.modify_date)
+    UPDATE STATISTICS job.complete_cast;
+
+IF EXISTS (SELECT 1 FROM sys.stats st JOIN sys.objects o ON o.object_id = st.object_id
+           WHERE o.object_id = OBJECT_ID(N'job.info_type') AND ISNULL(STATS_DATE(st.object_id, st.stats_id), 0) < o.modify_date)
+    UPDATE STATISTICS job.info_type;
+
+IF EXISTS (SELECT 1 FROM sys.stats st JOIN sys.objects o ON o.object_id = st.object_id
+           WHERE o.object_id = OBJECT_ID(N'job.keyword') AND ISNULL(STATS_DATE(st.object_id, st.stats_id), 0) < o.modify_date)
+    UPDATE STATISTICS job.keyword;
+
+IF EXISTS (SELECT 1 FROM sys.stats st JOIN sys.objects o ON o.object_id = st.object_id
+           WHERE o.object_id = OBJECT_ID(N'job.kind_type') AND ISNULL(STATS_DATE(st.object_id, st.stats_id), 0) < o.modify_date)
+    UPDATE STATISTICS job.kind_type;
+
+IF EXISTS (SELECT 1 FROM sys.stats st JOIN sys.objects o ON o.object_id = st.object_id
+           WHERE o.object_id = OBJECT_ID(N'job.link_type') AND ISNULL(STATS_DATE(st.object_id, st.stats_id), 0) < o.modify_date)
+    UPDATE STATISTICS job.link_type;
+
+IF EXISTS (SELECT 1 FROM sys.stats st JOIN sys.objects o ON o.object_id = st.object_id
+           WHERE o.object_id = OBJECT_ID(N'job.movie_companies') AND ISNULL(STATS_DATE(st.object_id, st.stats_id), 0) < o.modify_date)
+    UPDATE STATISTICS job.movie_companies;
+
+IF EXISTS (SELECT 1 FROM sys.stats st JOIN sys.objects o ON o.object_id = st.object_id
+           WHERE o.object_id = OBJECT_ID(N'job.movie_info') AND ISNULL(STATS_DATE(st.object_id, st.stats_id), 0) < o.modify_date)
+    UPDATE STATISTICS job.movie_info;
+
+IF EXISTS (SELECT 1 FROM sys.stats st JOIN sys.objects o ON o.object_id = st.object_id
+           WHERE o.object_id = OBJECT_ID(N'job.movie_info_idx') AND ISNULL(STATS_DATE(st.object_id, st.stats_id), 0) < o.modify_date)
+    UPDATE STATISTICS job.movie_info_idx;
+
+IF EXISTS (SELECT 1 FROM sys.stats st JOIN sys.objects o ON o.object_id = st.object_id
+           WHERE o.object_id = OBJECT_ID(N'job.movie_keyword') AND ISNULL(STATS_DATE(st.object_id, st.stats_id), 0) < o.modify_date)
+    UPDATE STATISTICS job.movie_keyword;
+
+IF EXISTS (SELECT 1 FROM sys.stats st JOIN sys.objects o ON o.object_id = st.object_id
+           WHERE o.object_id = OBJECT_ID(N'job.movie_link') AND ISNULL(STATS_DATE(st.object_id, st.stats_id), 0) < o.modify_date)
+    UPDATE STATISTICS job.movie_link;
+
+IF EXISTS (SELECT 1 FROM sys.stats st JOIN sys.objects o ON o.object_id = st.object_id
+           WHERE o.object_id = OBJECT_ID(N'job.name') AND ISNULL(STATS_DATE(st.object_id, st.stats_id), 0) < o.modify_date)
+    UPDATE STATISTICS job.name;
+
+IF EXISTS (SELECT 1 FROM sys.stats st JOIN sys.objects o ON o.object_id = st.object_id
+           WHERE o.object_id = OBJECT_ID(N'job.person_info') AND ISNULL(STATS_DATE(st.object_id, st.stats_id), 0) < o.modify_date)
+    UPDATE STATISTICS job.person_info;
+
+IF EXISTS (SELECT 1 FROM sys.stats st JOIN sys.objects o ON o.object_id = st.object_id
+           WHERE o.object_id = OBJECT_ID(N'job.role_type') AND ISNULL(STATS_DATE(st.object_id, st.stats_id), 0) < o.modify_date)
+    UPDATE STATISTICS job.role_type;
+
+IF EXISTS (SELECT 1 FROM sys.stats st JOIN sys.objects o ON o.object_id = st.object_id
+           WHERE o.object_id = OBJECT_ID(N'job.title') AND ISNULL(STATS_DATE(st.object_id, st.stats_id), 0) < o.modify_date)
+    UPDATE STATISTICS job.title;
@@ -3,9 +3,6 @@
 -- 1) Clustered columnstore index on each TPCH table
 -- 2) Secondary row-store index via NONCLUSTERED PRIMARY KEY constraints
 
-DECLARE @TableName NVARCHAR(255);
-DECLARE @SQL NVARCHAR(MAX);
-
 -- Primary keys
 IF OBJECT_ID(N'tpch_sf1.part', N'U') IS NOT NULL
    AND NOT EXISTS (SELECT 1 FROM sys.key_constraints WHERE name = N'pk_part' AND type = 'PK')
@@ -104,72 +101,68 @@ IF OBJECT_ID(N'tpch_sf1.orders', N'U') IS NOT NULL
    AND NOT EXISTS (SELECT 1 FROM sys.indexes WHERE object_id = OBJECT_ID(N'tpch_sf1.orders') AND name = N'orders_custkey_idx')
     CREATE INDEX orders_custkey_idx ON tpch_sf1.orders (o_custkey);
 
-DECLARE table_cursor CURSOR FOR
-SELECT t.name
-FROM sys.tables t
-JOIN sys.schemas s ON t.schema_id = s.schema_id
-WHERE s.name = 'tpch_sf1'
-  AND t.name IN ('part', 'supplier', 'partsupp', 'customer', 'orders', 'lineitem', 'nation', 'region')
-  AND NOT EXISTS (
-      SELECT 1 FROM sys.indexes i
-      WHERE i.object_id = t.object_id
-        AND i.type = 5 -- Clustered Columnstore
-  );
+-- Clustered columnstore index on each table
+IF OBJECT_ID(N'tpch_sf1.part', N'U') IS NOT NULL
+   AND NOT EXISTS (SELECT 1 FROM sys.indexes WHERE object_id = OBJECT_ID(N'tpch_sf1.part') AND type = 5)
+    CREATE CLUSTERED COLUMNSTORE INDEX cci_part ON tpch_sf1.part;
 
-OPEN table_cursor;
+IF OBJECT_ID(N'tpch_sf1.supplier', N'U') IS NOT NULL
+   AND NOT EXISTS (SELECT 1 FROM sys.indexes WHERE object_id = OBJECT_ID(N'tpch_sf1.supplier') AND type = 5)
+    CREATE CLUSTERED COLUMNSTORE INDEX cci_supplier ON tpch_sf1.supplier;
 
-FETCH NEXT FROM table_cursor INTO @TableName;
+IF OBJECT_ID(N'tpch_sf1.partsupp', N'U') IS NOT NULL
+   AND NOT EXISTS (SELECT 1 FROM sys.indexes WHERE object_id = OBJECT_ID(N'tpch_sf1.partsupp') AND type = 5)
+    CREATE CLUSTERED COLUMNSTORE INDEX cci_partsupp ON tpch_sf1.partsupp;
 
-WHILE @@FETCH_STATUS = 0
-BEGIN
-    SET @SQL = 'CREATE CLUSTERED COLUMNSTORE INDEX cci_' + @TableName + ' ON [tpch_sf1].' + QUOTENAME(@TableName);
+IF OBJECT_ID(N'tpch_sf1.customer', N'U') IS NOT NULL
+   AND NOT EXISTS (SELECT 1 FROM sys.indexes WHERE object_id = OBJECT_ID(N'tpch_sf1.customer') AND type = 5)
+    CREATE CLUSTERED COLUMNSTORE INDEX cci_customer ON tpch_sf1.customer;
 
-    PRINT 'Executing: ' + @SQL;
-    EXEC sp_executesql @SQL;
+IF OBJECT_ID(N'tpch_sf1.orders', N'U') IS NOT NULL
+   AND NOT EXISTS (SELECT 1 FROM sys.indexes WHERE object_id = OBJECT_ID(N'tpch_sf1.orders') AND type = 5)
+    CREATE CLUSTERED COLUMNSTORE INDEX cci_orders ON tpch_sf1.orders;
 
-    FETCH NEXT FROM table_cursor INTO @TableName;
-END
+IF OBJECT_ID(N'tpch_sf1.lineitem', N'U') IS NOT NULL
+   AND NOT EXISTS (SELECT 1 FROM sys.indexes WHERE object_id = OBJECT_ID(N'tpch_sf1.lineitem') AND type = 5)
+    CREATE CLUSTERED COLUMNSTORE INDEX cci_lineitem ON tpch_sf1.lineitem;
 
-CLOSE table_cursor;
-DEALLOCATE table_cursor;
+IF OBJECT_ID(N'tpch_sf1.nation', N'U') IS NOT NULL
+   AND NOT EXISTS (SELECT 1 FROM sys.indexes WHERE object_id = OBJECT_ID(N'tpch_sf1.nation') AND type = 5)
+    CREATE CLUSTERED COLUMNSTORE INDEX cci_nation ON tpch_sf1.nation;
+
+IF OBJECT_ID(N'tpch_sf1.region', N'U') IS NOT NULL
+   AND NOT EXISTS (SELECT 1 FROM sys.indexes WHERE object_id = OBJECT_ID(N'tpch_sf1.region') AND type = 5)
+    CREATE CLUSTERED COLUMNSTORE INDEX cci_region ON tpch_sf1.region;
 
 -- Refresh statistics for TPCH tables when stats are missing or older than latest schema modifications.
-DECLARE @StatsTableName NVARCHAR(255);
-DECLARE @StatsSchemaName NVARCHAR(255);
-DECLARE @QualifiedName NVARCHAR(512);
-
-DECLARE stats_cursor CURSOR FOR
-SELECT t.name, s.name
-FROM sys.tables t
-JOIN sys.schemas s ON t.schema_id = s.schema_id
-WHERE s.name = 'tpch_sf1'
-  AND t.name IN ('part', 'supplier', 'partsupp', 'customer', 'orders', 'lineitem', 'nation', 'region');
-
-OPEN stats_cursor;
-FETCH NEXT FROM stats_cursor INTO @StatsTableName, @StatsSchemaName;
-
-WHILE @@FETCH_STATUS = 0
-BEGIN
-    SET @QualifiedName = QUOTENAME(@StatsSchemaName) + '.' + QUOTENAME(@StatsTableName);
-
-    IF EXISTS (
-        SELECT 1
-        FROM sys.stats st
-        JOIN sys.objects o ON o.object_id = st.object_id
-        WHERE st.object_id = OBJECT_ID(@QualifiedName)
-          AND (
-              STATS_DATE(st.object_id, st.stats_id) IS NULL
-              OR STATS_DATE(st.object_id, st.stats_id) < o.modify_date
-          )
-    )
-    BEGIN
-        SET @SQL = 'UPDATE STATISTICS ' + @QualifiedName;
-        PRINT 'Executing: ' + @SQL;
-        EXEC sp_executesql @SQL;
-    END
-
-    FETCH NEXT FROM stats_cursor INTO @StatsTableName, @StatsSchemaName;
-END
-
-CLOSE stats_cursor;
-DEALLOCATE stats_cursor;
+IF EXISTS (SELECT 1 FROM sys.stats st JOIN sys.objects o ON o.object_id = st.object_id
+           WHERE o.object_id = OBJECT_ID(N'tpch_sf1.part') AND ISNULL(STATS_DATE(st.object_id, st.stats_id), 0) < o.modify_date)
+    UPDATE STATISTICS tpch_sf1.part;
+
+IF EXISTS (SELECT 1 FROM sys.stats st JOIN sys.objects o ON o.object_id = st.object_id
+           WHERE o.object_id = OBJECT_ID(N'tpch_sf1.supplier') AND ISNULL(STATS_DATE(st.object_id, st.stats_id), 0) < o.modify_date)
+    UPDATE STATISTICS tpch_sf1.supplier;
+
+IF EXISTS (SELECT 1 FROM sys.stats st JOIN sys.objects o ON o.object_id = st.object_id
+           WHERE o.object_id = OBJECT_ID(N'tpch_sf1.partsupp') AND ISNULL(STATS_DATE(st.object_id, st.stats_id), 0) < o.modify_date)
+    UPDATE STATISTICS tpch_sf1.partsupp;
+
+IF EXISTS (SELECT 1 FROM sys.stats st JOIN sys.objects o ON o.object_id = st.object_id
+           WHERE o.object_id = OBJECT_ID(N'tpch_sf1.customer') AND ISNULL(STATS_DATE(st.object_id, st.stats_id), 0) < o.modify_date)
+    UPDATE STATISTICS tpch_sf1.customer;
+
+IF EXISTS (SELECT 1 FROM sys.stats st JOIN sys.objects o ON o.object_id = st.object_id
+           WHERE o.object_id = OBJECT_ID(N'tpch_sf1.orders') AND ISNULL(STATS_DATE(st.object_id, st.stats_id), 0) < o.modify_date)
+    UPDATE STATISTICS tpch_sf1.orders;
+
+IF EXISTS (SELECT 1 FROM sys.stats st JOIN sys.objects o ON o.object_id = st.object_id
+           WHERE o.object_id = OBJECT_ID(N'tpch_sf1.lineitem') AND ISNULL(STATS_DATE(st.object_id, st.stats_id), 0) < o.modify_date)
+    UPDATE STATISTICS tpch_sf1.lineitem;
+
+IF EXISTS (SELECT 1 FROM sys.stats st JOIN sys.objects o ON o.object_id = st.object_id
+           WHERE o.object_id = OBJECT_ID(N'tpch_sf1.nation') AND ISNULL(STATS_DATE(st.object_id, st.stats_id), 0) < o.modify_date)
+    UPDATE STATISTICS tpch_sf1.nation;
+
+IF EXISTS (SELECT 1 FROM sys.stats st JOIN sys.objects o ON o.object_id = st.object_id
+           WHERE o.object_id = OBJECT_ID(N'tpch_sf1.region') AND ISNULL(STATS_DATE(st.object_id, st.stats_id), 0) < o.modify_date)
+    UPDATE STATISTICS tpch_sf1.region;
@@ -26,6 +26,8 @@ public:
   CredentialPassword credential;
   const std::string connection_string;
   bool is_open = false;
+  /// Replaced on every open and released on close, statement handles from earlier sessions are gone
+  std::shared_ptr<void> session;
 
   void check_connection(const SQLRETURN ret, const SQLHANDLE handle, const SQLSMALLINT type) {
     if (ret == SQL_SUCCESS || ret == SQL_SUCCESS_WITH_INFO)
@@ -66,6 +68,15 @@ public:
                                       SQL_NTS, outConnStr, sizeof(outConnStr), &outConnStrLen, SQL_DRIVER_NOPROMPT),
                      connection, SQL_HANDLE_DBC);
     is_open = true;
+    session = std::make_shared<bool>(true);
+  }
+
+  /// @brief Allocate a statement handle on the open connection
+  std::shared_ptr<StatementHandle> allocateStatement() {
+    check_connection_not_closed();
+    SQLHSTMT statement_handle = nullptr;
+    check_connection(SQLAllocHandle(SQL_HANDLE_STMT, connection, &statement_handle), connection, SQL_HANDLE_DBC);
+    return std::make_shared<StatementHandle>(statement_handle, session);
   }
 
   void check_return(const SQLRETURN return_value, SQLHANDLE handle) {
@@ -103,9 +114,8 @@ public:
   }
 
   void executeRaw(const std::string_view statement) {
-    check_connection_not_closed();
-    SQLHSTMT statement_handle = nullptr;
-    check_connection(SQLAllocHandle(SQL_HANDLE_STMT, connection, &statement_handle), connection, SQL_HANDLE_DBC);
+    const auto handle = allocateStatement();
+    const auto statement_handle = handle->get();
 
     const auto ret = SQLExecDirect(statement_handle, reinterpret_cast<SQLCHAR*>(const_cast<char*>(statement.data())),
                                    static_cast<SQLINTEGER>(statement.size()));
@@ -115,18 +125,23 @@ public:
     while (SQLMoreResults(statement_handle) != SQL_NO_DATA) {
         // Just draining
     }
-
-    SQLFreeHandle(SQL_HANDLE_STMT, statement_handle);
   }
 
   std::unique_ptr<Result> execute(const std::string_view statement) {
-    check_connection_not_closed();
-    SQLHSTMT statement_handle = nullptr;
-    check_connection(SQLAllocHandle(SQL_HANDLE_STMT, connection, &statement_handle), connection, SQL_HANDLE_DBC);
-    const auto ret = SQLExecDirect(statement_handle, reinterpret_cast<SQLCHAR*>(const_cast<char*>(statement.data())),
+    auto handle = allocateStatement();
+    const auto ret = SQLExecDirect(handle->get(), reinterpret_cast<SQLCHAR*>(const_cast<char*>(statement.data())),
                                    static_cast<SQLINTEGER>(statement.size()));
-    check_return(ret, statement_handle);
-    return std::make_unique<Result>(statement_handle);
+    check_return(ret, handle->get());
+    return std::make_unique<Result>(std::move(handle));
+  }
+
+  /// @brief Allocate a statement handle and prepare `statement` on it
+  std::shared_ptr<StatementHandle> prepare(const std::string_view statement) {
+    auto handle = allocateStatement();
+    const auto ret = SQLPrepare(handle->get(), reinterpret_cast<SQLCHAR*>(const_cast<char*>(statement.data())),
+                                static_cast<SQLINTEGER>(statement.size()));
+    check_return(ret, handle->get());
+    return handle;
   }
 
   void close() {
@@ -139,6 +154,7 @@ public:
     connection = nullptr;
     env = nullptr;
     is_open = false;
+    session.reset();
   }
 };
 
@@ -159,6 +175,38 @@ std::unique_ptr<ResultBase> Connection::fetchAll(const std::string_view statemen
   return impl_->execute(mapTypes(statement));
 }
 
+/**
+ * Statement prepared with `SQLPrepare` and run with `SQLExecute` on the same handle.
+ * Results share the handle, so it stays allocated until both the statement and its results are gone
+ */
+class Connection::Statement final : public PreparedStatement {
+  Pimpl& impl_;
+  const std::string statement_;
+  std::shared_ptr<StatementHandle> handle_;
+
+public:
+  Statement(Pimpl& impl, const std::string_view statement)
+    : impl_(impl)
+    , statement_(statement)
+    , handle_(impl.prepare(statement)) {
+  }
+
+  std::unique_ptr<ResultBase> fetchAll() override {
+    impl_.check_connection_not_closed();
+    if (!handle_->valid()) {
+      handle_ = impl_.prepare(statement_);
+    }
+    impl_.check_return(SQLExecute(handle_->get()), handle_->get());
+    return std::make_unique<Result>(handle_);
+  }
+
+  ExecutionMode mode() const override { return ExecutionMode::Prepared; }
+};
+
+std::unique_ptr<PreparedStatement> Connection::prepare(const std::string_view statement) {
+  return std::make_unique<Statement>(*impl_, mapTypes(statement));
+}
+
 std::unique_ptr<explain::Plan> Connection::explain(std::string_view statement, std::optional<std::string_view> name) {
   return nullptr;
 }
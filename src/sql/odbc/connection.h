@@ -7,12 +7,14 @@ namespace sql::odbc {
 class Connection : public ConnectionBase {
   class Pimpl;
   std::unique_ptr<Pimpl> impl_;
+  class Statement;
 
 public:
   explicit Connection(const Credential& credential, const Engine& engine, std::string connection_string, std::optional<std::string> artifacts_path = std::nullopt);
   ~Connection() override;
   virtual void execute(std::string_view statement) override;
   virtual std::unique_ptr<ResultBase> fetchAll(std::string_view statement) override;
+  virtual std::unique_ptr<PreparedStatement> prepare(std::string_view statement) override;
   virtual std::string version() override { return ""; }
   virtual void bulkLoad(const std::string_view table, const std::vector<std::filesystem::path> source_paths) override {}
   virtual const TypeMap& typeMap() const override { static TypeMap empty; return empty; }
@@ -193,13 +193,27 @@ SqlVariant Result::get(size_t index) const {
   return impl_->rowData_[index];
 }
 
-Result::Result(void* handle)
-  : impl_(std::make_unique<Pimpl>(handle, this)) {
-  initResult(handle);
+StatementHandle::StatementHandle(void* handle, std::weak_ptr<void> session)
+  : handle_(handle)
+  , session_(std::move(session)) {
+}
+
+StatementHandle::~StatementHandle() {
+  if (valid()) {
+    SQLFreeHandle(SQL_HANDLE_STMT, handle_);
+  }
+}
+
+Result::Result(std::shared_ptr<StatementHandle> handle)
+  : impl_(std::make_unique<Pimpl>(handle->get(), this))
+  , handle_(std::move(handle)) {
+  initResult(handle_->get());
 }
 
 Result::~Result() {
-  SQLFreeHandle(SQL_HANDLE_STMT, impl_->handle_);
+  if (handle_->valid()) {
+    SQLFreeStmt(handle_->get(), SQL_CLOSE);
+  }
 }
 
 RowCount Result::rowCount() const {
@@ -1,4 +1,5 @@
 #pragma once
+#include <memory>
 #include <vector>
 
 #include "result_base.h"
@@ -6,14 +7,39 @@
 namespace sql::odbc {
 class Row;
 
+/**
+ * ODBC statement handle shared by a prepared statement and the results executed on it, freed with its last owner.
+ *
+ * Closing the connection frees its statement handles with it, so the handle is only used while `valid`.
+ */
+class StatementHandle {
+  void* handle_;
+  std::weak_ptr<void> session_;
+
+public:
+  /// @param session Expires when the connection that allocated the handle is closed
+  StatementHandle(void* handle, std::weak_ptr<void> session);
+  ~StatementHandle();
+  StatementHandle(const StatementHandle&) = delete;
+  StatementHandle& operator=(const StatementHandle&) = delete;
+
+  [[nodiscard]] void* get() const { return handle_; }
+  [[nodiscard]] bool valid() const { return !session_.expired(); }
+};
+
 class Result final : public ResultBase {
   friend class Row;
   class Pimpl;
   std::unique_ptr<Pimpl> impl_;
+  std::shared_ptr<StatementHandle> handle_;
   SqlVariant get(size_t index) const;
 
 public:
-  explicit Result(void* handle);
+  /**
+   * @param handle Statement handle with the executed statement. The result closes its cursor when done, so a
+   * prepared statement can be executed again on it
+   */
+  explicit Result(std::shared_ptr<StatementHandle> handle);
   ~Result() override;
   RowCount rowCount() const override;
   ColumnCount columnCount() const override;
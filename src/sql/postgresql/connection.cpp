@@ -6,16 +6,186 @@
 #include <explain_nodes.h>
 #include <nlohmann/json.hpp>
 
+#include <atomic>
 #include <cassert>
+#include <charconv>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
 #include <fstream>
+#include <functional>
+#include <mutex>
+#include <plog/Log.h>
 #include <regex>
+#include <thread>
+#include <utility>
+
+#ifdef _WIN32
+#include <winsock2.h>
+#else
+#include <poll.h>
+#endif
+
+
+namespace {
+void check_bulk_return(const int status, const PGconn* conn) {
+  if (status != 1) {
+    throw std::runtime_error("Failed to send data to the database " + std::string(PQerrorMessage(conn)));
+  }
+}
+
+/**
+ * Reads a file on a background thread into two alternating buffers, so the next chunk comes off disk
+ * while the current one is on the wire.
+ */
+class DoubleBufferedFile {
+  static constexpr size_t buffer_size = 1024 * 1024;
+
+  struct Buffer {
+    std::unique_ptr<char[]> data = std::make_unique<char[]>(buffer_size);
+    size_t size = 0;
+    bool full = false;
+  };
+
+  std::ifstream file_;
+  Buffer buffers_[2];
+  size_t current_ = 0;
+  bool eof_ = false;
+  bool stopped_ = false;
+  std::optional<std::string> error_;
+  std::mutex mutex_;
+  std::condition_variable changed_;
+  std::thread reader_;
+
+  void readLoop() {
+    for (size_t i = 0;; i = 1 - i) {
+      auto& buffer = buffers_[i];
+      {
+        std::unique_lock lock(mutex_);
+        changed_.wait(lock, [&] { return !buffer.full || stopped_; });
+        if (stopped_) {
+          return;
+        }
+      }
+      file_.read(buffer.data.get(), buffer_size);
+      const auto n = file_.gcount();
+      std::lock_guard lock(mutex_);
+      if (file_.bad()) {
+        error_ = "Failed while reading source file";
+        eof_ = true;
+      } else if (n <= 0) {
+        eof_ = true;
+      } else {
+        buffer.size = static_cast<size_t>(n);
+        buffer.full = true;
+      }
+      changed_.notify_all();
+      if (eof_) {
+        return;
+      }
+    }
+  }
+
+public:
+  explicit DoubleBufferedFile(const std::filesystem::path& path)
+    : file_(path.string(), std::ios::binary) {
+    if (!file_.is_open()) {
+      throw std::ios_base::failure("Failed to open source file: " + path.string());
+    }
+    reader_ = std::thread(&DoubleBufferedFile::readLoop, this);
+  }
+
+  ~DoubleBufferedFile() {
+    {
+      std::lock_guard lock(mutex_);
+      stopped_ = true;
+    }
+    changed_.notify_all();
+    reader_.join();
+  }
+
+  /// @brief Wait for the next chunk. Empty at the end of the file. The chunk is valid until `release`
+  std::string_view next() {
+    std::unique_lock lock(mutex_);
+    auto& buffer = buffers_[current_];
+    changed_.wait(lock, [&] { return buffer.full || eof_; });
+    if (error_) {
+      throw std::ios_base::failure(*error_);
+    }
+    if (!buffer.full) {
+      return {};
+    }
+    return {buffer.data.get(), buffer.size};
+  }
+
+  /// @brief Hand the chunk returned by `next` back to the reader
+  void release() {
+    {
+      std::lock_guard lock(mutex_);
+      buffers_[current_].full = false;
+    }
+    changed_.notify_all();
+    current_ = 1 - current_;
+  }
+};
+
+void waitForSocket(PGconn* conn, const bool write) {
+#ifdef _WIN32
+  WSAPOLLFD fd{};
+  fd.fd = static_cast<SOCKET>(PQsocket(conn));
+  fd.events = POLLRDNORM | (write ? POLLWRNORM : 0);
+  WSAPoll(&fd, 1, -1);
+#else
+  pollfd fd{};
+  fd.fd = PQsocket(conn);
+  fd.events = POLLIN | (write ? POLLOUT : 0);
+  poll(&fd, 1, -1);
+#endif
+  if (fd.revents & POLLIN) {
+    if (PQconsumeInput(conn) == 0) {
+      throw std::runtime_error("Failed to read from the database " + std::string(PQerrorMessage(conn)));
+    }
+  }
+}
+
+/// @brief Push everything libpq has queued for a non-blocking connection onto the wire
+void flushCopy(PGconn* conn) {
+  int status;
+  while ((status = PQflush(conn)) == 1) {
+    waitForSocket(conn, true);
+  }
+  if (status < 0) {
+    throw std::runtime_error("Failed to send data to the database " + std::string(PQerrorMessage(conn)));
+  }
+}
+
+constexpr size_t max_copy_sessions = 4;
+
+/// Statements in flight at once in pipeline mode. Bounded so neither side blocks on a full socket buffer
+constexpr size_t pipeline_window = 64;
+
+/// Rows per chunk of a streamed result, matching the default batch size so batches line up with chunks
+constexpr int stream_chunk_rows = static_cast<int>(sql::ResultBase::DEFAULT_BATCH_ROWS);
+
+struct CopyStats {
+  uint64_t bytes = 0;
+  uint64_t rows = 0;
+};
+}
 
 
 class sql::postgresql::Connection::Pimpl {
 public:
+  class ChunkStream;
+
   Connection& connection;
   const CredentialPassword credential;
   PGconn* conn = nullptr;
+  /// Bumped every time `conn` is reopened, which drops the named statements prepared on it
+  uint64_t session_id = 0;
+  uint64_t prepared_count = 0;
+  /// Result still streaming from `conn`, it must be finished before the next command
+  ChunkStream* open_stream = nullptr;
 
   explicit Pimpl(Connection& connection, const CredentialPassword& credential)
     : connection(connection)
@@ -23,35 +193,56 @@ public:
   }
 
   void safeClose() {
+    detachOpenStream();
     if (conn) {
       PQfinish(conn);
       conn = nullptr;
     }
   }
 
-  void check_connection() {
-    if (conn == nullptr) {
-      std::string connection_string = "host=" + credential.host + " dbname=" + credential.database + " user=" + credential
-                                      .username + " port=" + std::to_string(credential.port);
-      if (credential.password.has_value()) {
-        connection_string += " password=" + credential.password.value();
-      }
-      conn = PQconnectdb(connection_string.c_str());
+  /// @brief Open a new session with this connection's credential. The caller owns the result
+  [[nodiscard]] PGconn* connect() const {
+    std::string connection_string = "host=" + credential.host + " dbname=" + credential.database + " user=" + credential
+                                    .username + " port=" + std::to_string(credential.port);
+    if (credential.password.has_value()) {
+      connection_string += " password=" + credential.password.value();
     }
-    if (conn == nullptr) {
+    PGconn* session = PQconnectdb(connection_string.c_str());
+    if (session == nullptr) {
       throw ConnectionClosedException(credential);
     }
+    if (PQstatus(session) != CONNECTION_OK) {
+      const std::string error = PQerrorMessage(session);
+      PQfinish(session);
+      throw ConnectionException(credential, error);
+    }
+    return session;
+  }
+
+  void finishOpenStream();
+  void detachOpenStream();
 
-    if (PQstatus(conn) != CONNECTION_OK) {
+  void check_connection() {
+    finishOpenStream();
+    if (conn != nullptr && PQstatus(conn) != CONNECTION_OK) {
       const std::string error = PQerrorMessage(conn);
       safeClose();
       throw ConnectionException(credential, error);
     }
+    if (conn == nullptr) {
+      conn = connect();
+      ++session_id;
+    }
   }
 
   /// @brief Handles return values from calls into postgres
   /// @note: If we throw here, we will call `PQClear`. But it is the responsibility of the caller to clear on success
   void check_return(PGresult* result, const std::string_view statement) const {
+    check_return(result, statement, conn);
+  }
+
+  /// @brief As above, for results of another session than `conn`
+  void check_return(PGresult* result, const std::string_view statement, const PGconn* session) const {
     // ReSharper disable once CppTooWideScope
     const auto status = PQresultStatus(result);
     switch (status) {
@@ -59,12 +250,15 @@ public:
       case PGRES_COMMAND_OK:
       case PGRES_EMPTY_QUERY:
       case PGRES_SINGLE_TUPLE:
+#ifdef LIBPQ_HAS_CHUNK_MODE
+      case PGRES_TUPLES_CHUNK:
+#endif
       case PGRES_COPY_IN: // Ready to receive data on COPY
         return;
       /* Legit and harmless status code */
 
       default:
-        const std::string error_msg = PQerrorMessage(this->conn);
+        const std::string error_msg = PQerrorMessage(session);
         assert(!error_msg.empty());
         const char* sqlstate = PQresultErrorField(result, PG_DIAG_SQLSTATE);
         std::string state;
@@ -87,12 +281,98 @@ public:
     }
   }
 
-  PGresult* execute(const std::string_view statement) {
+  /**
+   * @brief Send the statement and stream its rows back chunk by chunk
+   * @param send Sends the statement on `conn` with one of the `PQsend*` calls
+   */
+  std::unique_ptr<ChunkSource> stream(std::string_view statement, const std::function<int(PGconn*)>& send);
+
+  std::unique_ptr<ChunkSource> execute(const std::string_view statement) {
+    check_connection();
+    const auto mapped_statement = connection.mapTypes(statement);
+    return stream(statement, [&](PGconn* cn) {
+      return PQsendQueryParams(cn, mapped_statement.c_str(), 0, nullptr, nullptr, nullptr, nullptr, 1);
+    });
+  }
+
+  /// @brief Parse the statement on the server as a named statement and return its name
+  std::string prepare(const std::string_view statement) {
     check_connection();
+    auto name = "dbprove_" + std::to_string(++prepared_count);
     const auto mapped_statement = connection.mapTypes(statement);
-    PGresult* result = PQexecParams(conn, mapped_statement.c_str(), 0, nullptr, nullptr, nullptr, nullptr, 1);
+    PGresult* result = PQprepare(conn, name.c_str(), mapped_statement.c_str(), 0, nullptr);
     check_return(result, statement);
-    return result;
+    PQclear(result);
+    return name;
+  }
+
+#ifdef LIBPQ_HAS_PIPELINING
+  /**
+   * @brief Send a window of statements in pipeline mode and collect their results.
+   *
+   * Every statement is followed by its own sync, so it runs in its own implicit transaction and a failure does not
+   * abort the statements after it.
+   */
+  void pipelineWindow(const std::span<const std::string_view> statements, std::vector<BatchResult>& results) {
+    for (const auto statement : statements) {
+      const auto mapped_statement = connection.mapTypes(statement);
+      if (PQsendQueryParams(conn, mapped_statement.c_str(), 0, nullptr, nullptr, nullptr, nullptr, 1) == 0
+          || PQpipelineSync(conn) == 0) {
+        throw ConnectionException(credential, PQerrorMessage(conn));
+      }
+    }
+    if (PQflush(conn) != 0) {
+      throw ConnectionException(credential, PQerrorMessage(conn));
+    }
+
+    for (const auto statement : statements) {
+      PGresult* result = PQgetResult(conn);
+      // A single statement has a single result, anything else up to the end of the statement is dropped
+      while (PGresult* extra = PQgetResult(conn)) {
+        PQclear(extra);
+      }
+      PGresult* sync = PQgetResult(conn);
+      const bool synced = sync != nullptr && PQresultStatus(sync) == PGRES_PIPELINE_SYNC;
+      PQclear(sync);
+      if (result == nullptr || !synced) {
+        PQclear(result);
+        throw ProtocolException("Unexpected result sequence from PostgreSQL in pipeline mode");
+      }
+      try {
+        check_return(result, statement);
+        results.push_back({.result = std::make_unique<Result>(result)});
+      } catch (...) {
+        results.push_back({.error = std::current_exception()});
+      }
+    }
+  }
+#endif
+
+  /// @brief Run the statements in pipeline mode, nullopt if this libpq or session cannot pipeline
+  std::optional<std::vector<BatchResult>> executeBatch(const std::span<const std::string_view> statements) {
+#ifdef LIBPQ_HAS_PIPELINING
+    check_connection();
+    if (PQenterPipelineMode(conn) == 1) {
+      std::vector<BatchResult> results;
+      results.reserve(statements.size());
+      try {
+        for (size_t begin = 0; begin < statements.size(); begin += pipeline_window) {
+          pipelineWindow(statements.subspan(begin, std::min(pipeline_window, statements.size() - begin)), results);
+        }
+      } catch (...) {
+        // The pipeline is in an unknown state, the next command opens a fresh session
+        safeClose();
+        throw;
+      }
+      if (PQexitPipelineMode(conn) == 0) {
+        PLOGW << "Failed to leave pipeline mode: " << PQerrorMessage(conn);
+        safeClose();
+      }
+      return results;
+    }
+    PLOGD << "Could not enter pipeline mode, running the batch one statement at a time";
+#endif
+    return std::nullopt;
   }
 
   [[maybe_unused]] auto executeRaw(const std::string_view statement) {
@@ -104,6 +384,236 @@ public:
     PQclear(result);
     return status;
   }
+
+  /**
+   * Copying data into Postgres:
+   *
+   * This interfaces is so obscenely braindead that you simply have to read the code.
+   * Basically, stuff can fail at any time during copy and how you exactly get the error message
+   * and handle it depends on what part of the flow you are in.
+   *
+   * The aim here is to turn the PG errors into subclasses of sql::Exception and give them some
+   * decent error codes and error messages
+   *
+   * The session runs in non-blocking mode while data flows, so libpq queues chunks while
+   * `DoubleBufferedFile` reads the next one from disk.
+   */
+  CopyStats copyFile(PGconn* cn, const std::string_view table, const std::filesystem::path& path) const {
+    DoubleBufferedFile file(path);
+
+    // First, we need to tell PG that a copy stream is coming. This puts the server into a special mode
+    const std::string copy_query = "COPY " + std::string(table) + " FROM STDIN" +
+                                   " WITH (FORMAT csv, DELIMITER '|', NULL '', HEADER)";
+    PGresult* ready = PQexec(cn, copy_query.c_str());
+    check_return(ready, copy_query, cn);
+    assert(PQresultStatus(ready) == PGRES_COPY_IN); // We better have handled this already
+    PQclear(ready);
+
+    CopyStats stats;
+    PQsetnonblocking(cn, 1);
+    try {
+      for (auto chunk = file.next(); !chunk.empty(); chunk = file.next()) {
+        int status;
+        while ((status = PQputCopyData(cn, chunk.data(), static_cast<int>(chunk.size()))) == 0) {
+          waitForSocket(cn, true);
+        }
+        check_bulk_return(status, cn);
+        stats.bytes += chunk.size();
+        file.release();
+      }
+      int end_status;
+      while ((end_status = PQputCopyEnd(cn, nullptr)) == 0) {
+        waitForSocket(cn, true);
+      }
+      check_bulk_return(end_status, cn);
+      flushCopy(cn);
+    } catch (...) {
+      PQsetnonblocking(cn, 0);
+      // Leave the session usable: abort the COPY and swallow the error result it produces
+      PQputCopyEnd(cn, "dbprove aborted the load");
+      while (PGresult* leftover = PQgetResult(cn)) {
+        PQclear(leftover);
+      }
+      throw;
+    }
+    PQsetnonblocking(cn, 0);
+
+    // After our final row (which is marked by PQOutCopyEnd) we now get a result back telling us if it worked
+    const auto final_result = PQgetResult(cn);
+    check_return(final_result, copy_query, cn);
+    const std::string_view tuples = PQcmdTuples(final_result);
+    std::from_chars(tuples.data(), tuples.data() + tuples.size(), stats.rows);
+    PQclear(final_result);
+    // Drain the connection - the usual libpq pointless logic
+    while (PGresult* leftover = PQgetResult(cn)) {
+      PQclear(leftover);
+    }
+    return stats;
+  }
+};
+
+/**
+ * Rows of a running statement, read with `PQgetResult` in chunked mode (libpq 17) or single row mode.
+ *
+ * The session cannot run another command until the stream is finished. When it has to, `spill` reads the remaining
+ * chunks into memory first, so the result stays readable.
+ */
+class sql::postgresql::Connection::Pimpl::ChunkStream final : public ChunkSource {
+  Pimpl& pimpl_;
+  PGconn* conn_;
+  const std::string statement_;
+  std::deque<PGresult*> spilled_;
+  std::exception_ptr spill_error_;
+  bool finished_ = false;
+
+  void finish() {
+    finished_ = true;
+    if (pimpl_.open_stream == this) {
+      pimpl_.open_stream = nullptr;
+    }
+  }
+
+  /// @brief Read and drop the results still coming for this statement
+  void drain() {
+    while (PGresult* leftover = PQgetResult(conn_)) {
+      PQclear(leftover);
+    }
+    finish();
+  }
+
+  PGresult* receive() {
+    if (finished_) {
+      return nullptr;
+    }
+    PGresult* result = PQgetResult(conn_);
+    if (result == nullptr) {
+      finish();
+      return nullptr;
+    }
+    try {
+      pimpl_.check_return(result, statement_, conn_);
+    } catch (...) {
+      drain();
+      throw;
+    }
+    return result;
+  }
+
+public:
+  ChunkStream(Pimpl& pimpl, const std::string_view statement)
+    : pimpl_(pimpl)
+    , conn_(pimpl.conn)
+    , statement_(statement) {
+    pimpl_.open_stream = this;
+  }
+
+  ~ChunkStream() override {
+    for (PGresult* chunk : spilled_) {
+      PQclear(chunk);
+    }
+    if (!finished_) {
+      drain();
+    }
+  }
+
+  void* nextChunk() override {
+    if (!spilled_.empty()) {
+      PGresult* chunk = spilled_.front();
+      spilled_.pop_front();
+      return chunk;
+    }
+    if (spill_error_) {
+      std::rethrow_exception(std::exchange(spill_error_, nullptr));
+    }
+    return receive();
+  }
+
+  /// @brief Read the chunks still on the wire into memory and give the session back
+  void spill() {
+    try {
+      while (PGresult* chunk = receive()) {
+        spilled_.push_back(chunk);
+      }
+    } catch (...) {
+      spill_error_ = std::current_exception();
+    }
+  }
+
+  /// @brief Stop reading from the session, which is about to be closed
+  void detach() {
+    finish();
+  }
+};
+
+void sql::postgresql::Connection::Pimpl::finishOpenStream() {
+  if (open_stream != nullptr) {
+    PLOGD << "Command sent before the previous result was read, buffering the rest of it";
+    open_stream->spill();
+  }
+}
+
+void sql::postgresql::Connection::Pimpl::detachOpenStream() {
+  if (open_stream != nullptr) {
+    open_stream->detach();
+  }
+}
+
+std::unique_ptr<sql::postgresql::ChunkSource> sql::postgresql::Connection::Pimpl::stream(
+    const std::string_view statement, const std::function<int(PGconn*)>& send) {
+  if (send(conn) == 0) {
+    throw ConnectionException(credential, PQerrorMessage(conn));
+  }
+#ifdef LIBPQ_HAS_CHUNK_MODE
+  const bool row_mode = PQsetChunkedRowsMode(conn, stream_chunk_rows) == 1;
+#else
+  const bool row_mode = PQsetSingleRowMode(conn) == 1;
+#endif
+  if (!row_mode) {
+    PLOGD << "Could not stream the rows of the statement, it is read as a single result";
+  }
+  return std::make_unique<ChunkStream>(*this, statement);
+}
+
+/**
+ * Named server side statement, executed with `PQsendQueryPrepared` and streamed like `fetchAll`
+ */
+class sql::postgresql::Connection::Statement final : public PreparedStatement {
+  Pimpl& impl_;
+  const std::string statement_;
+  std::string name_;
+  uint64_t session_id_ = 0;
+
+  void prepare() {
+    name_ = impl_.prepare(statement_);
+    session_id_ = impl_.session_id;
+  }
+
+public:
+  Statement(Pimpl& impl, const std::string_view statement)
+    : impl_(impl)
+    , statement_(statement) {
+    prepare();
+  }
+
+  ~Statement() override {
+    impl_.finishOpenStream();
+    if (impl_.conn != nullptr && impl_.session_id == session_id_) {
+      PQclear(PQexec(impl_.conn, ("DEALLOCATE " + name_).c_str()));
+    }
+  }
+
+  std::unique_ptr<ResultBase> fetchAll() override {
+    impl_.check_connection();
+    if (impl_.session_id != session_id_) {
+      PLOGD << "Session was reopened, preparing " << name_ << " again";
+      prepare();
+    }
+    return std::make_unique<Result>(impl_.stream(statement_, [&](PGconn* cn) {
+      return PQsendQueryPrepared(cn, name_.c_str(), 0, nullptr, nullptr, nullptr, 1);
+    }));
+  }
+
+  ExecutionMode mode() const override { return ExecutionMode::Prepared; }
 };
 
 sql::postgresql::Connection::Connection(const CredentialPassword& credential, const Engine& engine, std::optional<std::string> artifacts_path)
@@ -128,69 +638,82 @@ void sql::postgresql::Connection::execute(const std::string_view statement) {
 }
 
 std::unique_ptr<sql::ResultBase> sql::postgresql::Connection::fetchAll(const std::string_view statement) {
-  PGresult* result = impl_->execute(statement);
-  return std::make_unique<Result>(result);
+  return std::make_unique<Result>(impl_->execute(statement));
 }
 
-void check_bulk_return(const int status, const PGconn* conn) {
-  if (status != 1) {
-    throw std::runtime_error("Failed to send data to the database " + std::string(PQerrorMessage(conn)));
+std::unique_ptr<sql::PreparedStatement> sql::postgresql::Connection::prepare(const std::string_view statement) {
+  return std::make_unique<Statement>(*impl_, statement);
+}
+
+std::vector<sql::BatchResult> sql::postgresql::Connection::executeBatch(
+    const std::span<const std::string_view> statements) {
+  if (statements.size() < 2) {
+    return ConnectionBase::executeBatch(statements);
+  }
+  if (auto results = impl_->executeBatch(statements)) {
+    return std::move(*results);
   }
+  return ConnectionBase::executeBatch(statements);
 }
 
 void sql::postgresql::Connection::bulkLoad(const std::string_view table,
                                          const std::vector<std::filesystem::path> source_paths) {
-  /*
-   * Copying data into Postgres:
-   *
-   * This interfaces is so obscenely braindead that you simply have to read the code.
-   * Basically, stuff can fail at any time during copy and how you exactly get the error message
-   * and handle it depends on what part of the flow you are in.
-   *
-   * The aim here is to turn the PG errors into subclasses of sql::Exception and give them some
-   * decent error codes and error messages
-   */
-
   validateSourcePaths(source_paths);
+  impl_->check_connection();
 
-  const auto cn = impl_->conn;
-  for (const auto& path : source_paths) {
-    std::ifstream file(path.string(), std::ios::binary);
-    if (!file.is_open()) {
-      throw std::ios_base::failure("Failed to open source file: " + path.string());
-    }
+  // Tables staged as several files are fanned out over extra sessions, each claiming the next file
+  const auto session_count = std::min(source_paths.size(), max_copy_sessions);
+  std::vector<PGconn*> sessions = {impl_->conn};
+  std::vector<std::thread> workers;
+  std::atomic<size_t> next_file{0};
+  std::atomic<uint64_t> total_bytes{0};
+  std::atomic<uint64_t> total_rows{0};
+  std::mutex error_mutex;
+  std::exception_ptr first_error;
 
-    // First, we need to tell PG that a copy stream is coming. This puts the server into a special mode
-    std::string copy_query = "COPY " + std::string(table) + " FROM STDIN" +
-                             " WITH (FORMAT csv, DELIMITER '|', NULL '', HEADER)";
-    const auto ready_status = impl_->executeRaw(copy_query);
-    assert(ready_status == PGRES_COPY_IN); // We better have handled this already
-
-    // Chunk file content to the database (synchronously) with 1MB chunks so we can hide latency
-    // There is an "async" interface too - but it requires polling sockets and manually backing off
-    // based on return codes. One day, I will make this work - after I lose my will to live!
-    constexpr size_t buffer_size = 1024 * 1024;
-    auto buf = std::make_unique<char[]>(buffer_size);
-    while (file) {
-      file.read(buf.get(), buffer_size);
-      const std::streamsize n = file.gcount();
-      if (n > 0) {
-        const auto progress_status = PQputCopyData(cn, buf.get(), static_cast<int>(n));
-        check_bulk_return(progress_status, cn);
+  const auto worker = [&](PGconn* session) {
+    try {
+      for (auto i = next_file.fetch_add(1); i < source_paths.size(); i = next_file.fetch_add(1)) {
+        const auto stats = impl_->copyFile(session, table, source_paths[i]);
+        total_bytes += stats.bytes;
+        total_rows += stats.rows;
+      }
+    } catch (...) {
+      std::lock_guard lock(error_mutex);
+      if (!first_error) {
+        first_error = std::current_exception();
       }
+      next_file = source_paths.size();
     }
-    const auto end_status = PQputCopyEnd(cn, nullptr);
-    check_bulk_return(end_status, cn);
+  };
 
-    // After our final row (which is marked by PQOutCopyEnd) we now get a result back telling us if it worked
-    const auto final_result = PQgetResult(cn);
-    impl_->check_return(final_result, copy_query);
-    PQclear(PQgetResult(cn));
-    // Drain the connection - the usual libpq pointless logic
-    while (PGresult* leftover = PQgetResult(cn)) {
-      PQclear(leftover);
+  const auto start = std::chrono::steady_clock::now();
+  try {
+    while (sessions.size() < session_count) {
+      sessions.push_back(impl_->connect());
     }
+  } catch (const std::exception& e) {
+    PLOGW << "Loading " << table << " on " << sessions.size() << " sessions, could not open more: " << e.what();
+  }
+  for (size_t i = 1; i < sessions.size(); ++i) {
+    workers.emplace_back(worker, sessions[i]);
   }
+  worker(impl_->conn);
+  for (auto& w : workers) {
+    w.join();
+  }
+  for (size_t i = 1; i < sessions.size(); ++i) {
+    PQfinish(sessions[i]);
+  }
+  if (first_error) {
+    std::rethrow_exception(first_error);
+  }
+
+  const auto seconds = std::max(std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count(), 1e-6);
+  const auto mb = static_cast<double>(total_bytes) / (1024.0 * 1024.0);
+  PLOGI << "Loaded " << table << ": " << total_rows << " rows, " << mb << " MB in " << seconds << " s ("
+      << mb / seconds << " MB/s, " << static_cast<double>(total_rows) / seconds << " rows/s) over "
+      << sessions.size() << " sessions";
 }
 
 
@@ -206,6 +729,12 @@ std::string sql::postgresql::Connection::version() {
   return "Unknown";
 }
 
+void sql::postgresql::Connection::resetSession() {
+  ConnectionBase::resetSession();
+  // Unlike DISCARD ALL, this keeps the statements prepared on the session
+  impl_->executeRaw("RESET ALL");
+}
+
 void sql::postgresql::Connection::close() {
   impl_->safeClose();
 }
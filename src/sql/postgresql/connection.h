@@ -9,6 +9,7 @@ class Connection : public ConnectionBase {
    */
   class Pimpl;
   std::unique_ptr<Pimpl> impl_;
+  class Statement;
 
 public:
   explicit Connection(const CredentialPassword& credential, const Engine& engine, std::optional<std::string> artifacts_path = std::nullopt);
@@ -18,9 +19,15 @@ public:
 
   void execute(std::string_view statement) override;
   std::unique_ptr<ResultBase> fetchAll(std::string_view statement) override;
+  std::unique_ptr<PreparedStatement> prepare(std::string_view statement) override;
+  std::vector<BatchResult> executeBatch(std::span<const std::string_view> statements) override;
   void bulkLoad(const std::string_view table, const std::vector<std::filesystem::path> source_paths) override;
   std::unique_ptr<explain::Plan> explain(std::string_view statement, std::optional<std::string_view> name = std::nullopt) override;
   std::string version() override;
+  void resetSession() override;
   void close() override;
+
+protected:
+  [[nodiscard]] std::optional<std::string_view> measuredExplainFormat() const override;
 };
 } // namespace sql::postgres
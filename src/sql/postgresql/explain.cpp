@@ -685,4 +685,9 @@ std::unique_ptr<Plan> Connection::explain(const std::string_view statement, std:
 
   return buildExplainPlan(explain_json);
 }
+
+std::optional<std::string_view> Connection::measuredExplainFormat() const {
+  // EXPLAIN ANALYZE runs the query and reports the execution time and actual rows
+  return "json";
+}
 }
@@ -124,20 +124,30 @@ SqlVariant parseDecimal(const char* binary_value, const int value_length) {
 }
 
 template <typename T>
-SqlVariant parseInt(const char* binary_value) {
+T readInt(const char* binary_value) {
   T int_value;
   std::memcpy(&int_value, binary_value, sizeof(T));
-  return SqlVariant(flipByteOrder(int_value));
+  return flipByteOrder(int_value);
 }
 
 template <typename T>
-SqlVariant parseFloat(const char* binary_value) {
+T readFloat(const char* binary_value) {
   using UIntType = std::conditional_t<sizeof(T) == 4, uint32_t, uint64_t>;
   UIntType raw_value;
   std::memcpy(&raw_value, binary_value, sizeof(T));
   raw_value = flipByteOrder(raw_value);
   T result;
   std::memcpy(&result, &raw_value, sizeof(T));
-  return SqlVariant(result);
+  return result;
+}
+
+template <typename T>
+SqlVariant parseInt(const char* binary_value) {
+  return SqlVariant(readInt<T>(binary_value));
+}
+
+template <typename T>
+SqlVariant parseFloat(const char* binary_value) {
+  return SqlVariant(readFloat<T>(binary_value));
 }
 }
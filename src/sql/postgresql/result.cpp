@@ -6,29 +6,91 @@
 #include "sql_exceptions.h"
 
 namespace sql::postgresql {
+namespace {
+/// @brief Kind of the values in a column of type `pg_type`. Everything the result can read maps to one
+SqlTypeKind kindOf(const Oid pg_type) {
+  switch (pg_type) {
+    case INT2OID:
+      return SqlTypeKind::SMALLINT;
+    case INT4OID:
+      return SqlTypeKind::INT;
+    case INT8OID:
+      return SqlTypeKind::BIGINT;
+    case FLOAT4OID:
+      return SqlTypeKind::REAL;
+    case FLOAT8OID:
+      return SqlTypeKind::DOUBLE;
+    case VARCHAROID:
+    case TEXTOID:
+    case JSONOID:
+      return SqlTypeKind::STRING;
+    case NUMERICOID:
+      return SqlTypeKind::DECIMAL;
+    default:
+      throw InvalidTypeException("The OID '" + std::to_string(pg_type) + "' cannot be mapped to a type");
+  }
+}
+}
+
 class Result::Pimpl {
 public:
+  std::unique_ptr<ChunkSource> source_;
+  const bool streaming_;
+  PGresult* data_;
   const int columnCount_;
-  const int rowCount_;
+  int rowCount_;
   Row currentRow_;
-  PGresult* data_;
-  RowCount nextRowNumber;
+  RowCount nextRowNumber = 0;
+  RowCount rowsReturned_ = 0;
 
-  explicit Pimpl(PGresult* data, Result* result)
-    : columnCount_(PQnfields(data))
-    , rowCount_(PQntuples(data))
-    , currentRow_(*result)
+  explicit Pimpl(PGresult* data, std::unique_ptr<ChunkSource> source, Result* result)
+    : source_(std::move(source))
+    , streaming_(source_ != nullptr)
     , data_(data)
-    , nextRowNumber(0) {
+    , columnCount_(PQnfields(data))
+    , rowCount_(PQntuples(data))
+    , currentRow_(*result) {
+  }
+
+  ~Pimpl() {
+    PQclear(data_);
+  }
+
+  /// @brief Move on to the next chunk that has rows. False once the statement is finished
+  bool loadNextChunk() {
+    while (source_) {
+      auto* next = static_cast<PGresult*>(source_->nextChunk());
+      if (next == nullptr) {
+        source_.reset();
+        return false;
+      }
+      PQclear(data_);
+      data_ = next;
+      rowCount_ = PQntuples(next);
+      nextRowNumber = 0;
+      if (rowCount_ > 0) {
+        return true;
+      }
+    }
+    return false;
   }
 
   const RowBase& nextRow() {
-    if (nextRowNumber >= rowCount_) {
+    if (nextRowNumber >= static_cast<RowCount>(rowCount_) && !loadNextChunk()) {
       return SentinelRow::instance();
     }
     nextRowNumber++;
+    rowsReturned_++;
     return currentRow_;
   }
+
+  static PGresult* firstChunk(ChunkSource& source) {
+    auto* first = static_cast<PGresult*>(source.nextChunk());
+    if (first == nullptr) {
+      throw ProtocolException("PostgreSQL finished the statement without sending a result");
+    }
+    return first;
+  }
 };
 
 SqlVariant Result::get(size_t index) const {
@@ -39,39 +101,97 @@ SqlVariant Result::get(size_t index) const {
   const char* binary_value = PQgetvalue(result, row_number_, pg_field_num);
   const int value_length = PQgetlength(result, row_number_, pg_field_num);
 
-  switch (pg_type) {
-    case INT2OID:
+  switch (kindOf(pg_type)) {
+    case SqlTypeKind::SMALLINT:
       return parseInt<int16_t>(binary_value);
-    case INT4OID:
+    case SqlTypeKind::INT:
       return parseInt<int32_t>(binary_value);
-    case INT8OID:
+    case SqlTypeKind::BIGINT:
       return parseInt<int64_t>(binary_value);
-    case FLOAT4OID:
+    case SqlTypeKind::REAL:
       return parseFloat<float>(binary_value);
-    case FLOAT8OID:
+    case SqlTypeKind::DOUBLE:
       return parseFloat<double>(binary_value);
-    case VARCHAROID:
-    case TEXTOID:
-    case JSONOID:
-      return SqlVariant(std::string(PQgetvalue(result, row_number_, pg_field_num)));
-    case NUMERICOID:
+    case SqlTypeKind::DECIMAL:
       return parseDecimal(binary_value, value_length);
+    default:
+      return SqlVariant(std::string(binary_value));
   }
-  throw InvalidTypeException("The OID '" + std::to_string(pg_type) + "' cannot be mapped to a type");
 }
 
 Result::Result(void* data)
-  : impl_(std::make_unique<Pimpl>(static_cast<PGresult*>(data), this)) {
+  : impl_(std::make_unique<Pimpl>(static_cast<PGresult*>(data), nullptr, this)) {
+}
+
+Result::Result(std::unique_ptr<ChunkSource> source) {
+  auto* first = Pimpl::firstChunk(*source);
+  impl_ = std::make_unique<Pimpl>(first, std::move(source), this);
 }
 
 Result::~Result() {
 }
 
-RowCount Result::rowCount() const { return impl_->rowCount_; }
+RowCount Result::rowCount() const { return impl_->streaming_ ? impl_->rowsReturned_ : impl_->rowCount_; }
 
 ColumnCount Result::columnCount() const { return impl_->columnCount_; }
 
 const RowBase& Result::nextRow() {
   return impl_->nextRow();
 }
+
+bool Result::nextBatch(ColumnBatch& batch, const size_t max_rows) {
+  batch.reset(columnCount());
+  if (impl_->nextRowNumber >= static_cast<RowCount>(impl_->rowCount_) && !impl_->loadNextChunk()) {
+    return false;
+  }
+  // A batch never spans chunks, streamed results may return fewer than `max_rows`
+  auto result = impl_->data_;
+  const int begin = static_cast<int>(impl_->nextRowNumber);
+  const int end = static_cast<int>(std::min<RowCount>(impl_->rowCount_, impl_->nextRowNumber + max_rows));
+  if (begin >= end) {
+    return false;
+  }
+  for (int field = 0; field < impl_->columnCount_; ++field) {
+    auto& column = batch.column(field);
+    column.reserve(end - begin);
+    const auto kind = kindOf(PQftype(result, field));
+    const auto copy = [&](auto append) {
+      column.setKind(kind);
+      for (int row = begin; row < end; ++row) {
+        if (PQgetisnull(result, row, field)) {
+          column.appendNull();
+          continue;
+        }
+        append(PQgetvalue(result, row, field), PQgetlength(result, row, field));
+      }
+    };
+    switch (kind) {
+      case SqlTypeKind::SMALLINT:
+        copy([&](const char* v, int) { column.appendInt(readInt<int16_t>(v)); });
+        break;
+      case SqlTypeKind::INT:
+        copy([&](const char* v, int) { column.appendInt(readInt<int32_t>(v)); });
+        break;
+      case SqlTypeKind::BIGINT:
+        copy([&](const char* v, int) { column.appendInt(readInt<int64_t>(v)); });
+        break;
+      case SqlTypeKind::REAL:
+        copy([&](const char* v, int) { column.appendDouble(readFloat<float>(v)); });
+        break;
+      case SqlTypeKind::DOUBLE:
+        copy([&](const char* v, int) { column.appendDouble(readFloat<double>(v)); });
+        break;
+      case SqlTypeKind::DECIMAL:
+        copy([&](const char* v, const int length) {
+          column.appendString(parseDecimal(v, length).get<SqlDecimal>().get());
+        });
+        break;
+      default:
+        copy([&](const char* v, const int length) { column.appendString(std::string_view(v, length)); });
+    }
+  }
+  impl_->nextRowNumber = end;
+  impl_->rowsReturned_ += end - begin;
+  return true;
+}
 }
@@ -3,6 +3,22 @@
 #include "row_base.h"
 
 namespace sql::postgresql {
+/**
+ * Source of the remaining chunks of a statement that libpq streams in chunked or single row mode
+ */
+class ChunkSource {
+public:
+  virtual ~ChunkSource() = default;
+  /// @brief Wait for the next `PGresult`, owned by the caller, or nullptr when the statement is finished
+  virtual void* nextChunk() = 0;
+};
+
+/**
+ * Result of a statement, either complete or streamed chunk by chunk.
+ *
+ * A streamed result holds only the current chunk in memory. Its `rowCount()` is the number of rows returned so far
+ * and only final once the result is drained.
+ */
 class Result : public ResultBase {
   class Pimpl;
   std::unique_ptr<Pimpl> impl_;
@@ -11,11 +27,13 @@ class Result : public ResultBase {
 
 public:
   explicit Result(void* data);
+  explicit Result(std::unique_ptr<ChunkSource> source);
 
   ~Result() override;
 
   RowCount rowCount() const override;;
   ColumnCount columnCount() const override;;
+  bool nextBatch(ColumnBatch& batch, size_t max_rows = DEFAULT_BATCH_ROWS) override;
 
 protected:
   void reset() override {
@@ -9,297 +9,439 @@ SET xmloption = content;
 SET client_min_messages = warning;
 SET row_security = off;
 
+-- Primary keys
 DO $$
 BEGIN
-    -- Primary keys
     IF to_regclass('job.aka_name') IS NOT NULL
        AND NOT EXISTS (SELECT 1 FROM pg_constraint WHERE conname = 'dbprove_pk_aka_name') THEN
         ALTER TABLE job.aka_name ADD CONSTRAINT dbprove_pk_aka_name PRIMARY KEY (id);
     END IF;
+END $$;
 
+DO $$
+BEGIN
     IF to_regclass('job.aka_title') IS NOT NULL
        AND NOT EXISTS (SELECT 1 FROM pg_constraint WHERE conname = 'dbprove_pk_aka_title') THEN
         ALTER TABLE job.aka_title ADD CONSTRAINT dbprove_pk_aka_title PRIMARY KEY (id);
     END IF;
+END $$;
 
+DO $$
+BEGIN
     IF to_regclass('job.cast_info') IS NOT NULL
        AND NOT EXISTS (SELECT 1 FROM pg_constraint WHERE conname = 'dbprove_pk_cast_info') THEN
         ALTER TABLE job.cast_info ADD CONSTRAINT dbprove_pk_cast_info PRIMARY KEY (id);
     END IF;
+END $$;
 
+DO $$
+BEGIN
     IF to_regclass('job.char_name') IS NOT NULL
        AND NOT EXISTS (SELECT 1 FROM pg_constraint WHERE conname = 'dbprove_pk_char_name') THEN
         ALTER TABLE job.char_name ADD CONSTRAINT dbprove_pk_char_name PRIMARY KEY (id);
     END IF;
+END $$;
 
+DO $$
+BEGIN
     IF to_regclass('job.comp_cast_type') IS NOT NULL
        AND NOT EXISTS (SELECT 1 FROM pg_constraint WHERE conname = 'dbprove_pk_comp_cast_type') THEN
         ALTER TABLE job.comp_cast_type ADD CONSTRAINT dbprove_pk_comp_cast_type PRIMARY KEY (id);
     END IF;
+END $$;
 
+DO $$
+BEGIN
     IF to_regclass('job.company_name') IS NOT NULL
        AND NOT EXISTS (SELECT 1 FROM pg_constraint WHERE conname = 'dbprove_pk_company_name') THEN
         ALTER TABLE job.company_name ADD CONSTRAINT dbprove_pk_company_name PRIMARY KEY (id);
     END IF;
+END $$;
 
+DO $$
+BEGIN
     IF to_regclass('job.company_type') IS NOT NULL
        AND NOT EXISTS (SELECT 1 FROM pg_constraint WHERE conname = 'dbprove_pk_company_type') THEN
         ALTER TABLE job.company_type ADD CONSTRAINT dbprove_pk_company_type PRIMARY KEY (id);
     END IF;
+END $$;
 
+DO $$
+BEGIN
     IF to_regclass('job.complete_cast') IS NOT NULL
        AND NOT EXISTS (SELECT 1 FROM pg_constraint WHERE conname = 'dbprove_pk_complete_cast') THEN
         ALTER TABLE job.complete_cast ADD CONSTRAINT dbprove_pk_complete_cast PRIMARY KEY (id);
     END IF;
+END $$;
 
+DO $$
+BEGIN
     IF to_regclass('job.info_type') IS NOT NULL
        AND NOT EXISTS (SELECT 1 FROM pg_constraint WHERE conname = 'dbprove_pk_info_type') THEN
         ALTER TABLE job.info_type ADD CONSTRAINT dbprove_pk_info_type PRIMARY KEY (id);
     END IF;
+END $$;
 
+DO $$
+BEGIN
     IF to_regclass('job.keyword') IS NOT NULL
        AND NOT EXISTS (SELECT 1 FROM pg_constraint WHERE conname = 'dbprove_pk_keyword') THEN
         ALTER TABLE job.keyword ADD CONSTRAINT dbprove_pk_keyword PRIMARY KEY (id);
     END IF;
+END $$;
 
+DO $$
+BEGIN
     IF to_regclass('job.kind_type') IS NOT NULL
        AND NOT EXISTS (SELECT 1 FROM pg_constraint WHERE conname = 'dbprove_pk_kind_type') THEN
         ALTER TABLE job.kind_type ADD CONSTRAINT dbprove_pk_kind_type PRIMARY KEY (id);
     END IF;
+END $$;
 
+DO $$
+BEGIN
     IF to_regclass('job.link_type') IS NOT NULL
        AND NOT EXISTS (SELECT 1 FROM pg_constraint WHERE conname = 'dbprove_pk_link_type') THEN
         ALTER TABLE job.link_type ADD CONSTRAINT dbprove_pk_link_type PRIMARY KEY (id);
     END IF;
+END $$;
 
+DO $$
+BEGIN
     IF to_regclass('job.movie_companies') IS NOT NULL
        AND NOT EXISTS (SELECT 1 FROM pg_constraint WHERE conname = 'dbprove_pk_movie_companies') THEN
         ALTER TABLE job.movie_companies ADD CONSTRAINT dbprove_pk_movie_companies PRIMARY KEY (id);
     END IF;
+END $$;
 
+DO $$
+BEGIN
     IF to_regclass('job.movie_info') IS NOT NULL
        AND NOT EXISTS (SELECT 1 FROM pg_constraint WHERE conname = 'dbprove_pk_movie_info') THEN
         ALTER TABLE job.movie_info ADD CONSTRAINT dbprove_pk_movie_info PRIMARY KEY (id);
     END IF;
+END $$;
 
+DO $$
+BEGIN
     IF to_regclass('job.movie_info_idx') IS NOT NULL
        AND NOT EXISTS (SELECT 1 FROM pg_constraint WHERE conname = 'dbprove_pk_movie_info_idx') THEN
         ALTER TABLE job.movie_info_idx ADD CONSTRAINT dbprove_pk_movie_info_idx PRIMARY KEY (id);
     END IF;
+END $$;
 
+DO $$
+BEGIN
     IF to_regclass('job.movie_keyword') IS NOT NULL
        AND NOT EXISTS (SELECT 1 FROM pg_constraint WHERE conname = 'dbprove_pk_movie_keyword') THEN
         ALTER TABLE job.movie_keyword ADD CONSTRAINT dbprove_pk_movie_keyword PRIMARY KEY (id);
     END IF;
+END $$;
 
+DO $$
+BEGIN
     IF to_regclass('job.movie_link') IS NOT NULL
        AND NOT EXISTS (SELECT 1 FROM pg_constraint WHERE conname = 'dbprove_pk_movie_link') THEN
         ALTER TABLE job.movie_link ADD CONSTRAINT dbprove_pk_movie_link PRIMARY KEY (id);
     END IF;
+END $$;
 
+DO $$
+BEGIN
     IF to_regclass('job.name') IS NOT NULL
        AND NOT EXISTS (SELECT 1 FROM pg_constraint WHERE conname = 'dbprove_pk_name') THEN
         ALTER TABLE job.name ADD CONSTRAINT dbprove_pk_name PRIMARY KEY (id);
     END IF;
+END $$;
 
+DO $$
+BEGIN
     IF to_regclass('job.person_info') IS NOT NULL
        AND NOT EXISTS (SELECT 1 FROM pg_constraint WHERE conname = 'dbprove_pk_person_info') THEN
         ALTER TABLE job.person_info ADD CONSTRAINT dbprove_pk_person_info PRIMARY KEY (id);
     END IF;
+END $$;
 
+DO $$
+BEGIN
     IF to_regclass('job.role_type') IS NOT NULL
        AND NOT EXISTS (SELECT 1 FROM pg_constraint WHERE conname = 'dbprove_pk_role_type') THEN
         ALTER TABLE job.role_type ADD CONSTRAINT dbprove_pk_role_type PRIMARY KEY (id);
     END IF;
+END $$;
 
+DO $$
+BEGIN
     IF to_regclass('job.title') IS NOT NULL
        AND NOT EXISTS (SELECT 1 FROM pg_constraint WHERE conname = 'dbprove_pk_title') THEN
         ALTER TABLE job.title ADD CONSTRAINT dbprove_pk_title PRIMARY KEY (id);
     END IF;
+END $$;
 
-    -- Foreign keys
+
+-- Foreign keys
+DO $$
+BEGIN
     IF to_regclass('job.aka_name') IS NOT NULL
        AND to_regclass('job.name') IS NOT NULL
        AND NOT EXISTS (SELECT 1 FROM pg_constraint WHERE conname = 'dbprove_fk_aka_name_name') THEN
         ALTER TABLE job.aka_name
             ADD CONSTRAINT dbprove_fk_aka_name_name FOREIGN KEY (person_id) REFERENCES job.name (id);
     END IF;
+END $$;
 
+DO $$
+BEGIN
     IF to_regclass('job.aka_title') IS NOT NULL
        AND to_regclass('job.title') IS NOT NULL
        AND NOT EXISTS (SELECT 1 FROM pg_constraint WHERE conname = 'dbprove_fk_aka_title_title') THEN
         ALTER TABLE job.aka_title
             ADD CONSTRAINT dbprove_fk_aka_title_title FOREIGN KEY (movie_id) REFERENCES job.title (id);
     END IF;
+END $$;
 
+DO $$
+BEGIN
     IF to_regclass('job.aka_title') IS NOT NULL
        AND to_regclass('job.kind_type') IS NOT NULL
        AND NOT EXISTS (SELECT 1 FROM pg_constraint WHERE conname = 'dbprove_fk_aka_title_kind_type') THEN
         ALTER TABLE job.aka_title
             ADD CONSTRAINT dbprove_fk_aka_title_kind_type FOREIGN KEY (kind_id) REFERENCES job.kind_type (id);
     END IF;
+END $$;
 
+DO $$
+BEGIN
     IF to_regclass('job.aka_title') IS NOT NULL
        AND to_regclass('job.title') IS NOT NULL
        AND NOT EXISTS (SELECT 1 FROM pg_constraint WHERE conname = 'dbprove_fk_aka_title_episode_title') THEN
         ALTER TABLE job.aka_title
             ADD CONSTRAINT dbprove_fk_aka_title_episode_title FOREIGN KEY (episode_of_id) REFERENCES job.title (id);
     END IF;
+END $$;
 
+DO $$
+BEGIN
     IF to_regclass('job.cast_info') IS NOT NULL
        AND to_regclass('job.name') IS NOT NULL
        AND NOT EXISTS (SELECT 1 FROM pg_constraint WHERE conname = 'dbprove_fk_cast_info_name') THEN
         ALTER TABLE job.cast_info
             ADD CONSTRAINT dbprove_fk_cast_info_name FOREIGN KEY (person_id) REFERENCES job.name (id);
     END IF;
+END $$;
 
+DO $$
+BEGIN
     IF to_regclass('job.cast_info') IS NOT NULL
        AND to_regclass('job.title') IS NOT NULL
        AND NOT EXISTS (SELECT 1 FROM pg_constraint WHERE conname = 'dbprove_fk_cast_info_title') THEN
         ALTER TABLE job.cast_info
             ADD CONSTRAINT dbprove_fk_cast_info_title FOREIGN KEY (movie_id) REFERENCES job.title (id);
     END IF;
+END $$;
 
+DO $$
+BEGIN
     IF to_regclass('job.cast_info') IS NOT NULL
        AND to_regclass('job.char_name') IS NOT NULL
        AND NOT EXISTS (SELECT 1 FROM pg_constraint WHERE conname = 'dbprove_fk_cast_info_char_name') THEN
         ALTER TABLE job.cast_info
             ADD CONSTRAINT dbprove_fk_cast_info_char_name FOREIGN KEY (person_role_id) REFERENCES job.char_name (id);
     END IF;
+END $$;
 
+DO $$
+BEGIN
     IF to_regclass('job.cast_info') IS NOT NULL
        AND to_regclass('job.role_type') IS NOT NULL
        AND NOT EXISTS (SELECT 1 FROM pg_constraint WHERE conname = 'dbprove_fk_cast_info_role_type') THEN
         ALTER TABLE job.cast_info
             ADD CONSTRAINT dbprove_fk_cast_info_role_type FOREIGN KEY (role_id) REFERENCES job.role_type (id);
     END IF;
+END $$;
 
+DO $$
+BEGIN
     IF to_regclass('job.complete_cast') IS NOT NULL
        AND to_regclass('job.title') IS NOT NULL
        AND NOT EXISTS (SELECT 1 FROM pg_constraint WHERE conname = 'dbprove_fk_complete_cast_title') THEN
         ALTER TABLE job.complete_cast
             ADD CONSTRAINT dbprove_fk_complete_cast_title FOREIGN KEY (movie_id) REFERENCES job.title (id);
     END IF;
+END $$;
 
+DO $$
+BEGIN
     IF to_regclass('job.complete_cast') IS NOT NULL
        AND to_regclass('job.comp_cast_type') IS NOT NULL
        AND NOT EXISTS (SELECT 1 FROM pg_constraint WHERE conname = 'dbprove_fk_complete_cast_subject_type') THEN
         ALTER TABLE job.complete_cast
             ADD CONSTRAINT dbprove_fk_complete_cast_subject_type FOREIGN KEY (subject_id) REFERENCES job.comp_cast_type (id);
     END IF;
+END $$;
 
+DO $$
+BEGIN
     IF to_regclass('job.complete_cast') IS NOT NULL
        AND to_regclass('job.comp_cast_type') IS NOT NULL
        AND NOT EXISTS (SELECT 1 FROM pg_constraint WHERE conname = 'dbprove_fk_complete_cast_status_type') THEN
         ALTER TABLE job.complete_cast
             ADD CONSTRAINT dbprove_fk_complete_cast_status_type FOREIGN KEY (status_id) REFERENCES job.comp_cast_type (id);
     END IF;
+END $$;
 
+DO $$
+BEGIN
     IF to_regclass('job.movie_companies') IS NOT NULL
        AND to_regclass('job.title') IS NOT NULL
        AND NOT EXISTS (SELECT 1 FROM pg_constraint WHERE conname = 'dbprove_fk_movie_companies_title') THEN
         ALTER TABLE job.movie_companies
             ADD CONSTRAINT dbprove_fk_movie_companies_title FOREIGN KEY (movie_id) REFERENCES job.title (id);
     END IF;
+END $$;
 
+DO $$
+BEGIN
     IF to_regclass('job.movie_companies') IS NOT NULL
        AND to_regclass('job.company_name') IS NOT NULL
        AND NOT EXISTS (SELECT 1 FROM pg_constraint WHERE conname = 'dbprove_fk_movie_companies_company_name') THEN
         ALTER TABLE job.movie_companies
             ADD CONSTRAINT dbprove_fk_movie_companies_company_name FOREIGN KEY (company_id) REFERENCES job.company_name (id);
     END IF;
+END $$;
 
+DO $$
+BEGIN
     IF to_regclass('job.movie_companies') IS NOT NULL
        AND to_regclass('job.company_type') IS NOT NULL
        AND NOT EXISTS (SELECT 1 FROM pg_constraint WHERE conname = 'dbprove_fk_movie_companies_company_type') THEN
         ALTER TABLE job.movie_companies
             ADD CONSTRAINT dbprove_fk_movie_companies_company_type FOREIGN KEY (company_type_id) REFERENCES job.company_type (id);
     END IF;
+END $$;
 
+DO $$
+BEGIN
     IF to_regclass('job.movie_info') IS NOT NULL
        AND to_regclass('job.title') IS NOT NULL
        AND NOT EXISTS (SELECT 1 FROM pg_constraint WHERE conname = 'dbprove_fk_movie_info_title') THEN
         ALTER TABLE job.movie_info
             ADD CONSTRAINT dbprove_fk_movie_info_title FOREIGN KEY (movie_id) REFERENCES job.title (id);
     END IF;
+END $$;
 
+DO $$
+BEGIN
     IF to_regclass('job.movie_info') IS NOT NULL
        AND to_regclass('job.info_type') IS NOT NULL
        AND NOT EXISTS (SELECT 1 FROM pg_constraint WHERE conname = 'dbprove_fk_movie_info_info_type') THEN
         ALTER TABLE job.movie_info
             ADD CONSTRAINT dbprove_fk_movie_info_info_type FOREIGN KEY (info_type_id) REFERENCES job.info_type (id);
     END IF;
+END $$;
 
+DO $$
+BEGIN
     IF to_regclass('job.movie_info_idx') IS NOT NULL
        AND to_regclass('job.title') IS NOT NULL
        AND NOT EXISTS (SELECT 1 FROM pg_constraint WHERE conname = 'dbprove_fk_movie_info_idx_title') THEN
         ALTER TABLE job.movie_info_idx
             ADD CONSTRAINT dbprove_fk_movie_info_idx_title FOREIGN KEY (movie_id) REFERENCES job.title (id);
     END IF;
+END $$;
 
+DO $$
+BEGIN
     IF to_regclass('job.movie_info_idx') IS NOT NULL
        AND to_regclass('job.info_type') IS NOT NULL
        AND NOT EXISTS (SELECT 1 FROM pg_constraint WHERE conname = 'dbprove_fk_movie_info_idx_info_type') THEN
         ALTER TABLE job.movie_info_idx
             ADD CONSTRAINT dbprove_fk_movie_info_idx_info_type FOREIGN KEY (info_type_id) REFERENCES job.info_type (id);
     END IF;
+END $$;
 
+DO $$
+BEGIN
     IF to_regclass('job.movie_keyword') IS NOT NULL
        AND to_regclass('job.title') IS NOT NULL
        AND NOT EXISTS (SELECT 1 FROM pg_constraint WHERE conname = 'dbprove_fk_movie_keyword_title') THEN
         ALTER TABLE job.movie_keyword
             ADD CONSTRAINT dbprove_fk_movie_keyword_title FOREIGN KEY (movie_id) REFERENCES job.title (id);
     END IF;
+END $$;
 
+DO $$
+BEGIN
     IF to_regclass('job.movie_keyword') IS NOT NULL
        AND to_regclass('job.keyword') IS NOT NULL
        AND NOT EXISTS (SELECT 1 FROM pg_constraint WHERE conname = 'dbprove_fk_movie_keyword_keyword') THEN
         ALTER TABLE job.movie_keyword
             ADD CONSTRAINT dbprove_fk_movie_keyword_keyword FOREIGN KEY (keyword_id) REFERENCES job.keyword (id);
     END IF;
+END $$;
 
+DO $$
+BEGIN
     IF to_regclass('job.movie_link') IS NOT NULL
        AND to_regclass('job.title') IS NOT NULL
        AND NOT EXISTS (SELECT 1 FROM pg_constraint WHERE conname = 'dbprove_fk_movie_link_title') THEN
         ALTER TABLE job.movie_link
             ADD CONSTRAINT dbprove_fk_movie_link_title FOREIGN KEY (movie_id) REFERENCES job.title (id);
     END IF;
+END $$;
 
+DO $$
+BEGIN
     IF to_regclass('job.movie_link') IS NOT NULL
        AND to_regclass('job.title') IS NOT NULL
        AND NOT EXISTS (SELECT 1 FROM pg_constraint WHERE conname = 'dbprove_fk_movie_link_linked_title') THEN
         ALTER TABLE job.movie_link
             ADD CONSTRAINT dbprove_fk_movie_link_linked_title FOREIGN KEY (linked_movie_id) REFERENCES job.title (id);
     END IF;
+END $$;
 
+DO $$
+BEGIN
     IF to_regclass('job.movie_link') IS NOT NULL
        AND to_regclass('job.link_type') IS NOT NULL
        AND NOT EXISTS (SELECT 1 FROM pg_constraint WHERE conname = 'dbprove_fk_movie_link_link_type') THEN
         ALTER TABLE job.movie_link
             ADD CONSTRAINT dbprove_fk_movie_link_link_type FOREIGN KEY (link_type_id) REFERENCES job.link_type (id);
     END IF;
+END $$;
 
+DO $$
+BEGIN
     IF to_regclass('job.person_info') IS NOT NULL
        AND to_regclass('job.name') IS NOT NULL
        AND NOT EXISTS (SELECT 1 FROM pg_constraint WHERE conname = 'dbprove_fk_person_info_name') THEN
         ALTER TABLE job.person_info
             ADD CONSTRAINT dbprove_fk_person_info_name FOREIGN KEY (person_id) REFERENCES job.name (id);
     END IF;
+END $$;
 
+DO $$
+BEGIN
     IF to_regclass('job.person_info') IS NOT NULL
        AND to_regclass('job.info_type') IS NOT NULL
        AND NOT EXISTS (SELECT 1 FROM pg_constraint WHERE conname = 'dbprove_fk_person_info_info_type') THEN
         ALTER TABLE job.person_info
             ADD CONSTRAINT dbprove_fk_person_info_info_type FOREIGN KEY (info_type_id) REFERENCES job.info_type (id);
     END IF;
+END $$;
 
+DO $$
+BEGIN
     IF to_regclass('job.title') IS NOT NULL
        AND to_regclass('job.kind_type') IS NOT NULL
        AND NOT EXISTS (SELECT 1 FROM pg_constraint WHERE conname = 'dbprove_fk_title_kind_type') THEN
         ALTER TABLE job.title
             ADD CONSTRAINT dbprove_fk_title_kind_type FOREIGN KEY (kind_id) REFERENCES job.kind_type (id);
     END IF;
+END $$;
 
+DO $$
+BEGIN
     IF to_regclass('job.title') IS NOT NULL
        AND to_regclass('job.title') IS NOT NULL
        AND NOT EXISTS (SELECT 1 FROM pg_constraint WHERE conname = 'dbprove_fk_title_episode_title') THEN
@@ -332,21 +474,87 @@ CREATE INDEX IF NOT EXISTS person_id_person_info ON job.person_info(person_id);
 CREATE INDEX IF NOT EXISTS person_role_id_cast_info ON job.cast_info(person_role_id);
 CREATE INDEX IF NOT EXISTS role_id_cast_info ON job.cast_info(role_id);
 
-DO $$
-DECLARE
-    rec RECORD;
-BEGIN
-    -- Refresh planner stats when they are missing or stale after loading/tuning.
-    FOR rec IN
-        SELECT
-            format('%I.%I', st.schemaname, st.relname) AS qualified_name
-        FROM pg_stat_all_tables st
-        WHERE st.schemaname = 'job'
-          AND (
-              COALESCE(st.last_analyze, st.last_autoanalyze) IS NULL
-              OR st.n_mod_since_analyze > 0
-          )
-    LOOP
-        EXECUTE 'ANALYZE ' || rec.qualified_name;
-    END LOOP;
-END $$;
+-- Refresh planner stats when they are missing or stale after loading/tuning.
+DO $$ BEGIN IF (SELECT COALESCE(last_analyze, last_autoanalyze) IS NULL OR n_mod_since_analyze > 0
+                FROM pg_stat_all_tables WHERE relid = to_regclass('job.aka_name'))
+    THEN ANALYZE job.aka_name; END IF; END $$;
+
+DO $$ BEGIN IF (SELECT COALESCE(last_analyze, last_autoanalyze) IS NULL OR n_mod_since_analyze > 0
+                FROM pg_stat_all_tables WHERE relid = to_regclass('job.aka_title'))
+    THEN ANALYZE job.aka_title; END IF; END $$;
+
+DO $$ BEGIN IF (SELECT COALESCE(last_analyze, last_autoanalyze) IS NULL OR n_mod_since_analyze > 0
+                FROM pg_stat_all_tables WHERE relid = to_regclass('job.cast_info'))
+    THEN ANALYZE job.cast_info; END IF; END $$;
+
+DO $$ BEGIN IF (SELECT COALESCE(last_analyze, last_autoanalyze) IS NULL OR n_mod_since_analyze > 0
+                FROM pg_stat_all_tables WHERE relid = to_regclass('job.char_name'))
+    THEN ANALYZE job.char_name; END IF; END $$;
+
+DO $$ BEGIN IF (SELECT COALESCE(last_analyze, last_autoanalyze) IS NULL OR n_mod_since_analyze > 0
+                FROM pg_stat_all_tables WHERE relid = to_regclass('job.comp_cast_type'))
+    THEN ANALYZE job.comp_cast_type; END IF; END $$;
+
+DO $$ BEGIN IF (SELECT COALESCE(last_analyze, last_autoanalyze) IS NULL OR n_mod_since_analyze > 0
+                FROM pg_stat_all_tables WHERE relid = to_regclass('job.company_name'))
+    THEN ANALYZE job.company_name; END IF; END $$;
+
+DO $$ BEGIN IF (SELECT COALESCE(last_analyze, last_autoanalyze) IS NULL OR n_mod_since_analyze > 0
+                FROM pg_stat_all_tables WHERE relid = to_regclass('job.company_type'))
+    THEN ANALYZE job.company_type; END IF; END $$;
+
+DO $$ BEGIN IF (SELECT COALESCE(last_analyze, last_autoanalyze) IS NULL OR n_mod_since_analyze > 0
+                FROM pg_stat_all_tables WHERE relid = to_regclass('job.complete_cast'))
+    THEN ANALYZE job.complete_cast; END IF; END $$;
+
+DO $$ BEGIN IF (SELECT COALESCE(last_analyze, last_autoanalyze) IS NULL OR n_mod_since_analyze > 0
+                FROM pg_stat_all_tables WHERE relid = to_regclass('job.info_type'))
+    THEN ANALYZE job.info_type; END IF; END $$;
+
+DO $$ BEGIN IF (SELECT COALESCE(last_analyze, last_autoanalyze) IS NULL OR n_mod_since_analyze > 0
+                FROM pg_stat_all_tables WHERE relid = to_regclass('job.keyword'))
+    THEN ANALYZE job.keyword; END IF; END $$;
+
+DO $$ BEGIN IF (SELECT COALESCE(last_analyze, last_autoanalyze) IS NULL OR n_mod_since_analyze > 0
+                FROM pg_stat_all_tables WHERE relid = to_regclass('job.kind_type'))
+    THEN ANALYZE job.kind_type; END IF; END $$;
+
+DO $$ BEGIN IF (SELECT COALESCE(last_analyze, last_autoanalyze) IS NULL OR n_mod_since_analyze > 0
+                FROM pg_stat_all_tables WHERE relid = to_regclass('job.link_type'))
+    THEN ANALYZE job.link_type; END IF; END $$;
+
+DO $$ BEGIN IF (SELECT COALESCE(last_analyze, last_autoanalyze) IS NULL OR n_mod_since_analyze > 0
+                FROM pg_stat_all_tables WHERE relid = to_regclass('job.movie_companies'))
+    THEN ANALYZE job.movie_companies; END IF; END $$;
+
+DO $$ BEGIN IF (SELECT COALESCE(last_analyze, last_autoanalyze) IS NULL OR n_mod_since_analyze > 0
+                FROM pg_stat_all_tables WHERE relid = to_regclass('job.movie_info'))
+    THEN ANALYZE job.movie_info; END IF; END $$;
+
+DO $$ BEGIN IF (SELECT COALESCE(last_analyze, last_autoanalyze) IS NULL OR n_mod_since_analyze > 0
+                FROM pg_stat_all_tables WHERE relid = to_regclass('job.movie_info_idx'))
+    THEN ANALYZE job.movie_info_idx; END IF; END $$;
+
+DO $$ BEGIN IF (SELECT COALESCE(last_analyze, last_autoanalyze) IS NULL OR n_mod_since_analyze > 0
+                FROM pg_stat_all_tables WHERE relid = to_regclass('job.movie_keyword'))
+    THEN ANALYZE job.movie_keyword; END IF; END $$;
+
+DO $$ BEGIN IF (SELECT COALESCE(last_analyze, last_autoanalyze) IS NULL OR n_mod_since_analyze > 0
+                FROM pg_stat_all_tables WHERE relid = to_regclass('job.movie_link'))
+    THEN ANALYZE job.movie_link; END IF; END $$;
+
+DO $$ BEGIN IF (SELECT COALESCE(last_analyze, last_autoanalyze) IS NULL OR n_mod_since_analyze > 0
+                FROM pg_stat_all_tables WHERE relid = to_regclass('job.name'))
+    THEN ANALYZE job.name; END IF; END $$;
+
+DO $$ BEGIN IF (SELECT COALESCE(last_analyze, last_autoanalyze) IS NULL OR n_mod_since_analyze > 0
+                FROM pg_stat_all_tables WHERE relid = to_regclass('job.person_info'))
+    THEN ANALYZE job.person_info; END IF; END $$;
+
+DO $$ BEGIN IF (SELECT COALESCE(last_analyze, last_autoanalyze) IS NULL OR n_mod_since_analyze > 0
+                FROM pg_stat_all_tables WHERE relid = to_regclass('job.role_type'))
+    THEN ANALYZE job.role_type; END IF; END $$;
+
+DO $$ BEGIN IF (SELECT COALESCE(last_analyze, last_autoanalyze) IS NULL OR n_mod_since_analyze > 0
+                FROM pg_stat_all_tables WHERE relid = to_regclass('job.title'))
+    THEN ANALYZE job.title; END IF; END $$;
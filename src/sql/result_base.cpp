@@ -18,18 +18,61 @@ SqlTypeKind ResultBase::columnType(const size_t index) const {
 }
 
 void ResultBase::drain() {
-  for (auto& _ : rows()) {
+  reset();
+  ColumnBatch batch;
+  while (nextBatch(batch)) {
     // Do nothing
   }
 }
 
+bool ResultBase::nextBatch(ColumnBatch& batch, const size_t max_rows) {
+  batch.reset(columnCount());
+  size_t rows = 0;
+  while (rows < max_rows) {
+    const auto& row = nextRow();
+    if (row.isSentinel()) {
+      break;
+    }
+    for (size_t i = 0; i < batch.columnCount(); ++i) {
+      batch.column(i).append(row.asVariant(i));
+    }
+    ++rows;
+  }
+  return rows > 0;
+}
+
+std::unique_ptr<ResultBase> ResultBase::materialise() {
+  std::vector<std::unique_ptr<MaterialisedRow>> rows;
+  for (const auto& row : this->rows()) {
+    rows.push_back(row.materialise());
+  }
+  return std::make_unique<MaterialisedResult>(std::move(rows), columnCount(), columnTypes_);
+}
+
+MaterialisedResult::MaterialisedResult(std::vector<std::unique_ptr<MaterialisedRow>> rows,
+                                       const ColumnCount column_count, std::vector<SqlTypeKind> column_types)
+  : rows_(std::move(rows))
+  , column_count_(column_count) {
+  columnTypes_ = std::move(column_types);
+}
+
+const RowBase& MaterialisedResult::nextRow() {
+  if (next_row_ >= rows_.size()) {
+    return SentinelRow::instance();
+  }
+  return *rows_[next_row_++];
+}
+
 std::string ResultBase::dump()
 {
-  std::string out = "Total Rows: " + std::to_string(rowCount()) + "\n";
+  // Streaming results only know their row count once read, so it is counted here and printed last
+  std::string out;
+  RowCount row_count = 0;
   for (const auto& r : rows()) {
-    std::string rowDump = r.dump();
-    out += rowDump;
+    out += r.dump();
+    ++row_count;
   }
+  out += "Total Rows: " + std::to_string(row_count) + "\n";
   reset();
   return std::move(out);
 }
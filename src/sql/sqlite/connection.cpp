@@ -1,9 +1,219 @@
 #include "connection.h"
 #include "result.h"
 #include "sql_exceptions.h"
+#include <dbprove/sql/column_batch.h>
 #include <sqlite3.h>
 
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <fstream>
+#include <mutex>
+#include <plog/Log.h>
+#include <thread>
+
 namespace sql::sqlite {
+namespace {
+constexpr size_t load_batch_rows = 8192;
+constexpr size_t load_queue_depth = 4;
+
+/**
+ * Bounded hand-off of parsed batches from the parser thread to the insert loop.
+ * Consumed batches go back to the parser so their buffers are reused.
+ */
+class BatchQueue {
+  std::mutex mutex_;
+  std::condition_variable changed_;
+  std::deque<std::unique_ptr<ColumnBatch>> full_;
+  std::vector<std::unique_ptr<ColumnBatch>> free_;
+  bool done_ = false;
+  bool cancelled_ = false;
+  std::exception_ptr error_;
+
+public:
+  BatchQueue() {
+    for (size_t i = 0; i < load_queue_depth; ++i) {
+      free_.push_back(std::make_unique<ColumnBatch>());
+    }
+  }
+
+  /// @brief Parser side: get an empty batch, or nullptr if the consumer gave up
+  std::unique_ptr<ColumnBatch> acquire() {
+    std::unique_lock lock(mutex_);
+    changed_.wait(lock, [this] { return !free_.empty() || cancelled_; });
+    if (cancelled_) {
+      return nullptr;
+    }
+    auto batch = std::move(free_.back());
+    free_.pop_back();
+    return batch;
+  }
+
+  void push(std::unique_ptr<ColumnBatch> batch) {
+    {
+      std::lock_guard lock(mutex_);
+      full_.push_back(std::move(batch));
+    }
+    changed_.notify_all();
+  }
+
+  void finish(std::exception_ptr error = nullptr) {
+    {
+      std::lock_guard lock(mutex_);
+      done_ = true;
+      error_ = std::move(error);
+    }
+    changed_.notify_all();
+  }
+
+  /// @brief Insert side: next parsed batch, or nullptr once the parser is done
+  std::unique_ptr<ColumnBatch> pop() {
+    std::unique_lock lock(mutex_);
+    changed_.wait(lock, [this] { return !full_.empty() || done_; });
+    if (!full_.empty()) {
+      auto batch = std::move(full_.front());
+      full_.pop_front();
+      return batch;
+    }
+    if (error_) {
+      std::rethrow_exception(error_);
+    }
+    return nullptr;
+  }
+
+  void recycle(std::unique_ptr<ColumnBatch> batch) {
+    {
+      std::lock_guard lock(mutex_);
+      free_.push_back(std::move(batch));
+    }
+    changed_.notify_all();
+  }
+
+  void cancel() {
+    {
+      std::lock_guard lock(mutex_);
+      cancelled_ = true;
+    }
+    changed_.notify_all();
+  }
+};
+
+/**
+ * Parse pipe-delimited CSV files with a header row into batches of text columns.
+ * Quoted fields may hold the delimiter, newlines and doubled quotes. An empty unquoted field is NULL.
+ */
+void parseCsv(const std::vector<std::filesystem::path>& source_paths, const ColumnCount column_count,
+              BatchQueue& queue) {
+  constexpr size_t buffer_size = 1024 * 1024;
+  const auto buffer = std::make_unique<char[]>(buffer_size);
+  auto batch = queue.acquire();
+  if (!batch) {
+    return;
+  }
+  batch->reset(column_count);
+  std::string field;
+
+  for (const auto& path : source_paths) {
+    std::ifstream file(path.string(), std::ios::binary);
+    if (!file.is_open()) {
+      throw std::ios_base::failure("Failed to open source file: " + path.string());
+    }
+    bool header = true;
+    bool in_quotes = false;
+    bool was_quoted = false;
+    bool quote_pending = false;
+    size_t column = 0;
+    size_t line = 1;
+
+    const auto endField = [&] {
+      if (!header) {
+        if (column >= column_count) {
+          throw BulkException(path.string() + ":" + std::to_string(line) + " has more than " +
+                              std::to_string(column_count) + " fields");
+        }
+        if (field.empty() && !was_quoted) {
+          batch->column(column).appendNull();
+        } else {
+          batch->column(column).appendString(field);
+        }
+      }
+      ++column;
+      field.clear();
+      was_quoted = false;
+    };
+    const auto endRow = [&] {
+      endField();
+      if (!header && column != column_count) {
+        throw BulkException(path.string() + ":" + std::to_string(line) + " has " + std::to_string(column) +
+                            " fields, expected " + std::to_string(column_count));
+      }
+      header = false;
+      column = 0;
+      ++line;
+      if (batch->rowCount() >= load_batch_rows) {
+        queue.push(std::move(batch));
+        batch = queue.acquire();
+        if (!batch) {
+          return false;
+        }
+        batch->reset(column_count);
+      }
+      return true;
+    };
+
+    while (file) {
+      file.read(buffer.get(), buffer_size);
+      const auto n = static_cast<size_t>(file.gcount());
+      for (size_t i = 0; i < n; ++i) {
+        const char c = buffer[i];
+        if (quote_pending) {
+          quote_pending = false;
+          if (c == '"') {
+            field.push_back('"');
+            continue;
+          }
+          in_quotes = false;
+        }
+        if (in_quotes) {
+          if (c == '"') {
+            quote_pending = true;
+          } else {
+            field.push_back(c);
+          }
+          continue;
+        }
+        switch (c) {
+          case '"':
+            in_quotes = true;
+            was_quoted = true;
+            break;
+          case '|':
+            endField();
+            break;
+          case '\n':
+            if (!endRow()) {
+              return;
+            }
+            break;
+          case '\r':
+            break;
+          default:
+            field.push_back(c);
+        }
+      }
+    }
+    if (column > 0 || !field.empty() || was_quoted) {
+      if (!endRow()) {
+        return;
+      }
+    }
+  }
+  if (batch->rowCount() > 0) {
+    queue.push(std::move(batch));
+  }
+}
+}
+
 class Connection::Pimpl {
 public:
   sqlite3* db = nullptr;
@@ -43,10 +253,60 @@ public:
     check_return(results, error_message);
   }
 
-  std::unique_ptr<Result> execute(const std::string_view statement) const {
+  void check_db(const int ret) const {
+    if (ret != SQLITE_OK && ret != SQLITE_DONE && ret != SQLITE_ROW) {
+      throw Exception(SqlState::INVALID, std::string(sqlite3_errmsg(db)));
+    }
+  }
+
+  sqlite3_stmt* prepare(const std::string_view statement) const {
+    check_connection_open();
     sqlite3_stmt* stmt = nullptr;
-    check_return(sqlite3_prepare_v2(db, statement.data(), -1, &stmt, nullptr), nullptr);
-    return std::make_unique<Result>(stmt);
+    check_db(sqlite3_prepare_v2(db, statement.data(), static_cast<int>(statement.size()), &stmt, nullptr));
+    return stmt;
+  }
+
+  std::unique_ptr<Result> execute(const std::string_view statement) const {
+    return std::make_unique<Result>(prepare(statement));
+  }
+
+  /**
+   * Insert every parsed row through one prepared statement. Fields are bound as text and SQLite's column
+   * affinity converts them to the declared type.
+   */
+  RowCount insertBatches(const std::string_view table, const ColumnCount column_count, BatchQueue& queue) const {
+    std::string insert = "INSERT INTO " + std::string(table) + " VALUES (";
+    for (ColumnCount i = 0; i < column_count; ++i) {
+      insert += i == 0 ? "?" : ", ?";
+    }
+    insert += ")";
+    sqlite3_stmt* stmt = prepare(insert);
+    RowCount rows = 0;
+    try {
+      while (auto batch = queue.pop()) {
+        for (RowCount row = 0; row < batch->rowCount(); ++row) {
+          for (ColumnCount i = 0; i < column_count; ++i) {
+            const auto& column = batch->column(i);
+            const int index = static_cast<int>(i) + 1;
+            if (column.isNull(row)) {
+              sqlite3_bind_null(stmt, index);
+            } else {
+              const auto value = column.string(row);
+              sqlite3_bind_text(stmt, index, value.data(), static_cast<int>(value.size()), SQLITE_STATIC);
+            }
+          }
+          check_db(sqlite3_step(stmt));
+          sqlite3_reset(stmt);
+        }
+        rows += batch->rowCount();
+        queue.recycle(std::move(batch));
+      }
+    } catch (...) {
+      sqlite3_finalize(stmt);
+      throw;
+    }
+    sqlite3_finalize(stmt);
+    return rows;
   }
 
   void close() {
@@ -80,6 +340,66 @@ std::unique_ptr<ResultBase> Connection::fetchAll(const std::string_view statemen
 
 void Connection::bulkLoad(const std::string_view table, const std::vector<std::filesystem::path> source_paths) {
   validateSourcePaths(source_paths);
+  const auto start = std::chrono::steady_clock::now();
+
+  ColumnCount column_count;
+  {
+    const Result probe(impl_->prepare("SELECT * FROM " + std::string(table)));
+    column_count = probe.columnCount();
+  }
+
+  // Durability is pointless while loading a dataset we can regenerate. Restore the settings afterward
+  const auto journal_mode = fetchScalar("PRAGMA journal_mode").asString();
+  const auto synchronous = fetchScalar("PRAGMA synchronous").asInt8();
+  // Restores the settings however the load exits, including when ROLLBACK itself fails
+  struct RestorePragmas {
+    const Pimpl& impl;
+    const std::string journal_mode;
+    const int64_t synchronous;
+
+    ~RestorePragmas() {
+      try {
+        impl.executeRaw("PRAGMA journal_mode = " + journal_mode);
+        impl.executeRaw("PRAGMA synchronous = " + std::to_string(synchronous));
+      } catch (const std::exception& e) {
+        PLOGW << "Could not restore journal_mode and synchronous after bulk load: " << e.what();
+      }
+    }
+  };
+  impl_->executeRaw("PRAGMA journal_mode = MEMORY");
+  const RestorePragmas restore{*impl_, journal_mode, synchronous};
+  impl_->executeRaw("PRAGMA synchronous = OFF");
+
+  BatchQueue queue;
+  std::thread parser([&] {
+    try {
+      parseCsv(source_paths, column_count, queue);
+      queue.finish();
+    } catch (...) {
+      queue.finish(std::current_exception());
+    }
+  });
+
+  RowCount rows = 0;
+  try {
+    impl_->executeRaw("BEGIN");
+    rows = impl_->insertBatches(table, column_count, queue);
+    impl_->executeRaw("COMMIT");
+  } catch (...) {
+    queue.cancel();
+    parser.join();
+    try {
+      impl_->executeRaw("ROLLBACK");
+    } catch (const std::exception& e) {
+      PLOGW << "Rollback of bulk load into " << table << " failed: " << e.what();
+    }
+    throw;
+  }
+  parser.join();
+
+  const auto seconds = std::max(std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count(), 1e-6);
+  PLOGI << "Loaded " << table << ": " << rows << " rows in " << seconds << " s ("
+      << static_cast<double>(rows) / seconds << " rows/s)";
 }
 
 std::string Connection::version() {
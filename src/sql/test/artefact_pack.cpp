@@ -0,0 +1,56 @@
+#include <dbprove/sql/artefact_pack.h>
+#include <catch2/catch_test_macros.hpp>
+
+#include <fstream>
+
+namespace {
+std::filesystem::path freshDirectory(const std::string_view name) {
+  const auto directory = std::filesystem::temp_directory_path() / "dbprove_test" / std::string(name);
+  std::filesystem::remove_all(directory);
+  std::filesystem::create_directories(directory);
+  return directory;
+}
+}
+
+TEST_CASE("Artefact pack stores content once and survives reopening", "[artefact]") {
+  const auto directory = freshDirectory("artefact_pack_roundtrip");
+  {
+    sql::ArtefactPack pack(directory);
+    pack.put("q1.json", R"({"plan": 1})");
+    pack.put("q2.json", R"({"plan": 1})");
+    pack.put("q1.ast", "SelectQuery");
+    CHECK(pack.get("q1.json") == R"({"plan": 1})");
+    CHECK(pack.get("q2.json") == R"({"plan": 1})");
+    CHECK_FALSE(pack.get("q3.json").has_value());
+  }
+  CHECK(std::filesystem::file_size(directory / sql::ArtefactPack::pack_file_name) == 22);
+
+  sql::ArtefactPack reopened(directory);
+  CHECK(reopened.get("q1.ast") == "SelectQuery");
+  reopened.put("q1.json", R"({"plan": 2})");
+  CHECK(reopened.get("q1.json") == R"({"plan": 2})");
+  CHECK(reopened.get("q2.json") == R"({"plan": 1})");
+}
+
+TEST_CASE("Artefact pack compaction drops stale entries and imports loose files", "[artefact]") {
+  const auto directory = freshDirectory("artefact_pack_compact");
+  {
+    sql::ArtefactPack pack(directory);
+    pack.put("q1.json", "old");
+    pack.put("q1.json", "new");
+    pack.put("q2.json", "other");
+  }
+  std::ofstream(directory / "q3.txt") << "loose";
+
+  const auto stats = sql::ArtefactPack::compact(directory);
+  CHECK(stats.entries == 3);
+  CHECK(stats.stale_entries == 1);
+  CHECK(stats.imported_files == 1);
+  CHECK(stats.bytes_after < stats.bytes_before + 5);
+
+  std::filesystem::remove(directory / "q3.txt");
+  sql::ArtefactPack compacted(directory);
+  CHECK(compacted.get("q1.json") == "new");
+  CHECK(compacted.get("q2.json") == "other");
+  CHECK(compacted.get("q3.txt") == "loose");
+}
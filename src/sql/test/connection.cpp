@@ -61,6 +61,58 @@ TEST_CASE("Fetch Result", "[query]")
     }
 }
 
+TEST_CASE("Fetch Batch", "[query]")
+{
+    for (auto& factory : factories()) {
+        const auto connection = factory.create();
+        const auto r = connection->fetchAll(
+            "/* test_batch */ SELECT 1 AS i, 'a' AS s " "UNION ALL SELECT 2 AS i, 'bc' AS s "
+            "UNION ALL SELECT 3 AS i, NULL AS s " "ORDER BY i");
+        CAPTURE(connection->engine().name());
+        sql::ColumnBatch batch;
+        std::vector<int64_t> ints;
+        std::vector<std::string> strings;
+        while (r->nextBatch(batch, 2)) {
+            REQUIRE(batch.columnCount() == 2);
+            CHECK(batch.rowCount() <= 2);
+            const auto& i = batch.column(0);
+            const auto& s = batch.column(1);
+            for (size_t row = 0; row < batch.rowCount(); ++row) {
+                ints.push_back(i.ints()[row]);
+                strings.push_back(s.isNull(row) ? "NULL" : std::string(s.string(row)));
+            }
+        }
+        CHECK(ints == std::vector<int64_t>{1, 2, 3});
+        CHECK(strings == std::vector<std::string>{"a", "bc", "NULL"});
+    }
+}
+
+TEST_CASE("Execute Batch", "[query]")
+{
+    for (auto& factory : factories()) {
+        CAPTURE(factory.engine().name());
+        const auto connection = factory.create();
+        const std::vector<std::string_view> statements = {
+            "/* test_batch_1 */ SELECT 1 AS i",
+            "/* test_batch_missing */ SELECT i FROM dbprove_no_such_table",
+            "/* test_batch_2 */ SELECT 2 AS i"
+        };
+        auto results = connection->executeBatch(statements);
+        REQUIRE(results.size() == 3);
+        REQUIRE(results[0].result);
+        CHECK(results[1].error);
+        CHECK_FALSE(results[1].result);
+        REQUIRE(results[2].result);
+        for (const auto index : {0, 2}) {
+            int64_t value = 0;
+            for (const auto& row : results[index].result->rows()) {
+                value = row.asVariant(0).asInt8();
+            }
+            CHECK(value == index / 2 + 1);
+        }
+    }
+}
+
 TEST_CASE("Fetch Row", "[query]")
 {
     for (auto& factory : factories()) {
@@ -0,0 +1,71 @@
+#include <dbprove/sql/connection_pool.h>
+#include <catch2/catch_test_macros.hpp>
+
+#include <chrono>
+#include <thread>
+
+namespace {
+sql::ConnectionFactory utopiaFactory(const std::string& name) {
+  return sql::ConnectionFactory(sql::Engine(sql::Engine::Type::Utopia), sql::CredentialNone(name));
+}
+}
+
+TEST_CASE("Pooled connections are reused and shared by credential", "[connection][pool]") {
+  auto factory = utopiaFactory("pool_reuse");
+  factory.enablePooling(2);
+  const sql::ConnectionBase* first = nullptr;
+  {
+    const auto lease = factory.acquire();
+    first = lease.get();
+  }
+  {
+    const auto lease = factory.acquire();
+    CHECK(lease.get() == first);
+  }
+
+  auto same_credential = utopiaFactory("pool_reuse");
+  same_credential.enablePooling(1);
+  CHECK(same_credential.pool() == factory.pool());
+  CHECK(factory.pool()->maxSize() == 2);
+
+  const auto metrics = factory.pool()->metrics();
+  CHECK(metrics.connects == 1);
+  CHECK(metrics.acquires == 2);
+  CHECK(metrics.waits == 0);
+}
+
+TEST_CASE("Pool is bounded and prewarming grows it", "[connection][pool]") {
+  auto factory = utopiaFactory("pool_bound");
+  factory.enablePooling(1);
+  auto held = std::make_unique<sql::ConnectionLease>(factory.acquire());
+  std::thread waiter([&factory] {
+    const auto lease = factory.acquire();
+  });
+  const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+  while (factory.pool()->metrics().waiting == 0 && std::chrono::steady_clock::now() < deadline) {
+    std::this_thread::yield();
+  }
+  CHECK(factory.pool()->metrics().waiting == 1);
+  held.reset();
+  waiter.join();
+  CHECK(factory.pool()->metrics().waits == 1);
+  CHECK(factory.pool()->metrics().waiting == 0);
+  CHECK(factory.pool()->metrics().connects == 1);
+
+  factory.prewarm(3);
+  CHECK(factory.pool()->maxSize() == 3);
+  CHECK(factory.pool()->metrics().connects == 3);
+  {
+    const auto a = factory.acquire();
+    const auto b = factory.acquire();
+    const auto c = factory.acquire();
+  }
+  CHECK(factory.pool()->metrics().connects == 3);
+}
+
+TEST_CASE("Unpooled leases open a new connection every time", "[connection][pool]") {
+  auto factory = utopiaFactory("pool_none");
+  const auto lease = factory.acquire();
+  CHECK(lease.get() != nullptr);
+  CHECK(factory.pool() == nullptr);
+}
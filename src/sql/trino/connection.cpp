@@ -1,13 +1,14 @@
 #include "connection.h"
 
+#include "http_client.h"
 #include "include/dbprove/sql/parsed_table.h"
 #include "result.h"
 #include "sql_exceptions.h"
 
 #include <dbprove/common/string.h>
-#include <curl/curl.h>
 #include <nlohmann/json.hpp>
 
+#include <future>
 #include <optional>
 #include <plog/Log.h>
 #include <regex>
@@ -23,16 +24,6 @@ struct TrinoColumnMeta {
   std::string raw_type;
 };
 
-struct TrinoQueryResult {
-  std::vector<TrinoColumnMeta> columns;
-  std::vector<std::vector<SqlVariant>> rows;
-};
-
-size_t writeCallback(const char* ptr, const size_t size, const size_t nmemb, void* userdata) {
-  auto* buffer = static_cast<std::string*>(userdata);
-  buffer->append(ptr, size * nmemb);
-  return size * nmemb;
-}
 
 std::string extractRawType(const json& column_json) {
   if (column_json.contains("typeSignature") &&
@@ -120,23 +111,12 @@ std::string renderType(const SqlTypeMeta& type, const ConnectionBase::TypeMap& t
 }
 
 class Connection::Pimpl {
-  Connection& connection;
   const CredentialPassword credential_;
   bool closed_ = false;
 
-  static void ensureCurl() {
-    static const auto init = []() {
-      curl_global_init(CURL_GLOBAL_DEFAULT);
-      return true;
-    }();
-    (void)init;
-  }
-
 public:
-  explicit Pimpl(Connection& connection, CredentialPassword credential)
-    : connection(connection)
-    , credential_(std::move(credential)) {
-    ensureCurl();
+  explicit Pimpl(CredentialPassword credential)
+    : credential_(std::move(credential)) {
   }
 
   void ensureOpen() const {
@@ -215,88 +195,64 @@ public:
     return std::max<long>(1L, static_cast<long>(remaining));
   }
 
-  json httpRequest(std::string_view url,
-                   std::optional<std::string_view> body = std::nullopt,
-                   std::optional<std::chrono::steady_clock::time_point> deadline = std::nullopt) const {
-    ensureOpen();
-
-    auto* curl = curl_easy_init();
-    if (!curl) {
-      throw ConnectionException(credential_, "Failed to initialize curl for Trino");
-    }
+  [[nodiscard]] HttpRequest makeRequest(const std::string_view method, const std::string_view url) const {
+    HttpRequest request;
+    request.method = std::string(method);
+    request.url = std::string(url);
+    request.headers = {
+      "Accept: application/json",
+      "X-Trino-User: " + credential_.username,
+      "X-Trino-Catalog: " + credential_.database,
+      "X-Trino-Schema: " + currentSchema()
+    };
+    return request;
+  }
 
-    std::string response_body;
-    std::string request_body;
-    struct curl_slist* headers = nullptr;
-    headers = curl_slist_append(headers, "Accept: application/json");
-    headers = curl_slist_append(headers, ("X-Trino-User: " + credential_.username).c_str());
-    headers = curl_slist_append(headers, ("X-Trino-Catalog: " + credential_.database).c_str());
-    headers = curl_slist_append(headers, ("X-Trino-Schema: " + currentSchema()).c_str());
+  /// @brief Start a request on the shared HTTP client without waiting for the response
+  std::future<HttpResponse> sendRequest(std::string_view url,
+                                        std::optional<std::string_view> body = std::nullopt,
+                                        std::optional<std::chrono::steady_clock::time_point> deadline = std::nullopt)
+  const {
+    ensureOpen();
+    auto request = makeRequest(body.has_value() ? "POST" : "GET", url);
     if (body.has_value()) {
-      request_body = std::string(*body);
-      headers = curl_slist_append(headers, "Content-Type: text/plain; charset=utf-8");
-      curl_easy_setopt(curl, CURLOPT_POST, 1L);
-      curl_easy_setopt(curl, CURLOPT_POSTFIELDS, request_body.c_str());
-      curl_easy_setopt(curl, CURLOPT_POSTFIELDSIZE, request_body.size());
+      request.headers.emplace_back("Content-Type: text/plain; charset=utf-8");
+      request.body = std::string(*body);
     }
+    request.timeout_seconds = requestTimeoutSeconds(deadline);
+    return HttpClient::instance().send(std::move(request));
+  }
 
-    curl_easy_setopt(curl, CURLOPT_URL, std::string(url).c_str());
-    curl_easy_setopt(curl, CURLOPT_HTTPHEADER, headers);
-    curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, writeCallback);
-    curl_easy_setopt(curl, CURLOPT_WRITEDATA, &response_body);
-    curl_easy_setopt(curl, CURLOPT_FOLLOWLOCATION, 1L);
-    curl_easy_setopt(curl, CURLOPT_TIMEOUT, requestTimeoutSeconds(deadline));
-
-    const auto res = curl_easy_perform(curl);
-    long status_code = 0;
-    curl_easy_getinfo(curl, CURLINFO_RESPONSE_CODE, &status_code);
-    curl_slist_free_all(headers);
-    curl_easy_cleanup(curl);
-
-    if (res != CURLE_OK) {
-      throw ConnectionException(credential_, curl_easy_strerror(res));
+  json parseResponse(const HttpResponse& response) const {
+    if (response.curl_code != 0) {
+      throw ConnectionException(credential_, response.curl_error);
     }
-    if (status_code >= 400) {
-      throw ConnectionException(credential_, "Trino returned HTTP " + std::to_string(status_code) + ": " + response_body);
+    if (response.status_code >= 400) {
+      throw ConnectionException(credential_,
+                                "Trino returned HTTP " + std::to_string(response.status_code) + ": " + response.body);
     }
 
     try {
-      return json::parse(response_body);
+      return json::parse(response.body);
     } catch (const std::exception& e) {
       throw ProtocolException("Failed to parse Trino JSON response: " + std::string(e.what()));
     }
   }
 
-  void cancelQuery(std::string_view next_uri) const {
-    ensureOpen();
-
-    auto* curl = curl_easy_init();
-    if (!curl) {
-      return;
-    }
-
-    struct curl_slist* headers = nullptr;
-    headers = curl_slist_append(headers, "Accept: application/json");
-    headers = curl_slist_append(headers, ("X-Trino-User: " + credential_.username).c_str());
-    headers = curl_slist_append(headers, ("X-Trino-Catalog: " + credential_.database).c_str());
-    headers = curl_slist_append(headers, ("X-Trino-Schema: " + currentSchema()).c_str());
-
-    std::string response_body;
-    curl_easy_setopt(curl, CURLOPT_URL, std::string(next_uri).c_str());
-    curl_easy_setopt(curl, CURLOPT_CUSTOMREQUEST, "DELETE");
-    curl_easy_setopt(curl, CURLOPT_HTTPHEADER, headers);
-    curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, writeCallback);
-    curl_easy_setopt(curl, CURLOPT_WRITEDATA, &response_body);
-    curl_easy_setopt(curl, CURLOPT_FOLLOWLOCATION, 1L);
-    curl_easy_setopt(curl, CURLOPT_TIMEOUT, 5L);
+  json httpRequest(std::string_view url,
+                   std::optional<std::string_view> body = std::nullopt,
+                   std::optional<std::chrono::steady_clock::time_point> deadline = std::nullopt) const {
+    return parseResponse(sendRequest(url, body, deadline).get());
+  }
 
-    const auto res = curl_easy_perform(curl);
-    if (res != CURLE_OK) {
-      PLOGW << "Failed to cancel Trino query via " << next_uri << ": " << curl_easy_strerror(res);
+  /// @brief Cancel a query on the server. Also sent after `close()`, so a result outliving its connection can cancel
+  void cancelQuery(std::string_view next_uri) const {
+    auto request = makeRequest("DELETE", next_uri);
+    request.timeout_seconds = 5;
+    const auto response = HttpClient::instance().send(std::move(request)).get();
+    if (response.curl_code != 0) {
+      PLOGW << "Failed to cancel Trino query via " << next_uri << ": " << response.curl_error;
     }
-
-    curl_slist_free_all(headers);
-    curl_easy_cleanup(curl);
   }
 
   [[noreturn]] void throwTimeout(std::optional<std::string_view> cancel_uri, const uint32_t timeout_seconds) const {
@@ -342,79 +298,142 @@ public:
     return SqlVariant(jsonScalarAsString(value));
   }
 
-  TrinoQueryResult runStatement(std::string_view statement) const {
-    const auto rewritten = rewriteStatement(statement);
-    const auto timeout_seconds = connection.queryTimeoutSeconds();
-    const auto deadline = timeout_seconds.has_value()
-                            ? std::optional(std::chrono::steady_clock::now() + std::chrono::seconds(*timeout_seconds))
-                            : std::nullopt;
-
-    json page = httpRequest(baseUrl() + "/v1/statement", rewritten, deadline);
-
-    // Extract query ID from the initial response for reliable cancellation via /v1/query/{id}.
-    std::string query_id;
-    if (page.contains("id") && page["id"].is_string()) {
-      query_id = page["id"].get<std::string>();
+  /**
+   * A running statement that is read one page at a time by following `nextUri`.
+   *
+   * The request for the next page is sent as soon as a page arrives, so the server is already producing it while
+   * the caller decodes the current one. It shares the connection state, so a result that outlives its connection
+   * can still cancel the query.
+   */
+  class Statement final : public PageSource {
+    const std::shared_ptr<const Pimpl> pimpl_;
+    const std::string statement_;
+    const std::optional<uint32_t> timeout_seconds_;
+    const std::optional<std::chrono::steady_clock::time_point> deadline_;
+    std::string query_id_;
+    std::string cancel_uri_;
+    std::optional<json> pending_page_;
+    std::optional<std::string> next_uri_;
+    std::optional<std::future<HttpResponse>> next_request_;
+    std::vector<TrinoColumnMeta> columns_;
+
+    void cancelQuery() const {
+      if (!cancel_uri_.empty()) {
+        pimpl_->cancelQuery(cancel_uri_);
+      } else if (next_uri_.has_value()) {
+        pimpl_->cancelQuery(*next_uri_);
+      }
     }
 
-    const auto cancelCurrentQuery = [&]() {
-      if (!query_id.empty()) {
-        cancelQuery(baseUrl() + "/v1/query/" + query_id);
-      } else if (page.contains("nextUri") && !page["nextUri"].is_null()) {
-        cancelQuery(page["nextUri"].get<std::string>());
+    json fetchNextUri() {
+      try {
+        auto request = std::move(*next_request_);
+        next_request_.reset();
+        return pimpl_->parseResponse(request.get());
+      } catch (const ConnectionException& e) {
+        if (std::string_view(e.what()).find("Timeout was reached") != std::string_view::npos) {
+          cancelQuery();
+          if (timeout_seconds_.has_value()) {
+            pimpl_->throwTimeout(std::nullopt, *timeout_seconds_);
+          }
+        }
+        throw;
       }
-    };
+    }
 
-    TrinoQueryResult result;
-    while (true) {
-      if (deadline.has_value() && std::chrono::steady_clock::now() >= *deadline) {
-        cancelCurrentQuery();
-        throwTimeout(std::nullopt, *timeout_seconds);
+    Page decodeRows(const json& data) const {
+      Page rows;
+      rows.reserve(data.size());
+      for (const auto& row_json : data) {
+        std::vector<SqlVariant> row;
+        if (row_json.is_array()) {
+          row.reserve(row_json.size());
+          for (size_t i = 0; i < row_json.size(); ++i) {
+            const auto raw_type = i < columns_.size() ? columns_[i].raw_type : "unknown";
+            row.push_back(pimpl_->jsonValueToVariant(row_json[i], raw_type));
+          }
+        }
+        rows.push_back(std::move(row));
       }
+      return rows;
+    }
 
-      if (page.contains("error")) {
-        throwForError(page["error"], statement);
+  public:
+    Statement(std::shared_ptr<const Pimpl> pimpl, const std::string_view statement,
+              const std::optional<uint32_t> timeout_seconds)
+      : pimpl_(std::move(pimpl))
+      , statement_(statement)
+      , timeout_seconds_(timeout_seconds)
+      , deadline_(timeout_seconds_.has_value()
+                    ? std::optional(std::chrono::steady_clock::now() + std::chrono::seconds(*timeout_seconds_))
+                    : std::nullopt) {
+      pending_page_ = pimpl_->httpRequest(pimpl_->baseUrl() + "/v1/statement", pimpl_->rewriteStatement(statement),
+                                          deadline_);
+      // Extract query ID from the initial response for reliable cancellation via /v1/query/{id}.
+      if (pending_page_->contains("id") && (*pending_page_)["id"].is_string()) {
+        query_id_ = (*pending_page_)["id"].get<std::string>();
+        cancel_uri_ = pimpl_->baseUrl() + "/v1/query/" + query_id_;
       }
+    }
+
+    [[nodiscard]] const std::vector<TrinoColumnMeta>& columns() const { return columns_; }
 
-      if (result.columns.empty() && page.contains("columns") && page["columns"].is_array()) {
-        for (const auto& column_json : page["columns"]) {
-          result.columns.push_back({column_json.value("name", ""), extractRawType(column_json)});
+    std::optional<Page> nextPage() override {
+      while (true) {
+        if (deadline_.has_value() && std::chrono::steady_clock::now() >= *deadline_) {
+          cancelQuery();
+          pimpl_->throwTimeout(std::nullopt, *timeout_seconds_);
         }
-      }
 
-      if (page.contains("data") && page["data"].is_array()) {
-        for (const auto& row_json : page["data"]) {
-          std::vector<SqlVariant> row;
-          if (row_json.is_array()) {
-            row.reserve(row_json.size());
-            for (size_t i = 0; i < row_json.size(); ++i) {
-              const auto raw_type = i < result.columns.size() ? result.columns[i].raw_type : "unknown";
-              row.push_back(jsonValueToVariant(row_json[i], raw_type));
-            }
+        if (!pending_page_.has_value()) {
+          if (!next_uri_.has_value()) {
+            return std::nullopt;
+          }
+          if (!next_request_.has_value()) {
+            next_request_ = pimpl_->sendRequest(*next_uri_, std::nullopt, deadline_);
           }
-          result.rows.push_back(std::move(row));
+          pending_page_ = fetchNextUri();
         }
-      }
+        const json page = std::move(*pending_page_);
+        pending_page_.reset();
 
-      if (!page.contains("nextUri") || page["nextUri"].is_null()) {
-        break;
-      }
-      const auto next_uri = page["nextUri"].get<std::string>();
-      try {
-        page = httpRequest(next_uri, std::nullopt, deadline);
-      } catch (const ConnectionException& e) {
-        if (std::string_view(e.what()).find("Timeout was reached") != std::string_view::npos) {
-          cancelCurrentQuery();
-          if (timeout_seconds.has_value()) {
-            throwTimeout(std::nullopt, *timeout_seconds);
+        if (page.contains("error")) {
+          next_uri_.reset();
+          pimpl_->throwForError(page["error"], statement_);
+        }
+
+        if (columns_.empty() && page.contains("columns") && page["columns"].is_array()) {
+          for (const auto& column_json : page["columns"]) {
+            columns_.push_back({column_json.value("name", ""), extractRawType(column_json)});
           }
         }
-        throw;
+
+        if (page.contains("nextUri") && !page["nextUri"].is_null()) {
+          next_uri_ = page["nextUri"].get<std::string>();
+          next_request_ = pimpl_->sendRequest(*next_uri_, std::nullopt, deadline_);
+        } else {
+          next_uri_.reset();
+        }
+
+        if (page.contains("data") && page["data"].is_array() && !page["data"].empty()) {
+          return decodeRows(page["data"]);
+        }
       }
     }
 
-    return result;
-  }
+    void cancel() noexcept override {
+      if (!next_uri_.has_value()) {
+        return;
+      }
+      try {
+        cancelQuery();
+      } catch (const std::exception& e) {
+        PLOGW << "Failed to cancel abandoned Trino query " << query_id_ << ": " << e.what();
+      }
+      next_uri_.reset();
+      next_request_.reset();
+    }
+  };
 
   std::string version() const {
     const auto info = httpRequest(baseUrl() + "/v1/info");
@@ -427,7 +446,7 @@ public:
 
 Connection::Connection(const CredentialPassword& credential, const Engine& engine, std::optional<std::string> artifacts_path)
   : ConnectionBase(credential, engine, std::move(artifacts_path))
-  , impl_(std::make_unique<Pimpl>(*this, credential)) {
+  , impl_(std::make_shared<Pimpl>(credential)) {
 }
 
 Connection::~Connection() = default;
@@ -440,12 +459,19 @@ const ConnectionBase::TypeMap& Connection::typeMap() const {
 }
 
 void Connection::execute(const std::string_view statement) {
-  impl_->runStatement(statement);
+  Pimpl::Statement running(impl_, statement, queryTimeoutSeconds());
+  while (running.nextPage().has_value()) {
+  }
 }
 
 std::unique_ptr<ResultBase> Connection::fetchAll(const std::string_view statement) {
-  auto result = impl_->runStatement(statement);
-  return std::make_unique<Result>(std::move(result.rows), result.columns.size());
+  auto running = std::make_unique<Pimpl::Statement>(impl_, statement, queryTimeoutSeconds());
+  auto first_page = running->nextPage();
+  if (!first_page.has_value()) {
+    return std::make_unique<Result>(Page{}, running->columns().size(), nullptr);
+  }
+  const auto column_count = running->columns().size();
+  return std::make_unique<Result>(std::move(*first_page), column_count, std::move(running));
 }
 
 void Connection::bulkLoad(const std::string_view, const std::vector<std::filesystem::path>) {
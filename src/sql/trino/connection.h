@@ -6,7 +6,7 @@
 namespace sql::trino {
 class Connection final : public ConnectionBase {
   class Pimpl;
-  std::unique_ptr<Pimpl> impl_;
+  std::shared_ptr<Pimpl> impl_;
 
 public:
   explicit Connection(const CredentialPassword& credential, const Engine& engine, std::optional<std::string> artifacts_path = std::nullopt);
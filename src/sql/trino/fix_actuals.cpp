@@ -525,7 +525,7 @@ void fixActualsFromExplainAnalyze(explain::Plan& plan,
         std::to_string(std::hash<std::string_view>{}(statement)) + "_analyze";
 
     std::string analyze_text;
-    std::optional<std::string> cached;
+    std::optional<std::string_view> cached;
     try {
         cached = connection.getArtefact(artefact_name, "txt");
     } catch (const std::exception&) {
@@ -534,7 +534,7 @@ void fixActualsFromExplainAnalyze(explain::Plan& plan,
     }
     if (cached) {
         PLOGI << "fixActuals (EXPLAIN ANALYZE): loaded from artefact " << artefact_name;
-        analyze_text = std::move(*cached);
+        analyze_text = *cached;
     } else {
         const std::string analyze_sql = "EXPLAIN ANALYZE\n" + std::string(statement);
         try {
@@ -0,0 +1,178 @@
+#include "http_client.h"
+
+#include <curl/curl.h>
+
+#include <map>
+#include <mutex>
+#include <thread>
+
+namespace sql::trino {
+namespace {
+/// Idle connections kept open in the multi handle's cache
+constexpr long kMaxCachedConnections = 64;
+constexpr int kPollTimeoutMs = 1000;
+
+size_t appendBody(const char* ptr, const size_t size, const size_t nmemb, void* userdata) {
+  static_cast<std::string*>(userdata)->append(ptr, size * nmemb);
+  return size * nmemb;
+}
+}
+
+class HttpClient::Pimpl {
+  struct Transfer {
+    HttpRequest request;
+    std::promise<HttpResponse> promise;
+    HttpResponse response;
+    curl_slist* headers = nullptr;
+  };
+
+  CURLM* multi_ = nullptr;
+  std::mutex mutex_;
+  std::vector<std::unique_ptr<Transfer>> queued_;
+  bool stopping_ = false;
+  /// Only touched by the loop thread
+  std::map<CURL*, std::unique_ptr<Transfer>> running_;
+  std::vector<CURL*> idle_handles_;
+  std::thread loop_;
+
+  void start(std::unique_ptr<Transfer> transfer) {
+    CURL* easy = nullptr;
+    if (idle_handles_.empty()) {
+      easy = curl_easy_init();
+    } else {
+      easy = idle_handles_.back();
+      idle_handles_.pop_back();
+      curl_easy_reset(easy);
+    }
+    if (easy == nullptr) {
+      transfer->response.curl_code = CURLE_FAILED_INIT;
+      transfer->response.curl_error = "Failed to initialize curl for Trino";
+      transfer->promise.set_value(std::move(transfer->response));
+      return;
+    }
+
+    const auto& request = transfer->request;
+    for (const auto& header : request.headers) {
+      transfer->headers = curl_slist_append(transfer->headers, header.c_str());
+    }
+    if (request.method == "POST") {
+      curl_easy_setopt(easy, CURLOPT_POST, 1L);
+      curl_easy_setopt(easy, CURLOPT_POSTFIELDS, request.body.c_str());
+      curl_easy_setopt(easy, CURLOPT_POSTFIELDSIZE, static_cast<long>(request.body.size()));
+    } else if (request.method != "GET") {
+      curl_easy_setopt(easy, CURLOPT_CUSTOMREQUEST, request.method.c_str());
+    }
+    curl_easy_setopt(easy, CURLOPT_URL, request.url.c_str());
+    curl_easy_setopt(easy, CURLOPT_HTTPHEADER, transfer->headers);
+    curl_easy_setopt(easy, CURLOPT_WRITEFUNCTION, appendBody);
+    curl_easy_setopt(easy, CURLOPT_WRITEDATA, &transfer->response.body);
+    curl_easy_setopt(easy, CURLOPT_FOLLOWLOCATION, 1L);
+    curl_easy_setopt(easy, CURLOPT_TIMEOUT, request.timeout_seconds);
+    curl_easy_setopt(easy, CURLOPT_TCP_KEEPALIVE, 1L);
+    curl_easy_setopt(easy, CURLOPT_NOSIGNAL, 1L);
+
+    curl_multi_add_handle(multi_, easy);
+    running_.emplace(easy, std::move(transfer));
+  }
+
+  void finishCompleted() {
+    int remaining = 0;
+    while (const CURLMsg* message = curl_multi_info_read(multi_, &remaining)) {
+      if (message->msg != CURLMSG_DONE) {
+        continue;
+      }
+      CURL* easy = message->easy_handle;
+      const auto it = running_.find(easy);
+      auto transfer = std::move(it->second);
+      running_.erase(it);
+
+      auto& response = transfer->response;
+      response.curl_code = message->data.result;
+      if (message->data.result != CURLE_OK) {
+        response.curl_error = curl_easy_strerror(message->data.result);
+      }
+      curl_easy_getinfo(easy, CURLINFO_RESPONSE_CODE, &response.status_code);
+      curl_multi_remove_handle(multi_, easy);
+      curl_slist_free_all(transfer->headers);
+      idle_handles_.push_back(easy);
+      transfer->promise.set_value(std::move(response));
+    }
+  }
+
+  void run() {
+    while (true) {
+      std::vector<std::unique_ptr<Transfer>> queued;
+      {
+        std::lock_guard lock(mutex_);
+        if (stopping_) {
+          break;
+        }
+        queued.swap(queued_);
+      }
+      for (auto& transfer : queued) {
+        start(std::move(transfer));
+      }
+      int still_running = 0;
+      curl_multi_perform(multi_, &still_running);
+      finishCompleted();
+      curl_multi_poll(multi_, nullptr, 0, kPollTimeoutMs, nullptr);
+    }
+
+    for (auto& [easy, transfer] : running_) {
+      curl_multi_remove_handle(multi_, easy);
+      curl_slist_free_all(transfer->headers);
+      curl_easy_cleanup(easy);
+    }
+    running_.clear();
+    for (CURL* easy : idle_handles_) {
+      curl_easy_cleanup(easy);
+    }
+    idle_handles_.clear();
+  }
+
+public:
+  Pimpl() {
+    curl_global_init(CURL_GLOBAL_DEFAULT);
+    multi_ = curl_multi_init();
+    curl_multi_setopt(multi_, CURLMOPT_MAXCONNECTS, kMaxCachedConnections);
+    loop_ = std::thread([this] { run(); });
+  }
+
+  ~Pimpl() {
+    {
+      std::lock_guard lock(mutex_);
+      stopping_ = true;
+    }
+    curl_multi_wakeup(multi_);
+    loop_.join();
+    curl_multi_cleanup(multi_);
+  }
+
+  std::future<HttpResponse> send(HttpRequest request) {
+    auto transfer = std::make_unique<Transfer>();
+    transfer->request = std::move(request);
+    auto response = transfer->promise.get_future();
+    {
+      std::lock_guard lock(mutex_);
+      queued_.push_back(std::move(transfer));
+    }
+    curl_multi_wakeup(multi_);
+    return response;
+  }
+};
+
+HttpClient::HttpClient()
+  : impl_(std::make_unique<Pimpl>()) {
+}
+
+HttpClient::~HttpClient() = default;
+
+HttpClient& HttpClient::instance() {
+  static HttpClient client;
+  return client;
+}
+
+std::future<HttpResponse> HttpClient::send(HttpRequest request) {
+  return impl_->send(std::move(request));
+}
+}
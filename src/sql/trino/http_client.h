@@ -0,0 +1,48 @@
+#pragma once
+#include <future>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace sql::trino {
+struct HttpRequest {
+  /// `GET`, `POST` or `DELETE`
+  std::string method = "GET";
+  std::string url;
+  std::vector<std::string> headers;
+  /// Sent as the POST body
+  std::string body;
+  long timeout_seconds = 600;
+};
+
+struct HttpResponse {
+  /// `CURLcode` of the transfer. The HTTP status can still be an error when this is `CURLE_OK`
+  int curl_code = 0;
+  std::string curl_error;
+  long status_code = 0;
+  std::string body;
+};
+
+/**
+ * Process wide HTTP client running every Trino request over one `curl_multi` handle.
+ *
+ * A single thread drives all transfers, so any number of statements can be polled at the same time without a
+ * thread each. Connections stay in the multi handle's cache between requests and are kept alive, so following
+ * `nextUri` reuses the connection instead of paying for a new handshake.
+ */
+class HttpClient {
+  class Pimpl;
+  std::unique_ptr<Pimpl> impl_;
+
+  HttpClient();
+
+public:
+  static HttpClient& instance();
+  ~HttpClient();
+  HttpClient(const HttpClient&) = delete;
+  HttpClient& operator=(const HttpClient&) = delete;
+
+  /// @brief Queue the request and return without waiting for it
+  std::future<HttpResponse> send(HttpRequest request);
+};
+}
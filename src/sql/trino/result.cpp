@@ -4,27 +4,48 @@
 #include "sql_exceptions.h"
 
 namespace sql::trino {
-Result::Result(std::vector<std::vector<SqlVariant>> rows, const ColumnCount column_count)
-  : rows_(std::move(rows))
+Result::Result(Page first_page, const ColumnCount column_count, std::unique_ptr<PageSource> source)
+  : source_(std::move(source))
+  , page_(std::move(first_page))
   , current_row_(std::make_unique<Row>(this))
   , column_count_(column_count) {
+  exhausted_ = source_ == nullptr;
 }
 
-Result::~Result() = default;
+Result::~Result() {
+  if (!exhausted_) {
+    source_->cancel();
+  }
+}
 
 RowCount Result::rowCount() const {
-  return rows_.size();
+  return rows_returned_;
 }
 
 ColumnCount Result::columnCount() const {
   return column_count_;
 }
 
+bool Result::loadNextPage() {
+  if (exhausted_) {
+    return false;
+  }
+  auto next = source_->nextPage();
+  if (!next.has_value()) {
+    exhausted_ = true;
+    page_.clear();
+    return false;
+  }
+  page_ = std::move(*next);
+  page_index_ = 0;
+  return true;
+}
+
 const std::vector<SqlVariant>& Result::currentRow() const {
-  if (current_row_index_ == 0 || current_row_index_ > rows_.size()) {
+  if (page_index_ == 0 || page_index_ > page_.size()) {
     throw InvalidRowsException("No current Trino row is available", "Trino result iteration");
   }
-  return rows_[current_row_index_ - 1];
+  return page_[page_index_ - 1];
 }
 
 SqlVariant Result::columnData(const size_t index) const {
@@ -36,10 +57,13 @@ SqlVariant Result::columnData(const size_t index) const {
 }
 
 const RowBase& Result::nextRow() {
-  if (current_row_index_ >= rows_.size()) {
-    return SentinelRow::instance();
+  while (page_index_ >= page_.size()) {
+    if (!loadNextPage()) {
+      return SentinelRow::instance();
+    }
   }
-  ++current_row_index_;
+  ++page_index_;
+  ++rows_returned_;
   return *current_row_;
 }
 }
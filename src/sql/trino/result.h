@@ -1,5 +1,6 @@
 #pragma once
 
+#include <optional>
 #include <vector>
 
 #include "result_base.h"
@@ -7,19 +8,45 @@
 namespace sql::trino {
 class Row;
 
+/// @brief Decoded rows of a single Trino result page
+using Page = std::vector<std::vector<SqlVariant>>;
+
+/**
+ * Source of the remaining pages of a running Trino statement
+ */
+class PageSource {
+public:
+  virtual ~PageSource() = default;
+  /// @brief Follow `nextUri` until the next page with data, or nullopt when the statement is finished
+  virtual std::optional<Page> nextPage() = 0;
+  /// @brief Release the statement on the server when the result is abandoned before its last page
+  virtual void cancel() noexcept = 0;
+};
+
+/**
+ * Streaming Trino result that holds only the current page in memory.
+ *
+ * The next page is requested from `nextRow()` when the current page runs out. The HTTP client has usually
+ * received it by then, because it sends the request as soon as the previous page arrives.
+ * `rowCount()` is the number of rows returned so far and only final once the result is drained.
+ */
 class Result final : public ResultBase {
   friend class Row;
 
-  std::vector<std::vector<SqlVariant>> rows_;
+  std::unique_ptr<PageSource> source_;
+  bool exhausted_ = false;
+  Page page_;
+  size_t page_index_ = 0;
   std::unique_ptr<Row> current_row_;
   ColumnCount column_count_ = 0;
-  RowCount current_row_index_ = 0;
+  RowCount rows_returned_ = 0;
 
   const std::vector<SqlVariant>& currentRow() const;
   SqlVariant columnData(size_t index) const;
+  bool loadNextPage();
 
 public:
-  explicit Result(std::vector<std::vector<SqlVariant>> rows, ColumnCount column_count);
+  explicit Result(Page first_page, ColumnCount column_count, std::unique_ptr<PageSource> source);
   ~Result() override;
 
   RowCount rowCount() const override;
@@ -10,6 +10,7 @@ public:
   std::unique_ptr<sql::ResultBase> fetchAll(std::string_view statement) override;
   std::unique_ptr<sql::RowBase> fetchRow(std::string_view statement) override;
   SqlVariant fetchScalar(std::string_view statement) override;
+  void ping() override {}
   void bulkLoad(const std::string_view table, const std::vector<std::filesystem::path> source_paths) override;
 };
 }
\ No newline at end of file
@@ -11,7 +11,7 @@ void cli_1(Proof& proof) {
   }
   auto sql = Query("SELECT 1");
   Runner runner(proof.factory());
-  runner.serial(sql, 1);
+  runner.serial(sql, 1, proof.executionMode());
 }
 
 
@@ -6,7 +6,6 @@
 #include <cmath>
 #include <ctime>
 #include <iomanip>
-#include <numeric>
 #include <string>
 #include <sstream>
 
@@ -104,44 +103,44 @@ void DataQuery::render(Proof& proof) {
   out << query.text() << std::endl;
   proof.beginQuery(query.text());
 
-  const auto& stats = query.stats();
-  if (stats.empty()) {
+  const auto& latency = query.latency();
+  if (latency.empty()) {
     return;
   }
 
-  proof.setCurrentQueryStartTime(formatWallClockTimestamp(stats.front().start_wall_time));
+  if (query.firstStartWallTime()) {
+    proof.setCurrentQueryStartTime(formatWallClockTimestamp(*query.firstStartWallTime()));
+  }
 
-  const auto [min_it, max_it] = std::minmax_element(stats.begin(), stats.end(), [](const QueryStats& lhs, const QueryStats& rhs) {
-    return lhs.duration < rhs.duration;
-  });
+  const auto percentiles = latency.percentiles();
+  const auto min_duration = latency.min();
+  const auto avg_duration = latency.mean();
+  const double stddev_us = latency.stddevUs();
 
-  const auto total_duration = std::accumulate(stats.begin(), stats.end(), std::chrono::microseconds::zero(),
-                                              [](const std::chrono::microseconds total, const QueryStats& stat) {
-                                                return total + stat.duration;
-                                              });
-  const auto avg_duration = total_duration / static_cast<int64_t>(stats.size());
-  const auto min_duration = min_it->duration;
-
-  const double mean_us = static_cast<double>(avg_duration.count());
-  const double variance_us = std::accumulate(stats.begin(), stats.end(), 0.0,
-                                             [mean_us](const double total, const QueryStats& stat) {
-                                               const double delta = static_cast<double>(stat.duration.count()) - mean_us;
-                                               return total + (delta * delta);
-                                             }) / static_cast<double>(stats.size());
-  const double stddev_us = std::sqrt(variance_us);
-
-  out << "Runs: " << stats.size()
+  out << "Runs: " << latency.count()
       << ", best: " << min_duration.count() << " us"
       << ", avg: " << avg_duration.count() << " us"
       << ", stddev: " << std::llround(stddev_us) << " us"
       << ", min: " << min_duration.count() << " us"
-      << ", max: " << max_it->duration.count() << " us" << std::endl;
+      << ", p50: " << percentiles.p50.count() << " us"
+      << ", p99: " << percentiles.p99.count() << " us"
+      << ", max: " << percentiles.max.count() << " us" << std::endl;
+
+  if (query.prepareTime()) {
+    out << "Prepared once in " << query.prepareTime()->count() << " us, not included in the runs" << std::endl;
+  }
 
   proof.setCurrentQueryBestRuntimeMicroseconds(min_duration.count());
+  proof.setCurrentQueryExecutionMode(query.executionMode(),
+                                     query.prepareTime() ? std::optional(query.prepareTime()->count()) : std::nullopt);
   proof.setRuntimeSummaryMicroseconds(min_duration.count(),
                                       avg_duration.count(),
-                                      min_it->duration.count(),
-                                      max_it->duration.count(),
+                                      min_duration.count(),
+                                      percentiles.max.count(),
                                       stddev_us);
+  proof.setRuntimePercentilesMicroseconds(percentiles.p50.count(),
+                                          percentiles.p90.count(),
+                                          percentiles.p99.count(),
+                                          percentiles.p999.count());
 }
 }
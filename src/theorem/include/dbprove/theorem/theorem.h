@@ -10,6 +10,8 @@
 #include <optional>
 #include <ostream>
 #include <filesystem>
+#include <future>
+#include <mutex>
 #include <stdexcept>
 
 #include "dbprove/sql/connection_factory.h"
@@ -70,6 +72,9 @@ public:
 
 inline std::string_view to_string(const Tag& tag) { return tag.name; }
 
+/// @brief Theorems with this tag are left out of the default run and only proven when selected explicitly
+inline constexpr std::string_view opt_in_tag = "OPT-IN";
+
 /**
  * Convert from a name to the enum
  * @param type_name Name to convert
@@ -151,6 +156,17 @@ struct RuntimeSummary {
   std::optional<int64_t> min_us;
   std::optional<int64_t> max_us;
   std::optional<double> stddev_us;
+  std::optional<int64_t> p50_us;
+  std::optional<int64_t> p90_us;
+  std::optional<int64_t> p99_us;
+  std::optional<int64_t> p999_us;
+};
+
+struct WorkloadProofData {
+  size_t sessions = 0;
+  size_t executions = 0;
+  double achieved_qps = 0.0;
+  std::optional<double> offered_qps;
 };
 
 struct QueryProofData {
@@ -160,6 +176,8 @@ struct QueryProofData {
   std::optional<std::string> error_message;
   std::optional<std::string> plan;
   std::optional<int64_t> time_us;
+  std::optional<std::string> execution_mode;
+  std::optional<int64_t> prepare_time_us;
   std::map<std::string, int64_t> operator_rows;
   std::map<std::string, std::map<std::string, int64_t>> mis_estimates;
 };
@@ -169,9 +187,13 @@ struct QueryProofData {
  */
 class Proof {
 public:
-  Proof(const Theorem& theorem, RunCtx& parent)
+  /**
+   * @param console Where the proof writes its output, the run console if not set
+   */
+  Proof(const Theorem& theorem, RunCtx& parent, std::ostream* console = nullptr)
     : theorem(theorem)
-    , state(parent) {
+    , state(parent)
+    , console_(console) {
   }
 
   ~Proof();
@@ -189,27 +211,35 @@ public:
   [[nodiscard]] std::ostream& console() const;
   [[nodiscard]] bool artifactMode() const;
   [[nodiscard]] std::optional<uint32_t> queryTimeoutSeconds() const;
+  [[nodiscard]] bool singleExecutionExplain() const;
   [[nodiscard]] size_t timingRuns() const;
+  [[nodiscard]] sql::ExecutionMode executionMode() const;
   [[nodiscard]] const std::optional<std::string>& parquetDir() const;
   QueryProofData& beginQuery(std::string sql);
   QueryProofData& ensureQuery();
   void setCurrentQueryStartTime(std::string start_time);
   void setCurrentQueryPlan(std::string plan);
   void setCurrentQueryBestRuntimeMicroseconds(int64_t time_us);
+  void setCurrentQueryExecutionMode(sql::ExecutionMode mode, std::optional<int64_t> prepare_time_us);
   void setRuntimeSummaryMicroseconds(int64_t best_us, int64_t avg_us, int64_t min_us, int64_t max_us,
                                      double stddev_us);
+  void setRuntimePercentilesMicroseconds(int64_t p50_us, int64_t p90_us, int64_t p99_us, int64_t p999_us);
   void setCurrentQueryOperatorRows(const std::string& operation, int64_t rows);
   void setCurrentQueryMisEstimate(const std::string& operation, const std::string& magnitude, int64_t count);
+  void setWorkload(WorkloadProofData workload);
   void setRunStatus(std::string status);
   void setErrorMessage(std::string error_message);
   [[nodiscard]] std::string toJson() const;
 
 private:
+  void bootstrapDataset(const std::string& dataset);
   RunCtx& state;
+  std::ostream* console_;
   bool rendered_ = false;
   std::vector<QueryProofData> queries_;
   std::optional<size_t> current_query_index_;
   RuntimeSummary runtime_summary_;
+  std::optional<WorkloadProofData> workload_;
   std::optional<std::string> run_status_;
   std::optional<std::string> error_message_;
 };
@@ -248,6 +278,7 @@ public:
   void addTag(const Tag& tag);
   bool hasTag(const Tag& tag) const;
   void addCategory(Category category);
+  bool hasCategory(Category category) const;
 
   std::string tags_to_string() const {
     return tags_string_;
@@ -300,13 +331,28 @@ public:
   sql::ConnectionFactory factory;
   std::ostream& console;
   bool artifact_mode = false;
+  /// Time and validate explained queries from the execution explain already does, instead of running them again
+  bool single_execution_explain = false;
   std::optional<uint32_t> query_timeout_seconds;
   size_t timing_runs = 3;
+  /// How measured queries are sent. `Prepared` parses them once, so timings exclude client and server parsing
+  sql::ExecutionMode execution_mode = sql::ExecutionMode::Text;
   std::optional<std::string> parquet_dir;
   std::optional<std::string> config;
+  /// Number of theorems proven concurrently, each on its own connections. Timing theorems always run alone
+  size_t jobs = 1;
+  /// Set when runs against other engines share `console`. Every proof's output is then buffered and printed whole
+  std::mutex* shared_console_mutex = nullptr;
   std::set<std::string> ensured_datasets;
   std::set<std::string> failed_datasets;
+  /// Completes when the first theorem asking for a dataset has bootstrapped it, so others wait instead of repeating it
+  std::map<std::string, std::shared_future<void>> dataset_latches;
+  /// Guards the dataset sets and latches
+  std::mutex dataset_mutex;
+  /// Held while a dataset bootstraps, the generator loads one dataset at a time
+  std::mutex dataset_bootstrap_mutex;
   std::vector<std::unique_ptr<Proof>> proofs;
+  std::mutex proofs_mutex;
   void writeProofJson(std::string_view proof_name, std::string_view content) const;
   RunCtx(const sql::Engine& engine, const sql::Credential& credentials, generator::GeneratorState& generator,
          std::ostream& console, std::string engine_version, std::optional<std::string> connection_artifacts_path = std::nullopt,
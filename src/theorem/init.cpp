@@ -6,6 +6,7 @@
 #include "plan/prover.h"
 #include "ee/prover.h"
 #include "cli/prover.h"
+#include "wlm/prover.h"
 
 namespace dbprove::theorem::test { void init(); }
 
@@ -19,6 +20,7 @@ void init() {
   plan::init();
   ee::init();
   cli::init();
+  wlm::init();
   test::init();
 }
 
@@ -0,0 +1,99 @@
+#include "latency_histogram.h"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+namespace dbprove::theorem {
+size_t LatencyHistogram::countsIndex(const uint64_t value_us) {
+  const auto clamped = std::min(value_us, kMaxTrackableUs);
+  const auto bucket_index = static_cast<unsigned>(std::bit_width(clamped | (kSubBucketCount - 1))) - kSubBucketBits;
+  const auto sub_bucket_index = clamped >> bucket_index;
+  return (bucket_index + 1) * kSubBucketHalfCount + (sub_bucket_index - kSubBucketHalfCount);
+}
+
+uint64_t LatencyHistogram::highestEquivalentValue(const size_t index) {
+  if (index < kSubBucketCount) {
+    return index;
+  }
+  const auto bucket_index = index / kSubBucketHalfCount - 1;
+  const auto sub_bucket_index = index % kSubBucketHalfCount + kSubBucketHalfCount;
+  const auto lowest = sub_bucket_index << bucket_index;
+  return lowest + (uint64_t{1} << bucket_index) - 1;
+}
+
+void LatencyHistogram::record(const std::chrono::microseconds duration) {
+  const auto value_us = static_cast<uint64_t>(std::max<int64_t>(duration.count(), 0));
+  ++counts_[countsIndex(value_us)];
+  ++count_;
+  min_us_ = std::min(min_us_, value_us);
+  max_us_ = std::max(max_us_, value_us);
+  const auto delta = static_cast<double>(value_us) - mean_us_;
+  mean_us_ += delta / static_cast<double>(count_);
+  m2_us_ += delta * (static_cast<double>(value_us) - mean_us_);
+}
+
+void LatencyHistogram::merge(const LatencyHistogram& other) {
+  if (other.empty()) {
+    return;
+  }
+  for (size_t i = 0; i < kCountsLength; ++i) {
+    counts_[i] += other.counts_[i];
+  }
+  const auto total = static_cast<double>(count_ + other.count_);
+  const auto delta = other.mean_us_ - mean_us_;
+  m2_us_ += other.m2_us_ + delta * delta * static_cast<double>(count_) * static_cast<double>(other.count_) / total;
+  mean_us_ += delta * static_cast<double>(other.count_) / total;
+  count_ += other.count_;
+  min_us_ = std::min(min_us_, other.min_us_);
+  max_us_ = std::max(max_us_, other.max_us_);
+}
+
+std::chrono::microseconds LatencyHistogram::min() const {
+  return std::chrono::microseconds(empty() ? 0 : static_cast<int64_t>(min_us_));
+}
+
+std::chrono::microseconds LatencyHistogram::max() const {
+  return std::chrono::microseconds(static_cast<int64_t>(max_us_));
+}
+
+std::chrono::microseconds LatencyHistogram::mean() const {
+  return std::chrono::microseconds(std::llround(mean_us_));
+}
+
+double LatencyHistogram::stddevUs() const {
+  if (empty()) {
+    return 0.0;
+  }
+  return std::sqrt(m2_us_ / static_cast<double>(count_));
+}
+
+std::chrono::microseconds LatencyHistogram::percentile(const double percentile) const {
+  if (percentile < 0.0 || percentile > 100.0) {
+    throw std::invalid_argument("Percentile must be between 0 and 100");
+  }
+  if (empty()) {
+    return std::chrono::microseconds(0);
+  }
+  const auto rank = std::max<uint64_t>(
+      1, static_cast<uint64_t>(std::ceil(percentile / 100.0 * static_cast<double>(count_))));
+  uint64_t seen = 0;
+  for (size_t i = 0; i < kCountsLength; ++i) {
+    seen += counts_[i];
+    if (seen >= rank) {
+      const auto value_us = std::clamp(highestEquivalentValue(i), min_us_, max_us_);
+      return std::chrono::microseconds(static_cast<int64_t>(value_us));
+    }
+  }
+  return max();
+}
+
+LatencyPercentiles LatencyHistogram::percentiles() const {
+  return LatencyPercentiles{
+      .p50 = percentile(50.0),
+      .p90 = percentile(90.0),
+      .p99 = percentile(99.0),
+      .p999 = percentile(99.9),
+      .max = max()};
+}
+}
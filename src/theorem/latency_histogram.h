@@ -0,0 +1,70 @@
+#pragma once
+#include <array>
+#include <bit>
+#include <chrono>
+#include <cstdint>
+
+namespace dbprove::theorem {
+/**
+ * Latency percentiles extracted from a `LatencyHistogram`
+ */
+struct LatencyPercentiles {
+  std::chrono::microseconds p50{0};
+  std::chrono::microseconds p90{0};
+  std::chrono::microseconds p99{0};
+  std::chrono::microseconds p999{0};
+  std::chrono::microseconds max{0};
+};
+
+/**
+ * High dynamic range latency histogram with fixed memory.
+ *
+ * Tracks durations from one microsecond up to one hour. Values below 256us are exact, larger values are
+ * kept in log-linear buckets with a relative error below 1%. Longer durations are clamped into the top
+ * bucket but still count towards the exact min, max, mean and standard deviation.
+ *
+ * A histogram is not thread safe. Record into one histogram per thread and `merge` them afterward.
+ */
+class LatencyHistogram {
+  static constexpr unsigned kSubBucketBits = 8;
+  static constexpr uint64_t kSubBucketCount = uint64_t{1} << kSubBucketBits;
+  static constexpr uint64_t kSubBucketHalfCount = kSubBucketCount / 2;
+
+public:
+  static constexpr uint64_t kMaxTrackableUs = 3'600'000'000;
+
+private:
+  static constexpr size_t kBucketCount = std::bit_width(kMaxTrackableUs | (kSubBucketCount - 1)) - kSubBucketBits + 1;
+  static constexpr size_t kCountsLength = (kBucketCount + 1) * kSubBucketHalfCount;
+
+  std::array<uint64_t, kCountsLength> counts_{};
+  uint64_t count_ = 0;
+  uint64_t min_us_ = UINT64_MAX;
+  uint64_t max_us_ = 0;
+  double mean_us_ = 0.0;
+  double m2_us_ = 0.0;
+
+  static size_t countsIndex(uint64_t value_us);
+  static uint64_t highestEquivalentValue(size_t index);
+
+public:
+  /// @brief Record one duration. Negative durations are recorded as zero.
+  void record(std::chrono::microseconds duration);
+  /// @brief Add all values recorded in `other` to this histogram
+  void merge(const LatencyHistogram& other);
+
+  [[nodiscard]] uint64_t count() const { return count_; }
+  [[nodiscard]] bool empty() const { return count_ == 0; }
+  [[nodiscard]] std::chrono::microseconds min() const;
+  [[nodiscard]] std::chrono::microseconds max() const;
+  [[nodiscard]] std::chrono::microseconds mean() const;
+  [[nodiscard]] double stddevUs() const;
+
+  /**
+   * @brief Smallest recorded bucket value that at least `percentile` percent of all recorded values fall under
+   * @param percentile In the range 0 to 100
+   */
+  [[nodiscard]] std::chrono::microseconds percentile(double percentile) const;
+  [[nodiscard]] LatencyPercentiles percentiles() const;
+};
+}
@@ -7,6 +7,7 @@
 #include "../query.h"
 #include <plog/Log.h>
 #include <array>
+#include <format>
 
 using namespace dbprove::theorem;
 
@@ -1,9 +1,15 @@
+#include <algorithm>
 #include <cmath>
+#include <cstdlib>
 #include <filesystem>
 #include <fstream>
+#include <future>
+#include <mutex>
+#include <thread>
 
 #include "dbprove/sql/sql_exceptions.h"
 #include "theorem.h"
+#include "tune_script.h"
 #include <dbprove/common/file_utility.h>
 #include <dbprove/sql/sql.h>
 #include <nlohmann/json.hpp>
@@ -11,6 +17,29 @@
 
 namespace dbprove::theorem {
 namespace {
+/**
+ * Connections a dataset tune script may use for statements on different tables. One per hardware thread, at most
+ * 8, unless `DBPROVE_TUNE_CONNECTIONS` says otherwise
+ */
+size_t maxTuneConnections() {
+  constexpr size_t default_cap = 8;
+  constexpr int min_connections = 1;
+  constexpr int max_connections = 64;
+  if (const auto* env = std::getenv("DBPROVE_TUNE_CONNECTIONS")) {
+    try {
+      const auto parsed = std::stoi(env);
+      if (parsed >= min_connections && parsed <= max_connections) {
+        return static_cast<size_t>(parsed);
+      }
+      PLOGW << "Ignoring DBPROVE_TUNE_CONNECTIONS=" << parsed
+            << " outside allowed range [" << min_connections << ", " << max_connections << "]";
+    } catch (...) {
+      PLOGW << "Ignoring invalid DBPROVE_TUNE_CONNECTIONS='" << env << "'";
+    }
+  }
+  return std::clamp<size_t>(std::thread::hardware_concurrency(), 1, default_cap);
+}
+
 std::vector<std::string> splitCsvLikeList(const std::string& value) {
   std::vector<std::string> parts;
   if (value.empty()) {
@@ -52,48 +81,88 @@ Proof& Proof::ensureDataset(const std::string& dataset) {
     PLOGI << "Artifact mode: skipping dataset ensure/tuning for '" << dataset << "'";
     return *this;
   }
-  if (state.ensured_datasets.contains(dataset)) {
-    PLOGD << "Dataset '" << dataset << "' already ensured in this run; skipping ensure, summary, and tuning.";
-    return *this;
+
+  std::promise<void> bootstrapped;
+  std::shared_future<void> latch;
+  {
+    std::lock_guard lock(state.dataset_mutex);
+    if (state.ensured_datasets.contains(dataset)) {
+      PLOGD << "Dataset '" << dataset << "' already ensured in this run; skipping ensure, summary, and tuning.";
+      return *this;
+    }
+    if (state.failed_datasets.contains(dataset)) {
+      throw DatasetBootstrapException("Dataset '" + dataset + "' bootstrap previously failed; skipping.");
+    }
+    if (const auto it = state.dataset_latches.find(dataset); it != state.dataset_latches.end()) {
+      latch = it->second;
+    } else {
+      state.dataset_latches.emplace(dataset, bootstrapped.get_future().share());
+    }
   }
-  if (state.failed_datasets.contains(dataset)) {
-    throw DatasetBootstrapException("Dataset '" + dataset + "' bootstrap previously failed; skipping.");
+  if (latch.valid()) {
+    PLOGD << "Waiting for dataset '" << dataset << "' to be bootstrapped by another theorem";
+    latch.get();
+    return *this;
   }
 
   try {
-    auto conn = state.factory.create();
-    state.generator.ensureDataset(dataset, factory());
-    state.generator.printSummary(state.console);
-
-    const auto project_root = dbprove::common::get_project_root();
-    const auto tune_file_path = project_root / "src" / "sql" / state.engine.internalName() / "tune" / (dataset + ".sql");
-    if (std::filesystem::exists(tune_file_path)) {
-      if (conn->shouldSkipDatasetTuning(dataset)) {
-        PLOGI << "Skipping dataset tuning for '" << dataset
-              << "' because the engine reported the dataset is already tuned.";
-        return *this;
-      }
-
-      PLOGI << "Tuning dataset '" << dataset << "' with " << tune_file_path.string();
-      std::ifstream ifs(tune_file_path);
-      if (!ifs.is_open()) {
-        PLOGW << "Failed to open " << tune_file_path.string();
-        return *this;
-      }
-
-      const std::string sql((std::istreambuf_iterator<char>(ifs)), std::istreambuf_iterator<char>());
-      conn->execute(sql);
-      PLOGI << "Dataset tuning complete for '" << dataset << "'";
-    }
+    std::lock_guard serialise(state.dataset_bootstrap_mutex);
+    bootstrapDataset(dataset);
   } catch (const std::exception& e) {
-    state.failed_datasets.insert(dataset);
-    throw DatasetBootstrapException("Dataset '" + dataset + "' bootstrap failed: " + e.what());
+    const DatasetBootstrapException error("Dataset '" + dataset + "' bootstrap failed: " + e.what());
+    {
+      std::lock_guard lock(state.dataset_mutex);
+      state.failed_datasets.insert(dataset);
+    }
+    bootstrapped.set_exception(std::make_exception_ptr(error));
+    throw error;
   }
 
-  state.ensured_datasets.insert(dataset);
+  {
+    std::lock_guard lock(state.dataset_mutex);
+    state.ensured_datasets.insert(dataset);
+  }
+  bootstrapped.set_value();
   return *this;
 }
 
+void Proof::bootstrapDataset(const std::string& dataset) {
+  auto conn = state.factory.create();
+  state.generator.ensureDataset(dataset, factory());
+  state.generator.printSummary(console());
+
+  const auto project_root = dbprove::common::get_project_root();
+  const auto tune_file_path = project_root / "src" / "sql" / state.engine.internalName() / "tune" / (dataset + ".sql");
+  if (!std::filesystem::exists(tune_file_path)) {
+    return;
+  }
+  if (conn->shouldSkipDatasetTuning(dataset)) {
+    PLOGI << "Skipping dataset tuning for '" << dataset
+          << "' because the engine reported the dataset is already tuned.";
+    return;
+  }
+
+  PLOGI << "Tuning dataset '" << dataset << "' with " << tune_file_path.string();
+  std::ifstream ifs(tune_file_path);
+  if (!ifs.is_open()) {
+    PLOGW << "Failed to open " << tune_file_path.string();
+    return;
+  }
+
+  const std::string sql((std::istreambuf_iterator<char>(ifs)), std::istreambuf_iterator<char>());
+  const TuneScript script(sql);
+  const auto connection_count =
+      state.engine.supportsConcurrentSessions() ? std::min(script.width(), maxTuneConnections()) : 1;
+  if (connection_count <= 1) {
+    conn->execute(sql);
+  } else {
+    PLOGI << "Running " << script.steps().size() << " tuning steps for '" << dataset << "' on " << connection_count
+          << " connections";
+    script.run(*conn, [this] { return state.factory.create(); }, connection_count);
+  }
+  PLOGI << "Dataset tuning complete for '" << dataset << "'";
+}
+
 Proof& Proof::ensureSchema(const std::string& schema) {
   try {
     state.factory.create()->createSchema(schema);
@@ -113,14 +182,18 @@ void Proof::render() {
   rendered_ = true;
 }
 
-std::ostream& Proof::console() const { return state.console; }
+std::ostream& Proof::console() const { return console_ ? *console_ : state.console; }
 
 bool Proof::artifactMode() const { return state.artifact_mode; }
 
 std::optional<uint32_t> Proof::queryTimeoutSeconds() const { return state.query_timeout_seconds; }
 
+bool Proof::singleExecutionExplain() const { return state.single_execution_explain; }
+
 size_t Proof::timingRuns() const { return state.timing_runs; }
 
+sql::ExecutionMode Proof::executionMode() const { return state.execution_mode; }
+
 const std::optional<std::string>& Proof::parquetDir() const { return state.parquet_dir; }
 
 QueryProofData& Proof::beginQuery(std::string sql) {
@@ -148,6 +221,12 @@ void Proof::setCurrentQueryBestRuntimeMicroseconds(const int64_t time_us) {
   ensureQuery().time_us = time_us;
 }
 
+void Proof::setCurrentQueryExecutionMode(const sql::ExecutionMode mode, const std::optional<int64_t> prepare_time_us) {
+  auto& query = ensureQuery();
+  query.execution_mode = std::string(to_string(mode));
+  query.prepare_time_us = prepare_time_us;
+}
+
 void Proof::setRuntimeSummaryMicroseconds(const int64_t best_us, const int64_t avg_us, const int64_t min_us,
                                           const int64_t max_us, const double stddev_us) {
   runtime_summary_.best_us = best_us;
@@ -157,6 +236,14 @@ void Proof::setRuntimeSummaryMicroseconds(const int64_t best_us, const int64_t a
   runtime_summary_.stddev_us = stddev_us;
 }
 
+void Proof::setRuntimePercentilesMicroseconds(const int64_t p50_us, const int64_t p90_us, const int64_t p99_us,
+                                              const int64_t p999_us) {
+  runtime_summary_.p50_us = p50_us;
+  runtime_summary_.p90_us = p90_us;
+  runtime_summary_.p99_us = p99_us;
+  runtime_summary_.p999_us = p999_us;
+}
+
 void Proof::setCurrentQueryOperatorRows(const std::string& operation, const int64_t rows) {
   ensureQuery().operator_rows[operation] = rows;
 }
@@ -165,6 +252,10 @@ void Proof::setCurrentQueryMisEstimate(const std::string& operation, const std::
   ensureQuery().mis_estimates[operation][magnitude] = count;
 }
 
+void Proof::setWorkload(WorkloadProofData workload) {
+  workload_ = std::move(workload);
+}
+
 void Proof::setRunStatus(std::string status) {
   run_status_ = std::move(status);
 }
@@ -190,7 +281,8 @@ std::string Proof::toJson() const {
   document["queries"] = nlohmann::json::array();
 
   if (runtime_summary_.best_us.has_value() || runtime_summary_.avg_us.has_value() || runtime_summary_.min_us.has_value() ||
-      runtime_summary_.max_us.has_value() || runtime_summary_.stddev_us.has_value()) {
+      runtime_summary_.max_us.has_value() || runtime_summary_.stddev_us.has_value() ||
+      runtime_summary_.p50_us.has_value()) {
     document["runtime"] = nlohmann::json::object();
     if (runtime_summary_.avg_us.has_value()) {
       document["runtime"]["avgMs"] = microsecondsToRoundedMilliseconds(*runtime_summary_.avg_us);
@@ -208,6 +300,28 @@ std::string Proof::toJson() const {
       document["runtime"]["stdDevMs"] = microsecondsToRoundedMilliseconds(
           static_cast<int64_t>(std::llround(*runtime_summary_.stddev_us)));
     }
+    if (runtime_summary_.p50_us.has_value()) {
+      document["runtime"]["p50Ms"] = microsecondsToRoundedMilliseconds(*runtime_summary_.p50_us);
+    }
+    if (runtime_summary_.p90_us.has_value()) {
+      document["runtime"]["p90Ms"] = microsecondsToRoundedMilliseconds(*runtime_summary_.p90_us);
+    }
+    if (runtime_summary_.p99_us.has_value()) {
+      document["runtime"]["p99Ms"] = microsecondsToRoundedMilliseconds(*runtime_summary_.p99_us);
+    }
+    if (runtime_summary_.p999_us.has_value()) {
+      document["runtime"]["p999Ms"] = microsecondsToRoundedMilliseconds(*runtime_summary_.p999_us);
+    }
+  }
+
+  if (workload_.has_value()) {
+    document["workload"] = nlohmann::json::object();
+    document["workload"]["sessions"] = workload_->sessions;
+    document["workload"]["executions"] = workload_->executions;
+    document["workload"]["achievedQps"] = roundToThreeDecimals(workload_->achieved_qps);
+    if (workload_->offered_qps.has_value()) {
+      document["workload"]["offeredQps"] = roundToThreeDecimals(*workload_->offered_qps);
+    }
   }
 
   for (size_t i = 0; i < queries_.size(); ++i) {
@@ -225,6 +339,12 @@ std::string Proof::toJson() const {
     if (query_data.time_us.has_value()) {
       query_document["timeMs"] = microsecondsToRoundedMilliseconds(*query_data.time_us);
     }
+    if (query_data.execution_mode.has_value()) {
+      query_document["executionMode"] = *query_data.execution_mode;
+    }
+    if (query_data.prepare_time_us.has_value()) {
+      query_document["prepareMs"] = microsecondsToRoundedMilliseconds(*query_data.prepare_time_us);
+    }
     if (!query_data.operator_rows.empty()) {
       query_document["operatorRows"] = query_data.operator_rows;
     }
@@ -272,6 +392,8 @@ void Theorem::addTag(const Tag& tag) {
 
 bool Theorem::hasTag(const Tag& tag) const { return tags_.contains(tag); }
 
+bool Theorem::hasCategory(const Category category) const { return categories_.contains(category); }
+
 void Theorem::addCategory(const Category category) {
   categories_.insert(category);
   categories_string_ = sorted_join(categories_);
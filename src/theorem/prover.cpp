@@ -2,6 +2,12 @@
 #include <string>
 #include <vector>
 #include <ranges>
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <shared_mutex>
+#include <sstream>
+#include <thread>
 #include <nlohmann/json.hpp>
 #include <dbprove/ux/ux.h>
 
@@ -68,28 +74,49 @@ std::string configVersionJson(const RunCtx& input_state, const std::string_view
   document["storageVariant"] = to_string(input_state.storage_variant);
   return document.dump(2);
 }
+
+void keepProof(RunCtx& state, std::unique_ptr<Proof> proof) {
+  std::lock_guard lock(state.proofs_mutex);
+  state.proofs.push_back(std::move(proof));
+}
+
+/**
+ * Held shared while a theorem runs and exclusively while a timing theorem runs. Engines proven concurrently in one
+ * process usually share the host, so a timing theorem of one engine must not overlap any theorem of another.
+ */
+std::shared_mutex& theoremMutex() {
+  static std::shared_mutex mutex;
+  return mutex;
+}
+
+/// Timing theorems measure latency or throughput, so they must not share the engine with other theorems
+bool runsExclusively(const Theorem& theorem) {
+  return theorem.hasCategory(Category::CLI)
+         || theorem.hasCategory(Category::EE)
+         || theorem.hasCategory(Category::WLM);
+}
 }
 
-void run_theorem(const Theorem& theorem, RunCtx& state) {
-  auto proof = std::make_unique<Proof>(theorem, state);
+void run_theorem(const Theorem& theorem, RunCtx& state, std::ostream* console) {
+  auto proof = std::make_unique<Proof>(theorem, state, console);
   try {
     theorem.func(*proof);
     proof->setRunStatus("OK");
     persistProofOutput(*proof, state);
-    state.proofs.push_back(std::move(proof));
+    keepProof(state, std::move(proof));
   } catch (const std::exception& e) {
     const auto render_error = tryRenderProof(*proof);
     proof->setRunStatus(std::string(classifyRunStatus(e.what())));
     proof->setErrorMessage(renderFailureMessage(e, render_error));
     persistProofOutput(*proof, state);
-    state.proofs.push_back(std::move(proof));
+    keepProof(state, std::move(proof));
     throw;
   } catch (...) {
     const auto render_error = tryRenderProof(*proof);
     proof->setRunStatus("ERROR");
     proof->setErrorMessage(renderFailureMessage("Unknown non-std exception", render_error));
     persistProofOutput(*proof, state);
-    state.proofs.push_back(std::move(proof));
+    keepProof(state, std::move(proof));
     throw;
   }
 }
@@ -113,23 +140,85 @@ void writeVersion(RunCtx& input_state) {
   PLOGI << "The Version of the engine is: " << version;
 }
 
+namespace {
+bool proveTheorem(const Theorem& theorem, RunCtx& state, std::ostream& console) {
+  ux::PreAmpleTheorem(console, theorem.name);
+  try {
+    run_theorem(theorem, state, &console);
+    return true;
+  } catch (const DatasetBootstrapException& e) {
+    PLOGE << "Theorem '" << theorem.name << "' failed: " << e.what();
+  } catch (const std::exception& e) {
+    PLOGE << "Theorem '" << theorem.name << "' failed: " << e.what();
+  } catch (...) {
+    PLOGE << "Theorem '" << theorem.name << "' failed with unknown non-std exception";
+  }
+  return false;
+}
+
+/// Prove the theorem with its output buffered, printing it in one piece under `console_mutex` when done
+bool proveBuffered(const Theorem& theorem, RunCtx& state, std::mutex& console_mutex) {
+  std::ostringstream buffer;
+  const auto succeeded = proveTheorem(theorem, state, buffer);
+  std::lock_guard lock(console_mutex);
+  state.console << buffer.str() << std::flush;
+  return succeeded;
+}
+
+/**
+ * Prove theorems on `jobs` worker threads. Every theorem opens its own connections from the factory.
+ */
+bool proveConcurrently(const std::vector<const Theorem*>& theorems, RunCtx& state, const size_t jobs) {
+  std::atomic<size_t> next{0};
+  std::atomic<bool> all_succeeded{true};
+  std::mutex local_console_mutex;
+  auto& console_mutex = state.shared_console_mutex ? *state.shared_console_mutex : local_console_mutex;
+  {
+    std::vector<std::jthread> workers;
+    for (size_t i = 0; i < std::min(jobs, theorems.size()); ++i) {
+      workers.emplace_back([&] {
+        for (auto t = next.fetch_add(1); t < theorems.size(); t = next.fetch_add(1)) {
+          std::shared_lock lock(theoremMutex());
+          if (!proveBuffered(*theorems[t], state, console_mutex)) {
+            all_succeeded = false;
+          }
+        }
+      });
+    }
+  }
+  return all_succeeded;
+}
+}
+
 bool prove(const std::vector<const Theorem*>& theorems, RunCtx& input_state) {
   writeVersion(input_state);
+  auto jobs = std::max<size_t>(input_state.jobs, 1);
+  if (jobs > 1 && !input_state.engine.supportsConcurrentSessions()) {
+    PLOGW << input_state.engine.name() << " does not support concurrent sessions, proving theorems one at a time";
+    jobs = 1;
+  }
+
   auto all_succeeded = true;
+  std::vector<const Theorem*> exclusive;
+  if (jobs > 1) {
+    std::vector<const Theorem*> concurrent;
+    for (const auto* theorem : theorems) {
+      (runsExclusively(*theorem) ? exclusive : concurrent).push_back(theorem);
+    }
+    PLOGI << "Proving " << concurrent.size() << " theorems on " << jobs << " jobs, then "
+          << exclusive.size() << " timing theorems one at a time";
+    all_succeeded = proveConcurrently(concurrent, input_state, jobs);
+  } else {
+    exclusive = theorems;
+  }
 
-  for (const auto& theorem : theorems) {
-    ux::PreAmpleTheorem(input_state.console, theorem->name);
-    try {
-      run_theorem(*theorem, input_state);
-    } catch (const DatasetBootstrapException& e) {
+  for (const auto* theorem : exclusive) {
+    std::unique_lock lock(theoremMutex());
+    const auto succeeded = input_state.shared_console_mutex
+                           ? proveBuffered(*theorem, input_state, *input_state.shared_console_mutex)
+                           : proveTheorem(*theorem, input_state, input_state.console);
+    if (!succeeded) {
       all_succeeded = false;
-      PLOGE << "Theorem '" << theorem->name << "' failed: " << e.what();
-    } catch (const std::exception& e) {
-      all_succeeded = false;
-      PLOGE << "Theorem '" << theorem->name << "' failed: " << e.what();
-    } catch (...) {
-      all_succeeded = false;
-      PLOGE << "Theorem '" << theorem->name << "' failed with unknown non-std exception";
     }
   }
   return all_succeeded;
@@ -139,9 +228,12 @@ std::vector<const Theorem*> parse(const std::vector<std::string>& theorems) {
   // We only want to run each theorem once. Remove duplicates first.
   std::set<const Theorem*> parsed_theorems;
   if (theorems.size() == 0) {
-    // If the user didn't supply any theorems, default to all
+    // If the user didn't supply any theorems, default to all that are not opt-in
+    const Tag opt_in(std::string{opt_in_tag});
     for (auto& t : std::views::values(allTheorems())) {
-      parsed_theorems.insert(t.get());
+      if (!t->hasTag(opt_in)) {
+        parsed_theorems.insert(t.get());
+      }
     }
   } else {
     for (const auto& t : theorems) {
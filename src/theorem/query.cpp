@@ -1,5 +1,6 @@
 #include "query.h"
 
 namespace dbprove::theorem {
-thread_local std::vector<QueryStats> Query::thread_stats_;
+std::atomic<uint64_t> Query::next_id_{0};
+thread_local std::unordered_map<uint64_t, Query::ThreadLatency> Query::thread_latency_;
 }
\ No newline at end of file
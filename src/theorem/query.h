@@ -1,13 +1,22 @@
 #pragma once
 #include <string>
 #include <vector>
+#include <atomic>
 #include <chrono>
+#include <cstdint>
 #include <mutex>
 #include <optional>
+#include <unordered_map>
+#include <utility>
 
+#include <dbprove/sql/prepared_statement.h>
 #include <dbprove/sql/sql_type.h>
+#include "latency_histogram.h"
 
 namespace dbprove::theorem {
+/**
+ * Timing of a single execution in flight, from `Query::start` to `Query::stop`
+ */
 struct QueryStats {
   std::chrono::time_point<std::chrono::steady_clock> start_time;
   std::chrono::time_point<std::chrono::system_clock> start_wall_time;
@@ -17,13 +26,25 @@ struct QueryStats {
 };
 
 class Query {
+  uint64_t id_ = next_id_++;
   std::string text_;
   std::string text_tagged_;
   std::optional<sql::RowCount> expected_row_count_;
   std::optional<std::vector<sql::SqlVariant>> expected_row_values_;
   std::mutex stats_mutex_;
-  std::vector<QueryStats> stats_;
-  static thread_local std::vector<QueryStats> thread_stats_;
+  LatencyHistogram latency_;
+  std::optional<std::chrono::system_clock::time_point> first_start_wall_time_;
+  sql::ExecutionMode execution_mode_ = sql::ExecutionMode::Text;
+  std::optional<std::chrono::microseconds> prepare_time_;
+
+  struct ThreadLatency {
+    LatencyHistogram latency;
+    std::optional<std::chrono::system_clock::time_point> first_start_wall_time;
+  };
+
+  static std::atomic<uint64_t> next_id_;
+  /// Per thread recording, keyed by query id, so the hot path never takes the lock and moved queries keep theirs
+  static thread_local std::unordered_map<uint64_t, ThreadLatency> thread_latency_;
 
   static std::string tagSQL(const std::string& sql, const char* prefix) {
     if (!prefix) {
@@ -54,20 +75,29 @@ public:
     , expected_row_count_(expected_row_count) {
   }
 
-  Query(Query&& other) noexcept {
-    text_ = std::move(other.text_);
-    text_tagged_ = std::move(other.text_tagged_);
-    expected_row_count_ = std::move(other.expected_row_count_);
-    stats_ = std::move(other.stats_);
-    thread_stats_ = std::move(other.thread_stats_);
+  Query(Query&& other) noexcept
+    : id_(std::exchange(other.id_, next_id_++))
+    , text_(std::move(other.text_))
+    , text_tagged_(std::move(other.text_tagged_))
+    , expected_row_count_(std::move(other.expected_row_count_))
+    , expected_row_values_(std::move(other.expected_row_values_))
+    , latency_(std::move(other.latency_))
+    , first_start_wall_time_(std::move(other.first_start_wall_time_))
+    , execution_mode_(other.execution_mode_)
+    , prepare_time_(other.prepare_time_) {
   };
 
   Query& operator=(Query&& other) noexcept {
     if (this != &other) {
+      id_ = std::exchange(other.id_, next_id_++);
       text_ = std::move(other.text_);
       text_tagged_ = std::move(other.text_tagged_);
       expected_row_count_ = std::move(other.expected_row_count_);
-      stats_ = std::move(other.stats_);
+      expected_row_values_ = std::move(other.expected_row_values_);
+      latency_ = std::move(other.latency_);
+      first_start_wall_time_ = std::move(other.first_start_wall_time_);
+      execution_mode_ = other.execution_mode_;
+      prepare_time_ = other.prepare_time_;
       // No need to move the mutex
     }
     return *this;
@@ -81,28 +111,83 @@ public:
   void setExpectedRowValues(std::optional<std::vector<sql::SqlVariant>> expected_row_values) {
     expected_row_values_ = std::move(expected_row_values);
   }
-  const std::vector<QueryStats>& stats() const { return stats_; }
+  /// @brief Latencies of all executions summarised so far
+  const LatencyHistogram& latency() const { return latency_; }
+  /// @brief p50/p90/p99/p99.9/max of all executions summarised so far
+  LatencyPercentiles percentiles() const { return latency_.percentiles(); }
+  /// @brief Wall clock time of the earliest summarised execution
+  const std::optional<std::chrono::system_clock::time_point>& firstStartWallTime() const {
+    return first_start_wall_time_;
+  }
+
+  /// @brief How the measured executions were sent to the engine
+  sql::ExecutionMode executionMode() const { return execution_mode_; }
+  /// @brief Time taken to prepare the statement. Not part of `latency()`, so parse and execution cost stay apart
+  const std::optional<std::chrono::microseconds>& prepareTime() const { return prepare_time_; }
+
+  /**
+   * @brief Record how the executions of this query are sent to the engine
+   * @param prepare_time Time spent preparing, only kept for `ExecutionMode::Prepared`
+   */
+  void setExecutionMode(const sql::ExecutionMode mode, const std::chrono::microseconds prepare_time) {
+    execution_mode_ = mode;
+    prepare_time_ = mode == sql::ExecutionMode::Prepared ? std::optional(prepare_time) : std::nullopt;
+  }
 
-  QueryStats& start() {
-    thread_stats_.push_back({});
-    QueryStats& stat = thread_stats_.back();
+  QueryStats start() {
+    QueryStats stat;
     stat.start_time = std::chrono::steady_clock::now();
     stat.start_wall_time = std::chrono::system_clock::now();
-    return thread_stats_.back();
+    return stat;
   }
 
+  /**
+   * @brief Start measuring from a scheduled send time instead of now, so queueing delay counts as latency
+   * @param scheduled_time When the query was supposed to be sent
+   */
+  QueryStats start(const std::chrono::steady_clock::time_point scheduled_time) {
+    QueryStats stat = start();
+    const auto lag = stat.start_time - scheduled_time;
+    stat.start_time = scheduled_time;
+    stat.start_wall_time -= std::chrono::duration_cast<std::chrono::system_clock::duration>(lag);
+    return stat;
+  }
+
+  /**
+   * @brief Finish measuring an execution and record it in this thread's histogram
+   */
   void stop(QueryStats& stat) {
     const auto end_time = std::chrono::steady_clock::now();
-    stat.duration = std::chrono::duration_cast<std::chrono::microseconds>(end_time - stat.start_time);
+    stop(stat, std::chrono::duration_cast<std::chrono::microseconds>(end_time - stat.start_time));
+  }
+
+  /**
+   * @brief Finish an execution whose duration was measured elsewhere, for example by the server
+   */
+  void stop(QueryStats& stat, const std::chrono::microseconds measured_duration) {
+    stat.duration = measured_duration;
+    auto& thread_latency = thread_latency_[id_];
+    thread_latency.latency.record(stat.duration);
+    if (!thread_latency.first_start_wall_time || stat.start_wall_time < *thread_latency.first_start_wall_time) {
+      thread_latency.first_start_wall_time = stat.start_wall_time;
+    }
   }
 
+  /**
+   * @brief Merge everything this thread recorded for the query into the shared histogram
+   */
   void summariseThread() {
+    const auto it = thread_latency_.find(id_);
+    if (it == thread_latency_.end()) {
+      return;
+    }
     std::lock_guard lock(stats_mutex_);
-    stats_.reserve(stats_.size() + thread_stats_.size());
-    for (auto& s : thread_stats_) {
-      stats_.emplace_back(std::move(s));
+    latency_.merge(it->second.latency);
+    const auto& thread_first = it->second.first_start_wall_time;
+    if (thread_first && (!first_start_wall_time_ || *thread_first < *first_start_wall_time_)) {
+      first_start_wall_time_ = thread_first;
     }
-    thread_stats_.clear();
+    thread_latency_.erase(it);
   }
 };
 }
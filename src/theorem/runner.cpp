@@ -3,7 +3,10 @@
 #include "query.h"
 #include <dbprove/sql/sql_exceptions.h>
 #include <plog/Log.h>
+#include <atomic>
 #include <functional>
+#include <mutex>
+#include <random>
 #include <thread>
 #include <vector>
 
@@ -24,15 +27,15 @@ std::optional<sql::RowCount> expectedRowCountFor(const Query& query, const Proof
   return std::nullopt;
 }
 
-void validateExpectedRowValues(const Query& query, const sql::RowBase& row) {
+void validateExpectedRowValues(const Query& query, const std::vector<sql::SqlVariant>& row) {
   if (!query.expectedRowValues().has_value()) {
     return;
   }
   const auto& expected_values = *query.expectedRowValues();
-  if (row.columnCount() != expected_values.size()) {
+  if (row.size() != expected_values.size()) {
     throw std::runtime_error("Expected " + std::to_string(expected_values.size())
                              + " columns in theorem result row but got "
-                             + std::to_string(row.columnCount()) + " for query: " + query.text());
+                             + std::to_string(row.size()) + " for query: " + query.text());
   }
 
   for (size_t column_index = 0; column_index < expected_values.size(); ++column_index) {
@@ -65,22 +68,221 @@ void validateExpectedRowCount(const Query& query, const Proof& proof,
   throw sql::UnexpectedRowCountException(*expected_row_count, actual_row_count, query.text());
 }
 
-sql::RowCount executeMeasuredQuery(sql::ConnectionBase& connection, Query& query) {
-  auto& qs = query.start();
+/**
+ * Time one client side execution of the query and validate its row count
+ */
+void timeExecution(sql::ConnectionBase& connection, Query& query, const Proof& proof, const size_t query_count) {
+  auto qs = query.start();
+  const auto result = connection.fetchAll(query.textTagged());
+  result->drain();
+  query.stop(qs);
+  query.summariseThread();
+  validateExpectedRowCount(query, proof, expectedRowCountFor(query, proof, query_count), result->rowCount());
+}
+
+/**
+ * Prepare the query when running in prepared mode and record on the query how it is executed
+ * @return nullptr in text mode
+ */
+std::unique_ptr<sql::PreparedStatement> prepareQuery(sql::ConnectionBase& connection, Query& query,
+                                                     const sql::ExecutionMode mode) {
+  if (mode == sql::ExecutionMode::Text) {
+    return nullptr;
+  }
+  const auto start = std::chrono::steady_clock::now();
+  auto prepared = connection.prepare(query.textTagged());
+  const auto prepare_time = std::chrono::duration_cast<std::chrono::microseconds>(
+      std::chrono::steady_clock::now() - start);
+  query.setExecutionMode(prepared->mode(), prepare_time);
+  if (prepared->mode() != mode) {
+    PLOGD << connection.engine().name() << " cannot prepare statements, sending the SQL text on every execution";
+  }
+  return prepared;
+}
+
+std::unique_ptr<sql::ResultBase> fetchAll(sql::ConnectionBase& connection, const Query& query,
+                                          sql::PreparedStatement* prepared) {
+  return prepared ? prepared->fetchAll() : connection.fetchAll(query.textTagged());
+}
+
+/**
+ * Read the single row of a result through `nextBatch`
+ * @throw If the result does not have exactly one row
+ */
+std::vector<sql::SqlVariant> readSingleRow(sql::ResultBase& result, const Query& query) {
+  std::vector<sql::SqlVariant> row;
+  sql::ColumnBatch batch;
+  sql::RowCount rows = 0;
+  while (result.nextBatch(batch, 2)) {
+    rows += batch.rowCount();
+    if (rows > 1) {
+      throw sql::InvalidRowsException("Expected to find a single row in the data, but found more than one",
+                                      query.text());
+    }
+    for (size_t i = 0; i < batch.columnCount() && batch.rowCount() == 1; ++i) {
+      row.push_back(batch.column(i).asVariant(0));
+    }
+  }
+  if (rows == 0) {
+    throw sql::EmptyResultException(query.text());
+  }
+  return row;
+}
+
+sql::RowCount executeMeasuredQuery(sql::ConnectionBase& connection, Query& query,
+                                   sql::PreparedStatement* prepared) {
+  auto qs = query.start();
   if (query.expectedRowValues().has_value()) {
-    auto row = connection.fetchRow(query.textTagged());
+    const auto result = fetchAll(connection, query, prepared);
+    const auto row = readSingleRow(*result, query);
     query.stop(qs);
     query.summariseThread();
-    validateExpectedRowValues(query, *row);
+    validateExpectedRowValues(query, row);
     return 1;
   }
 
-  auto result = connection.fetchAll(query.textTagged());
+  auto result = fetchAll(connection, query, prepared);
   result->drain();
   query.stop(qs);
   query.summariseThread();
   return result->rowCount();
 }
+
+/**
+ * Lock-free pool handing out work tickets to workers through a single atomic cursor.
+ * Without a time budget, the pool hands out `limit` tickets. With a time budget, tickets keep coming
+ * until the budget runs out and queries are handed out cyclically.
+ */
+class QueryPool {
+  std::span<Query> queries_;
+  std::optional<std::chrono::milliseconds> duration_;
+  size_t limit_;
+  std::optional<std::chrono::steady_clock::time_point> deadline_;
+  std::atomic<size_t> cursor_{0};
+  std::atomic<bool> stopped_{false};
+
+public:
+  QueryPool(const std::span<Query> queries, const std::optional<std::chrono::milliseconds> duration,
+            const size_t limit)
+    : queries_(queries)
+    , duration_(duration)
+    , limit_(limit) {
+  }
+
+  /// @brief Start the clock on the time budget. Must be called before workers start claiming
+  void start(const std::chrono::steady_clock::time_point run_start) {
+    if (duration_.has_value()) {
+      deadline_ = run_start + *duration_;
+    }
+  }
+
+  /// @brief Claim the next ticket or nullopt when the pool is exhausted
+  std::optional<size_t> claim() {
+    if (queries_.empty() || stopped_.load(std::memory_order_relaxed)) {
+      return std::nullopt;
+    }
+    if (deadline_.has_value() && std::chrono::steady_clock::now() >= *deadline_) {
+      return std::nullopt;
+    }
+    const auto ticket = cursor_.fetch_add(1, std::memory_order_relaxed);
+    if (!deadline_.has_value() && ticket >= limit_) {
+      return std::nullopt;
+    }
+    return ticket;
+  }
+
+  /// @brief Query belonging to a ticket
+  Query& query(const size_t ticket) const { return queries_[ticket % queries_.size()]; }
+
+  /// @brief Make every worker stop after its current query
+  void stop() { stopped_.store(true, std::memory_order_relaxed); }
+
+  /// @brief Merge the latencies the calling thread recorded into every query of the pool
+  void summariseThread() const {
+    for (auto& query : queries_) {
+      query.summariseThread();
+    }
+  }
+};
+
+/**
+ * Worker loop executed on every session. Receives the connection owned by the worker and the time the
+ * run started. Returns the number of queries the worker completed.
+ */
+using WorkloadWorker = std::function<size_t(sql::ConnectionBase& connection,
+                                            std::chrono::steady_clock::time_point run_start)>;
+
+/**
+ * Leases one connection per worker, starts the clock, and runs `worker` on every session until the pool
+ * is exhausted. The first failure stops the pool and is rethrown once all workers have joined.
+ */
+WorkloadSummary runWorkload(sql::ConnectionFactory& factory, const size_t threadCount, QueryPool& pool,
+                            const WorkloadWorker& worker) {
+  factory.prewarm(threadCount);
+  std::vector<sql::ConnectionLease> connections;
+  connections.reserve(threadCount);
+  for (size_t i = 0; i < threadCount; ++i) {
+    connections.push_back(factory.acquire());
+  }
+
+  const auto run_start = std::chrono::steady_clock::now();
+  pool.start(run_start);
+  std::atomic<size_t> executions{0};
+  std::mutex error_mutex;
+  std::exception_ptr first_error;
+
+  std::vector<std::thread> threads;
+  threads.reserve(threadCount);
+  for (const auto& connection : connections) {
+    threads.emplace_back([&, session = connection.get()] {
+      try {
+        executions.fetch_add(worker(*session, run_start), std::memory_order_relaxed);
+      } catch (...) {
+        pool.stop();
+        std::lock_guard lock(error_mutex);
+        if (!first_error) {
+          first_error = std::current_exception();
+        }
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  const WorkloadSummary summary{
+      .threads = threadCount,
+      .executions = executions.load(),
+      .elapsed = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - run_start)};
+  connections.clear();
+  if (first_error) {
+    std::rethrow_exception(first_error);
+  }
+  return summary;
+}
+
+/**
+ * Offsets from the start of the run at which each query must be sent to sustain the arrival rate
+ */
+std::vector<std::chrono::nanoseconds> arrivalSchedule(const ArrivalRate& rate, const std::chrono::milliseconds duration) {
+  if (rate.qps <= 0.0) {
+    throw std::invalid_argument("Open-loop arrival rate must be positive");
+  }
+  const auto mean_gap = std::chrono::duration<double>(1.0 / rate.qps);
+  std::mt19937_64 generator(rate.seed);
+  std::exponential_distribution<double> poisson_gap(rate.qps);
+
+  std::vector<std::chrono::nanoseconds> schedule;
+  schedule.reserve(static_cast<size_t>(rate.qps * std::chrono::duration<double>(duration).count()) + 1);
+  std::chrono::duration<double> offset{0};
+  while (offset < duration) {
+    schedule.push_back(std::chrono::duration_cast<std::chrono::nanoseconds>(offset));
+    offset += rate.process == ArrivalProcess::Poisson
+                ? std::chrono::duration<double>(poisson_gap(generator))
+                : mean_gap;
+  }
+  return schedule;
+}
 }
 
 void do_threads(const size_t threadCount, std::function<void()> thread_work) {
@@ -95,75 +297,125 @@ void do_threads(const size_t threadCount, std::function<void()> thread_work) {
   }
 }
 
-void Runner::serial(const std::span<Query>& queries, const size_t iterations) const {
-  const auto connection = factory_.create();
+void Runner::serial(const std::span<Query>& queries, const size_t iterations, const sql::ExecutionMode mode) const {
+  const auto connection = factory_.acquire();
+  std::vector<std::unique_ptr<sql::PreparedStatement>> prepared;
+  for (auto& query : queries) {
+    auto statement = prepareQuery(*connection, query, mode);
+    if (statement && statement->mode() == sql::ExecutionMode::Text) {
+      // Nothing was prepared, so time the same `execute` as text mode does
+      statement.reset();
+    }
+    prepared.push_back(std::move(statement));
+  }
   for (size_t i = 0; i < iterations; ++i) {
-    for (auto& query : queries) {
-      auto& qs = query.start();
-      connection->execute(query.textTagged());
+    for (size_t q = 0; q < queries.size(); ++q) {
+      auto& query = queries[q];
+      auto qs = query.start();
+      if (prepared[q]) {
+        prepared[q]->fetchAll()->drain();
+      } else {
+        connection->execute(query.textTagged());
+      }
       query.stop(qs);
       query.summariseThread();
     }
   }
-  connection->close();
 }
 
-void Runner::serial(Query& query, size_t iterations) const {
-  return serial(std::span(&query, 1), iterations);
+void Runner::serial(Query& query, size_t iterations, const sql::ExecutionMode mode) const {
+  return serial(std::span(&query, 1), iterations, mode);
 }
 
 void Runner::parallelApart(const size_t threadCount, std::span<Query>& queries) const {
   auto thread_work = [this, &queries]() {
-    const auto connection = factory_.create();
+    const auto connection = factory_.acquire();
 
     for (auto& query : queries) {
-      auto& qs = query.start();
+      auto qs = query.start();
       connection->execute(query.textTagged());
       query.stop(qs);
       query.summariseThread();
     }
-    connection->close();
   };
+  factory_.prewarm(threadCount);
   do_threads(threadCount, thread_work);
 }
 
-void Runner::parallelTogether(size_t threadCount, std::span<Query>& queries) const {
-  std::atomic<size_t> query_index{0};
-  auto thread_work = [this, &queries, &query_index]() {
-    auto connection = factory_.create();
-    size_t index = query_index++;
-    if (index > queries.size()) {
-      return;
-    }
-    auto& query = queries[index];
+WorkloadSummary Runner::parallelTogether(const size_t threadCount, std::span<Query>& queries,
+                                         const std::optional<std::chrono::milliseconds> duration) const {
+  QueryPool pool(queries, duration, queries.size());
+  const auto summary = runWorkload(factory_, threadCount, pool,
+                                   [&pool](sql::ConnectionBase& connection, std::chrono::steady_clock::time_point) {
+                                     size_t executions = 0;
+                                     while (const auto ticket = pool.claim()) {
+                                       auto& query = pool.query(*ticket);
+                                       auto qs = query.start();
+                                       connection.execute(query.textTagged());
+                                       query.stop(qs);
+                                       ++executions;
+                                     }
+                                     pool.summariseThread();
+                                     return executions;
+                                   });
 
-    auto& qs = query.start();
-    connection->execute(query.textTagged());
-    query.stop(qs);
-    query.summariseThread();
-    connection->close();
-  };
+  PLOGI << "Closed-loop run on " << summary.threads << " sessions completed " << summary.executions
+        << " queries in " << summary.elapsed.count() << " us (" << summary.qps() << " QPS)";
+  return summary;
+}
 
-  do_threads(threadCount, thread_work);
+WorkloadSummary Runner::openLoop(const size_t threadCount, std::span<Query>& queries, const ArrivalRate& rate,
+                                 const std::chrono::milliseconds duration) const {
+  const auto schedule = arrivalSchedule(rate, duration);
+  QueryPool pool(queries, std::nullopt, schedule.size());
+  auto summary = runWorkload(factory_, threadCount, pool,
+                             [&pool, &schedule](sql::ConnectionBase& connection,
+                                                const std::chrono::steady_clock::time_point run_start) {
+                               size_t executions = 0;
+                               while (const auto ticket = pool.claim()) {
+                                 const auto scheduled_time = run_start + schedule[*ticket];
+                                 std::this_thread::sleep_until(scheduled_time);
+                                 auto& query = pool.query(*ticket);
+                                 auto qs = query.start(scheduled_time);
+                                 connection.execute(query.textTagged());
+                                 query.stop(qs);
+                                 ++executions;
+                               }
+                               pool.summariseThread();
+                               return executions;
+                             });
+  summary.offered_qps = rate.qps;
+
+  PLOGI << "Open-loop run on " << summary.threads << " sessions offered " << rate.qps << " QPS and completed "
+        << summary.executions << " queries in " << summary.elapsed.count() << " us (" << summary.qps() << " QPS)";
+  return summary;
 }
 
 void Runner::serialExplain(std::span<Query>& queries, Proof& proof) const {
-  const auto connection = factory_.create();
+  const auto connection = factory_.acquire();
   connection->setQueryTimeout(proof.queryTimeoutSeconds());
   for (auto& query : queries) {
     proof.data.push_back(std::make_unique<DataQuery>(query));
+    if (!proof.artifactMode() && proof.singleExecutionExplain()) {
+      auto measured = connection->explainAndMeasure(query.textTagged(), proof.theorem.name);
+      if (measured.execution_time && measured.rows) {
+        auto qs = query.start();
+        query.stop(qs, *measured.execution_time);
+        query.summariseThread();
+        validateExpectedRowCount(query, proof, expectedRowCountFor(query, proof, queries.size()), *measured.rows);
+      } else {
+        PLOGD << "Explain of '" << proof.theorem.name << "' did not measure the execution; running it separately";
+        timeExecution(*connection, query, proof, queries.size());
+      }
+      proof.data.push_back(std::make_unique<DataExplain>(std::move(measured.plan)));
+      continue;
+    }
     if (!proof.artifactMode()) {
-      auto& qs = query.start();
-      auto result = connection->fetchAll(query.textTagged());
-      result->drain();
-      query.stop(qs);
-      query.summariseThread();
-      validateExpectedRowCount(query, proof, expectedRowCountFor(query, proof, queries.size()), result->rowCount());
+      timeExecution(*connection, query, proof, queries.size());
     }
     auto explain = connection->explain(query.textTagged(), proof.theorem.name);
     proof.data.push_back(std::make_unique<DataExplain>(std::move(explain)));
   }
-  connection->close();
   proof.render();
 }
 
@@ -172,16 +424,16 @@ void Runner::serialMeasure(std::span<Query>& queries, Proof& proof, const size_t
     throw std::runtime_error(
         "Artifact replay mode only supports explain-based theorem runs backed by generated artifacts");
   }
-  const auto connection = factory_.create();
+  const auto connection = factory_.acquire();
   connection->setQueryTimeout(proof.queryTimeoutSeconds());
   for (auto& query : queries) {
     proof.data.push_back(std::make_unique<DataQuery>(query));
+    const auto prepared = prepareQuery(*connection, query, proof.executionMode());
     for (size_t iteration = 0; iteration < iterations; ++iteration) {
-      const auto row_count = executeMeasuredQuery(*connection, query);
+      const auto row_count = executeMeasuredQuery(*connection, query, prepared.get());
       validateExpectedRowCount(query, proof, expectedRowCountFor(query, proof, queries.size()), row_count);
     }
   }
-  connection->close();
   proof.render();
 }
 
@@ -1,9 +1,49 @@
 #pragma once
 #include "theorem.h"
+#include <chrono>
+#include <cstdint>
+#include <optional>
 #include <vector>
 #include <dbprove/sql/sql.h>
 
 namespace dbprove::theorem {
+/**
+ * Throughput summary of a concurrent workload run
+ */
+struct WorkloadSummary {
+  size_t threads = 0;
+  size_t executions = 0;
+  std::chrono::microseconds elapsed{0};
+  /// @brief Target arrival rate for open-loop runs
+  std::optional<double> offered_qps;
+
+  /// @brief Completed queries per second over the whole run
+  [[nodiscard]] double qps() const {
+    if (elapsed.count() == 0) {
+      return 0.0;
+    }
+    return static_cast<double>(executions) * 1'000'000.0 / static_cast<double>(elapsed.count());
+  }
+};
+
+/**
+ * Distribution of the gaps between query arrivals in open-loop runs
+ */
+enum class ArrivalProcess {
+  Constant,
+  Poisson
+};
+
+/**
+ * Target arrival rate of an open-loop run
+ */
+struct ArrivalRate {
+  double qps;
+  ArrivalProcess process = ArrivalProcess::Poisson;
+  /// @brief Seed for the inter-arrival generator so runs are repeatable
+  uint64_t seed = 1;
+};
+
 class Runner {
   sql::ConnectionFactory& factory_;
 
@@ -15,15 +55,17 @@ public:
   /**
    * @brief Serially run the queries
    * @param queries queries to run
+   * @param mode `Prepared` prepares every query once before the timed executions
    */
-  void serial(const std::span<Query>& queries, size_t iterations = 0) const;
+  void serial(const std::span<Query>& queries, size_t iterations = 0,
+              sql::ExecutionMode mode = sql::ExecutionMode::Text) const;
 
   /**
    * @brief As above, but for single query
    * @param query to run
    * @param iterations to run off query
    */
-  void serial(Query& query, size_t iterations = 0) const;
+  void serial(Query& query, size_t iterations = 0, sql::ExecutionMode mode = sql::ExecutionMode::Text) const;
   /**
    * @brief Run the same queries on all threads
    * @param threadCount Number of threads to execute
@@ -32,12 +74,33 @@ public:
   void parallelApart(size_t threadCount, std::span<Query>& queries) const;
 
   /**
-   * @brief Run queries across threads as fast as possible
-   * @param threadCount Number of threads to execute
+   * @brief Closed-loop run of queries across long-lived worker threads, as fast as possible
+   *
+   * Each worker holds its own connection and keeps pulling the next query from a shared pool until the
+   * pool is exhausted. With a `duration` the pool cycles over `queries` until the time budget runs out,
+   * keeping `threadCount` sessions busy for the whole run.
+   * @param threadCount Number of concurrent sessions
    * @param queries Queries to execute. Each thread picks up from the same pool
+   * @param duration Optional time budget. Without it, every query is run exactly once
+   * @return Throughput of the run. Per-query latency is recorded on each `Query`
   */
+  WorkloadSummary parallelTogether(size_t threadCount, std::span<Query>& queries,
+                                   std::optional<std::chrono::milliseconds> duration = std::nullopt) const;
 
-  void parallelTogether(size_t threadCount, std::span<Query>& queries) const;
+  /**
+   * @brief Open-loop run where queries arrive at a target rate regardless of how fast the engine responds
+   *
+   * Send times are scheduled up front and workers claim them in order. Latency is measured from the
+   * scheduled send time rather than the actual one, so time spent waiting for a free session is counted
+   * and coordinated omission is corrected.
+   * @param threadCount Number of concurrent sessions serving the arrivals
+   * @param queries Queries to execute, handed out cyclically
+   * @param rate Target arrival rate and inter-arrival distribution
+   * @param duration Length of the arrival schedule
+   * @return Throughput of the run. Per-query latency is recorded on each `Query`
+   */
+  WorkloadSummary openLoop(size_t threadCount, std::span<Query>& queries, const ArrivalRate& rate,
+                           std::chrono::milliseconds duration) const;
 
   /**
    * Explain queries and add to proof data
@@ -50,6 +113,7 @@ public:
 
   /**
    * Execute queries, validate the row count, and record timing without running EXPLAIN.
+   * In the proof's prepared execution mode each query is prepared once and only the executions are timed.
    * @param queries To run
    * @param proof To update
    */
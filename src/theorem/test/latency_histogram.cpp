@@ -0,0 +1,56 @@
+#include "../latency_histogram.h"
+#include <catch2/catch_test_macros.hpp>
+
+#include <cmath>
+
+namespace dbprove::theorem {
+
+TEST_CASE("Latency histogram is exact below 256us", "[theorem][latency]") {
+  LatencyHistogram histogram;
+  for (int64_t us = 1; us <= 100; ++us) {
+    histogram.record(std::chrono::microseconds(us));
+  }
+  CHECK(histogram.count() == 100);
+  CHECK(histogram.min().count() == 1);
+  CHECK(histogram.max().count() == 100);
+  CHECK(histogram.percentile(50).count() == 50);
+  CHECK(histogram.percentile(99).count() == 99);
+  CHECK(histogram.percentile(100).count() == 100);
+}
+
+TEST_CASE("Latency histogram percentiles stay within one percent", "[theorem][latency]") {
+  LatencyHistogram histogram;
+  for (int64_t i = 1; i <= 1000; ++i) {
+    histogram.record(std::chrono::microseconds(i * 1000));
+  }
+  const auto percentiles = histogram.percentiles();
+  CHECK(percentiles.p50.count() >= 500'000);
+  CHECK(percentiles.p50.count() <= 505'000);
+  CHECK(percentiles.p999.count() >= 999'000);
+  CHECK(percentiles.max.count() == 1'000'000);
+}
+
+TEST_CASE("Latency histogram clamps values above one hour", "[theorem][latency]") {
+  LatencyHistogram histogram;
+  histogram.record(std::chrono::hours(2));
+  CHECK(histogram.max() == std::chrono::hours(2));
+  CHECK(histogram.percentile(50) == std::chrono::hours(2));
+}
+
+TEST_CASE("Latency histogram merge matches single recording", "[theorem][latency]") {
+  LatencyHistogram single;
+  LatencyHistogram left;
+  LatencyHistogram right;
+  for (int64_t us = 1; us <= 10'000; us += 7) {
+    single.record(std::chrono::microseconds(us));
+    (us % 2 == 0 ? left : right).record(std::chrono::microseconds(us));
+  }
+  left.merge(right);
+  CHECK(left.count() == single.count());
+  CHECK(left.min() == single.min());
+  CHECK(left.max() == single.max());
+  CHECK(left.mean() == single.mean());
+  CHECK(left.percentile(90) == single.percentile(90));
+  CHECK(std::abs(left.stddevUs() - single.stddevUs()) < 1e-6);
+}
+}
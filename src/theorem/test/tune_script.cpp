@@ -0,0 +1,102 @@
+#include "../tune_script.h"
+#include <catch2/catch_test_macros.hpp>
+
+namespace dbprove::theorem {
+
+TEST_CASE("Tune script split keeps quoted bodies and blocks together", "[theorem][tune]") {
+  const auto statements = TuneScript::split(R"(
+/* header; with a semicolon */
+SET lock_timeout = 0;
+-- comment; also with one
+DO $$
+BEGIN
+    IF to_regclass('s.a') IS NOT NULL THEN
+        CREATE INDEX IF NOT EXISTS a_x ON s.a (x);
+    END IF;
+END $$;
+WHILE @@FETCH_STATUS = 0
+BEGIN
+    SET @q = 'a;b';
+    FETCH NEXT FROM c INTO @t;
+END
+BEGIN TRANSACTION;
+COMMIT
+)");
+  REQUIRE(statements.size() == 4);
+  CHECK(statements[0] == "SET lock_timeout = 0");
+  CHECK(statements[1].starts_with("DO $$"));
+  CHECK(statements[1].ends_with("END $$"));
+  CHECK(statements[2].starts_with("WHILE"));
+  CHECK(statements[2].ends_with("END\nBEGIN TRANSACTION"));
+  CHECK(statements[3] == "COMMIT");
+}
+
+TEST_CASE("Tune script orders statements that share a table", "[theorem][tune]") {
+  const TuneScript script(R"(
+SET maintenance_work_mem = '1GB';
+ALTER TABLE s.a ADD CONSTRAINT pk_a PRIMARY KEY (id);
+ALTER TABLE s.b ADD CONSTRAINT pk_b PRIMARY KEY (id);
+CREATE INDEX b_a_id ON s.b (a_id);
+IF OBJECT_ID(N's.b', N'U') IS NOT NULL
+   AND NOT EXISTS (SELECT 1 FROM sys.foreign_keys f JOIN sys.objects o ON o.object_id = f.parent_object_id)
+    ALTER TABLE s.b ADD CONSTRAINT fk_b_a FOREIGN KEY (a_id) REFERENCES s.a (id);
+ANALYZE s.c;
+DO $$ BEGIN EXECUTE 'ANALYZE s.a'; END $$;
+ANALYZE s.a;
+)");
+  const auto& steps = script.steps();
+  REQUIRE(steps.size() == 8);
+  CHECK(steps[0].ordered);
+  CHECK(script.sessionSettings() == std::vector<std::string>{"SET maintenance_work_mem = '1GB'"});
+
+  CHECK(steps[1].tables == std::set<std::string>{"a"});
+  CHECK(steps[1].after == std::vector<size_t>{0});
+  CHECK(steps[1].settings == 1);
+  CHECK(steps[2].tables == std::set<std::string>{"b"});
+  CHECK(steps[3].after == std::vector<size_t>{0, 2});
+  CHECK(steps[4].tables == std::set<std::string>{"a", "b"});
+  CHECK(steps[4].after == std::vector<size_t>{0, 1, 3});
+  CHECK(steps[5].after == std::vector<size_t>{0});
+
+  CHECK(steps[6].ordered);
+  CHECK(steps[6].after == std::vector<size_t>{1, 2, 3, 4, 5, 0});
+  CHECK(steps[7].after == std::vector<size_t>{6});
+  CHECK(script.width() == 5);
+}
+
+TEST_CASE("Tune script confines guarded statistics refreshes to their table", "[theorem][tune]") {
+  const TuneScript script(R"(
+DO $$ BEGIN IF (SELECT COALESCE(last_analyze, last_autoanalyze) IS NULL OR n_mod_since_analyze > 0
+                FROM pg_stat_all_tables WHERE relid = to_regclass('s.a'))
+    THEN ANALYZE s.a; END IF; END $$;
+IF EXISTS (SELECT 1 FROM sys.stats st JOIN sys.objects o ON o.object_id = st.object_id
+           WHERE o.object_id = OBJECT_ID(N's.b') AND ISNULL(STATS_DATE(st.object_id, st.stats_id), 0) < o.modify_date)
+    UPDATE STATISTICS s.b;
+)");
+  const auto& steps = script.steps();
+  REQUIRE(steps.size() == 2);
+  CHECK(steps[0].tables == std::set<std::string>{"a"});
+  CHECK(steps[1].tables == std::set<std::string>{"b"});
+  CHECK(script.width() == 2);
+}
+
+TEST_CASE("Tune script keeps transactions and T-SQL variables in one batch", "[theorem][tune]") {
+  const TuneScript script(R"(
+CREATE INDEX a_x ON s.a (x);
+BEGIN TRANSACTION;
+CREATE INDEX b_x ON s.b (x);
+COMMIT;
+CREATE INDEX c_x ON s.c (x);
+DECLARE @t NVARCHAR(255);
+CREATE INDEX d_x ON s.d (x);
+)");
+  const auto& steps = script.steps();
+  REQUIRE(steps.size() == 4);
+  CHECK_FALSE(steps[0].ordered);
+  CHECK(steps[1].ordered);
+  CHECK(steps[1].sql == "BEGIN TRANSACTION;\nCREATE INDEX b_x ON s.b (x);\nCOMMIT");
+  CHECK_FALSE(steps[2].ordered);
+  CHECK(steps[3].ordered);
+  CHECK(steps[3].sql == "DECLARE @t NVARCHAR(255);\nCREATE INDEX d_x ON s.d (x)");
+}
+}
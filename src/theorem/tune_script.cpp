@@ -0,0 +1,495 @@
+#include "tune_script.h"
+
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <condition_variable>
+#include <map>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <dbprove/common/string.h>
+#include <plog/Log.h>
+
+namespace dbprove::theorem {
+namespace {
+/// @brief Words that make a leading `BEGIN` start a transaction rather than a block
+const std::set<std::string_view> transaction_words = {
+    "TRAN", "TRANSACTION", "WORK", "DISTRIBUTED", "ISOLATION", "DEFERRED", "IMMEDIATE", "EXCLUSIVE"};
+
+struct Word {
+  std::string text;
+  size_t depth = 0;
+};
+
+enum class StatementKind {
+  Confined,
+  Ordered,
+  Setting,
+  Declare,
+  BeginTransaction,
+  EndTransaction
+};
+
+bool isIdentifierChar(const char c) {
+  return std::isalnum(static_cast<unsigned char>(c)) || c == '_';
+}
+
+bool isWordChar(const char c) {
+  return isIdentifierChar(c) || c == '.' || c == '@' || c == '#';
+}
+
+/// @brief End of the comment starting at `i`, or `i` if there is none
+size_t skipComment(const std::string_view sql, const size_t i) {
+  if (sql.substr(i, 2) == "--") {
+    const auto end = sql.find('\n', i);
+    return end == std::string_view::npos ? sql.size() : end + 1;
+  }
+  if (sql.substr(i, 2) == "/*") {
+    const auto end = sql.find("*/", i + 2);
+    return end == std::string_view::npos ? sql.size() : end + 2;
+  }
+  return i;
+}
+
+/// @brief End of the quoted text starting at `i`. A doubled closing quote is part of the text
+size_t skipQuoted(const std::string_view sql, const size_t i, const char close) {
+  auto end = i + 1;
+  while (end < sql.size()) {
+    if (sql[end] == close) {
+      if (end + 1 < sql.size() && sql[end + 1] == close) {
+        end += 2;
+        continue;
+      }
+      return end + 1;
+    }
+    ++end;
+  }
+  return sql.size();
+}
+
+/// @brief The `$tag$` delimiter starting at `i`, empty if there is none
+std::string_view dollarTag(const std::string_view sql, const size_t i) {
+  if (sql[i] != '$' || (i > 0 && isIdentifierChar(sql[i - 1]))) {
+    return {};
+  }
+  auto end = i + 1;
+  if (end < sql.size() && std::isdigit(static_cast<unsigned char>(sql[end]))) {
+    return {};
+  }
+  while (end < sql.size() && isIdentifierChar(sql[end])) {
+    ++end;
+  }
+  if (end >= sql.size() || sql[end] != '$') {
+    return {};
+  }
+  return sql.substr(i, end - i + 1);
+}
+
+std::string_view trimStatement(std::string_view statement) {
+  while (!statement.empty()) {
+    if (std::isspace(static_cast<unsigned char>(statement.front()))) {
+      statement.remove_prefix(1);
+      continue;
+    }
+    const auto comment_end = skipComment(statement, 0);
+    if (comment_end == 0) {
+      break;
+    }
+    statement.remove_prefix(comment_end);
+  }
+  while (!statement.empty() && std::isspace(static_cast<unsigned char>(statement.back()))) {
+    statement.remove_suffix(1);
+  }
+  return statement;
+}
+
+/**
+ * Upper cased words of a statement with their parenthesis depth.
+ *
+ * String literals and comments are skipped. Dollar quoted bodies are code in the scripts we run, so they are read
+ * as words too.
+ */
+std::vector<Word> words(const std::string_view sql) {
+  std::vector<Word> result;
+  size_t depth = 0;
+  size_t i = 0;
+  while (i < sql.size()) {
+    const char c = sql[i];
+    if (const auto comment_end = skipComment(sql, i); comment_end != i) {
+      i = comment_end;
+      continue;
+    }
+    if (c == '\'') {
+      i = skipQuoted(sql, i, '\'');
+      continue;
+    }
+    if (const auto tag = dollarTag(sql, i); !tag.empty()) {
+      i += tag.size();
+      continue;
+    }
+    if (c == '(') {
+      ++depth;
+    } else if (c == ')') {
+      depth = depth > 0 ? depth - 1 : 0;
+    }
+    if (!isWordChar(c) && c != '"' && c != '[' && c != '`') {
+      ++i;
+      continue;
+    }
+
+    const auto start = i;
+    while (i < sql.size()) {
+      if (sql[i] == '"' || sql[i] == '`') {
+        i = skipQuoted(sql, i, sql[i]);
+      } else if (sql[i] == '[') {
+        i = skipQuoted(sql, i, ']');
+      } else if (isWordChar(sql[i])) {
+        ++i;
+      } else {
+        break;
+      }
+    }
+    result.push_back({to_upper(sql.substr(start, i - start)), depth});
+  }
+  return result;
+}
+
+/// @brief Unqualified, unquoted and lower cased table name, so differently spelled references still match
+std::string tableName(const std::string_view word) {
+  std::string name;
+  for (const char c : word.substr(word.rfind('.') + 1)) {
+    if (c != '"' && c != '[' && c != ']' && c != '`') {
+      name.push_back(static_cast<char>(std::tolower(static_cast<unsigned char>(c))));
+    }
+  }
+  return name;
+}
+
+/**
+ * Tables a statement is confined to, nullopt if its effect may reach beyond the tables it names.
+ *
+ * Only the top level of the statement names targets. Parenthesised parts are the guards and column lists.
+ */
+std::optional<std::set<std::string>> confinedTables(const std::vector<Word>& words) {
+  static const std::set<std::string_view> leading = {
+      "ALTER", "CREATE", "ANALYZE", "VACUUM", "UPDATE", "OPTIMIZE", "IF", "DO"};
+  static const std::set<std::string_view> unsafe = {
+      "EXEC", "EXECUTE", "SP_EXECUTESQL", "CURSOR", "RENAME", "TRUNCATE", "INSERT", "DELETE", "MERGE", "COMMIT",
+      "ROLLBACK", "GRANT", "REVOKE", "COPY", "CALL", "PERFORM"};
+  static const std::set<std::string_view> index_modifiers = {
+      "UNIQUE", "CLUSTERED", "NONCLUSTERED", "COLUMNSTORE"};
+  static const std::set<std::string_view> targets = {
+      "ON", "TABLE", "REFERENCES", "ANALYZE", "VACUUM", "OPTIMIZE"};
+  static const std::set<std::string_view> target_modifiers = {
+      "IF", "NOT", "EXISTS", "ONLY", "TABLE", "VERBOSE", "FULL", "FREEZE", "ANALYZE", "SKIP_LOCKED"};
+
+  if (words.empty() || !leading.contains(words.front().text)) {
+    return std::nullopt;
+  }
+  const auto next = [&words](const size_t i) -> std::string_view {
+    return i < words.size() ? std::string_view(words[i].text) : std::string_view();
+  };
+
+  std::set<std::string> tables;
+  for (size_t i = 0; i < words.size(); ++i) {
+    const auto& word = words[i].text;
+    if (unsafe.contains(word) || (word == "DECLARE" && words.front().text != "DO")) {
+      return std::nullopt;
+    }
+    if (word == "UPDATE" && next(i + 1) != "STATISTICS") {
+      return std::nullopt;
+    }
+    if (word == "ALTER" && next(i + 1) != "TABLE" && next(i + 1) != "COLUMN") {
+      return std::nullopt;
+    }
+    if (word == "CREATE") {
+      auto k = i + 1;
+      while (index_modifiers.contains(next(k))) {
+        ++k;
+      }
+      if (next(k) != "INDEX" && next(k) != "STATISTICS") {
+        return std::nullopt;
+      }
+    }
+    if (word == "DROP") {
+      // Only an index dropped by `DROP INDEX <name> ON <table>` says which table it belongs to
+      auto k = i + 2;
+      if (next(k) == "IF" && next(k + 1) == "EXISTS") {
+        k += 2;
+      }
+      if (next(i + 1) != "INDEX" || next(k + 1) != "ON") {
+        return std::nullopt;
+      }
+    }
+    if (words[i].depth > 0) {
+      continue;
+    }
+    if (targets.contains(word) || (word == "STATISTICS" && i > 0 && words[i - 1].text == "UPDATE")) {
+      auto k = i + 1;
+      while (target_modifiers.contains(next(k))) {
+        ++k;
+      }
+      if (k < words.size() && words[k].depth == 0) {
+        tables.insert(tableName(words[k].text));
+      }
+    }
+  }
+  if (tables.empty()) {
+    return std::nullopt;
+  }
+  return tables;
+}
+
+StatementKind statementKind(const std::vector<Word>& words) {
+  if (words.empty()) {
+    return StatementKind::Ordered;
+  }
+  const auto& first = words.front().text;
+  const std::string_view second = words.size() > 1 ? std::string_view(words[1].text) : std::string_view();
+  if (first == "SET") {
+    return second.starts_with('@') || second == "LOCAL" || second == "TRANSACTION"
+               ? StatementKind::Ordered
+               : StatementKind::Setting;
+  }
+  if (first == "DECLARE") {
+    return StatementKind::Declare;
+  }
+  if ((first == "BEGIN" && (second.empty() || transaction_words.contains(second)))
+      || (first == "START" && second == "TRANSACTION")) {
+    return StatementKind::BeginTransaction;
+  }
+  if (first == "COMMIT" || first == "ROLLBACK" || first == "ABORT" || first == "END") {
+    return StatementKind::EndTransaction;
+  }
+  return confinedTables(words) ? StatementKind::Confined : StatementKind::Ordered;
+}
+
+std::string describe(const TuneStep& step) {
+  if (step.ordered) {
+    return "ordered batch";
+  }
+  return join(std::vector<std::string>(step.tables.begin(), step.tables.end()), ", ");
+}
+}
+
+std::vector<std::string_view> TuneScript::split(const std::string_view sql) {
+  std::vector<std::string_view> statements;
+  const auto push = [&statements](const std::string_view statement) {
+    if (const auto trimmed = trimStatement(statement); !trimmed.empty()) {
+      statements.push_back(trimmed);
+    }
+  };
+
+  size_t start = 0;
+  size_t depth = 0;
+  size_t i = 0;
+  while (i < sql.size()) {
+    const char c = sql[i];
+    if (const auto comment_end = skipComment(sql, i); comment_end != i) {
+      i = comment_end;
+      continue;
+    }
+    if (c == '\'' || c == '"' || c == '`') {
+      i = skipQuoted(sql, i, c);
+      continue;
+    }
+    if (const auto tag = dollarTag(sql, i); !tag.empty()) {
+      const auto end = sql.find(tag, i + tag.size());
+      i = end == std::string_view::npos ? sql.size() : end + tag.size();
+      continue;
+    }
+    if (std::isalpha(static_cast<unsigned char>(c)) && (i == 0 || !isWordChar(sql[i - 1]))) {
+      auto end = i;
+      while (end < sql.size() && isIdentifierChar(sql[end])) {
+        ++end;
+      }
+      const auto word = to_upper(sql.substr(i, end - i));
+      if (word == "CASE") {
+        ++depth;
+      } else if (word == "END" && depth > 0) {
+        --depth;
+      } else if (word == "BEGIN") {
+        // `BEGIN` opens a block unless it starts a transaction
+        auto next = end;
+        while (next < sql.size() && std::isspace(static_cast<unsigned char>(sql[next]))) {
+          ++next;
+        }
+        auto next_end = next;
+        while (next_end < sql.size() && isIdentifierChar(sql[next_end])) {
+          ++next_end;
+        }
+        const bool transaction = next >= sql.size() || sql[next] == ';'
+                                 || transaction_words.contains(to_upper(sql.substr(next, next_end - next)));
+        depth += transaction ? 0 : 1;
+      }
+      i = end;
+      continue;
+    }
+    if (c == ';' && depth == 0) {
+      push(sql.substr(start, i - start));
+      start = i + 1;
+    }
+    ++i;
+  }
+  push(sql.substr(start));
+  return statements;
+}
+
+TuneScript::TuneScript(const std::string_view sql) {
+  std::map<std::string, size_t> last_by_table;
+  std::vector<size_t> phase;
+  std::optional<size_t> barrier;
+  std::string_view batch;
+  bool in_transaction = false;
+  bool declared = false;
+
+  const auto flushBatch = [&] {
+    width_ = std::max(width_, phase.size());
+    if (batch.empty()) {
+      return;
+    }
+    TuneStep step{.sql = std::string(batch), .after = phase, .settings = settings_.size()};
+    if (barrier) {
+      step.after.push_back(*barrier);
+    }
+    barrier = steps_.size();
+    steps_.push_back(std::move(step));
+    phase.clear();
+    last_by_table.clear();
+    batch = {};
+  };
+
+  for (const auto statement : split(sql)) {
+    const auto statement_words = words(statement);
+    auto kind = statementKind(statement_words);
+    if (in_transaction || declared) {
+      in_transaction = in_transaction && kind != StatementKind::EndTransaction;
+      kind = StatementKind::Ordered;
+    }
+    switch (kind) {
+      case StatementKind::Setting:
+        settings_.emplace_back(statement);
+        break;
+      case StatementKind::Declare:
+        declared = true;
+        break;
+      case StatementKind::BeginTransaction:
+        in_transaction = true;
+        break;
+      default:
+        break;
+    }
+    if (kind != StatementKind::Confined) {
+      // Ordered statements stay in one batch, so T-SQL variables and open transactions span them
+      batch = batch.empty()
+                  ? statement
+                  : std::string_view(batch.data(), statement.data() + statement.size() - batch.data());
+      continue;
+    }
+
+    flushBatch();
+    TuneStep step{.sql = std::string(statement), .ordered = false, .settings = settings_.size()};
+    step.tables = *confinedTables(statement_words);
+    if (barrier) {
+      step.after.push_back(*barrier);
+    }
+    for (const auto& table : step.tables) {
+      if (const auto it = last_by_table.find(table); it != last_by_table.end()) {
+        step.after.push_back(it->second);
+      }
+      last_by_table[table] = steps_.size();
+    }
+    std::ranges::sort(step.after);
+    step.after.erase(std::ranges::unique(step.after).begin(), step.after.end());
+    phase.push_back(steps_.size());
+    steps_.push_back(std::move(step));
+  }
+  flushBatch();
+}
+
+void TuneScript::run(sql::ConnectionBase& primary,
+                     const std::function<std::unique_ptr<sql::ConnectionBase>()>& connect,
+                     const size_t connection_count) const {
+  std::mutex mutex;
+  std::condition_variable changed;
+  std::vector<bool> claimed(steps_.size(), false);
+  std::vector<bool> done(steps_.size(), false);
+  size_t remaining = steps_.size();
+  std::exception_ptr error;
+
+  const auto readyStep = [&](const bool is_primary) -> std::optional<size_t> {
+    for (size_t i = 0; i < steps_.size(); ++i) {
+      if (claimed[i] || (steps_[i].ordered && !is_primary)) {
+        continue;
+      }
+      if (std::ranges::all_of(steps_[i].after, [&done](const size_t j) { return done[j]; })) {
+        return i;
+      }
+    }
+    return std::nullopt;
+  };
+
+  const auto work = [&](sql::ConnectionBase* connection) {
+    const bool is_primary = connection != nullptr;
+    std::unique_ptr<sql::ConnectionBase> owned;
+    size_t applied_settings = 0;
+    while (true) {
+      std::optional<size_t> index;
+      {
+        std::unique_lock lock(mutex);
+        changed.wait(lock, [&] {
+          index = error || remaining == 0 ? std::nullopt : readyStep(is_primary);
+          return error || remaining == 0 || index;
+        });
+        if (!index) {
+          return;
+        }
+        claimed[*index] = true;
+      }
+
+      const auto& step = steps_[*index];
+      try {
+        if (!connection) {
+          owned = connect();
+          connection = owned.get();
+        }
+        // The primary connection ran every setting itself as part of the ordered batches
+        for (; !is_primary && applied_settings < step.settings; ++applied_settings) {
+          connection->execute(settings_[applied_settings]);
+        }
+        const auto start = std::chrono::steady_clock::now();
+        connection->execute(step.sql);
+        PLOGD << "Tune step " << *index + 1 << "/" << steps_.size() << " (" << describe(step) << ") took "
+              << std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count()
+              << " ms";
+      } catch (...) {
+        std::lock_guard lock(mutex);
+        if (!error) {
+          error = std::current_exception();
+        }
+        changed.notify_all();
+        return;
+      }
+
+      {
+        std::lock_guard lock(mutex);
+        done[*index] = true;
+        --remaining;
+      }
+      changed.notify_all();
+    }
+  };
+
+  {
+    std::vector<std::jthread> workers;
+    for (size_t i = 1; i < connection_count; ++i) {
+      workers.emplace_back(work, nullptr);
+    }
+    work(&primary);
+  }
+  if (error) {
+    std::rethrow_exception(error);
+  }
+}
+}
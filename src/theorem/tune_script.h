@@ -0,0 +1,67 @@
+#pragma once
+#include <functional>
+#include <memory>
+#include <set>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <dbprove/sql/sql.h>
+
+namespace dbprove::theorem {
+/**
+ * One unit of work of a `TuneScript`
+ */
+struct TuneStep {
+  /// @brief Statements to send in one `execute`. Runs of ordered statements are kept as one batch
+  std::string sql;
+  /// @brief Must run on the primary connection after every earlier step and before every later one
+  bool ordered = true;
+  /// @brief Tables the step touches, empty for ordered steps
+  std::set<std::string> tables;
+  /// @brief Steps that must complete before this one starts
+  std::vector<size_t> after;
+  /// @brief Number of session settings a connection must have applied before running the step
+  size_t settings = 0;
+};
+
+/**
+ * A dataset tune script split into statements and planned for concurrent execution.
+ *
+ * Statements whose effect is confined to the tables they name run unordered: index and constraint creation,
+ * statistics, and `IF`/`DO` blocks guarding only those. Two such statements are ordered when they name a common
+ * table, including through `REFERENCES`. Everything else is an ordered barrier on the primary connection,
+ * as is every statement inside a transaction or after a T-SQL `DECLARE`, since variables only live in their batch.
+ *
+ * `SET` statements are ordered and replayed on the other connections before the steps that follow them.
+ */
+class TuneScript {
+public:
+  explicit TuneScript(std::string_view sql);
+
+  /**
+   * @brief Split a script on top level `;`
+   *
+   * Quotes, comments, dollar quoted bodies and T-SQL `BEGIN`/`END` and `CASE`/`END` blocks are kept intact.
+   * @return Statements without their terminating `;`, trimmed of surrounding whitespace and comments
+   */
+  static std::vector<std::string_view> split(std::string_view sql);
+
+  [[nodiscard]] const std::vector<TuneStep>& steps() const { return steps_; }
+  [[nodiscard]] const std::vector<std::string>& sessionSettings() const { return settings_; }
+  /// @brief Largest number of unordered steps between two ordered ones, an upper bound on useful connections
+  [[nodiscard]] size_t width() const { return width_; }
+
+  /**
+   * @brief Execute the steps over `primary` and up to `connection_count - 1` connections made by `connect`.
+   *
+   * Stops handing out steps after the first failure and rethrows it once running steps are done.
+   */
+  void run(sql::ConnectionBase& primary, const std::function<std::unique_ptr<sql::ConnectionBase>()>& connect,
+           size_t connection_count) const;
+
+private:
+  std::vector<TuneStep> steps_;
+  std::vector<std::string> settings_;
+  size_t width_ = 0;
+};
+}
@@ -0,0 +1,99 @@
+#include "theorem.h"
+#include "runner.h"
+#include "init.h"
+#include "query.h"
+
+#include <chrono>
+#include <format>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace dbprove::theorem::wlm {
+namespace {
+constexpr std::string_view kRoundtripSql = "SELECT 1";
+constexpr size_t kOpenLoopSessions = 32;
+constexpr std::chrono::milliseconds kRunDuration{10'000};
+const std::vector<int> kOfferedLoads = {10, 50, 100, 250, 500, 1000, 2500, 5000};
+const std::vector<size_t> kSessionCounts = {1, 8, 32, 128};
+
+void requireLiveEngine(const Proof& proof) {
+  if (proof.artifactMode()) {
+    throw std::runtime_error("Artifact replay mode does not support WLM workload theorems");
+  }
+}
+
+void recordWorkload(Proof& proof, Query& query, const WorkloadSummary& summary) {
+  proof.data.push_back(std::make_unique<DataQuery>(query));
+  proof.setWorkload(WorkloadProofData{.sessions = summary.threads,
+                                      .executions = summary.executions,
+                                      .achieved_qps = summary.qps(),
+                                      .offered_qps = summary.offered_qps});
+  proof.render();
+  auto& out = proof.console();
+  out << "Sessions: " << summary.threads << ", executions: " << summary.executions;
+  if (summary.offered_qps.has_value()) {
+    out << ", offered: " << *summary.offered_qps << " QPS";
+  }
+  out << ", achieved: " << summary.qps() << " QPS" << std::endl;
+}
+
+void runOpenLoop(Proof& proof, const int offered_qps) {
+  requireLiveEngine(proof);
+  std::vector<Query> queries;
+  queries.emplace_back(kRoundtripSql, proof.theorem.name.c_str());
+  auto span = std::span(queries);
+  const Runner runner(proof.factory());
+  const auto summary = runner.openLoop(kOpenLoopSessions, span, ArrivalRate{.qps = static_cast<double>(offered_qps)},
+                                       kRunDuration);
+  recordWorkload(proof, queries.front(), summary);
+}
+
+void runClosedLoop(Proof& proof, const size_t sessions) {
+  requireLiveEngine(proof);
+  std::vector<Query> queries;
+  queries.emplace_back(kRoundtripSql, proof.theorem.name.c_str());
+  auto span = std::span(queries);
+  const Runner runner(proof.factory());
+  const auto summary = runner.parallelTogether(sessions, span, kRunDuration);
+  recordWorkload(proof, queries.front(), summary);
+}
+
+void registerOpenLoop(const int offered_qps) {
+  auto& theorem = addTheorem(
+      std::format("WLM-OPEN-LOOP-{:05}", offered_qps),
+      "Roundtrip latency with " + std::to_string(offered_qps) + " queries per second offered on "
+      + std::to_string(kOpenLoopSessions) + " sessions",
+      [offered_qps](Proof& proof) { runOpenLoop(proof, offered_qps); });
+  categoriseTheorem(theorem, Category::WLM);
+  tagTheorem(theorem, Tag("OPEN-LOOP"));
+  tagTheorem(theorem, Tag(std::string{opt_in_tag}));
+}
+
+void registerClosedLoop(const size_t sessions) {
+  auto& theorem = addTheorem(
+      std::format("WLM-SESSIONS-{:03}", sessions),
+      "Roundtrip throughput with " + std::to_string(sessions) + " concurrent sessions",
+      [sessions](Proof& proof) { runClosedLoop(proof, sessions); });
+  categoriseTheorem(theorem, Category::WLM);
+  tagTheorem(theorem, Tag("CLOSED-LOOP"));
+  tagTheorem(theorem, Tag(std::string{opt_in_tag}));
+}
+}
+
+void init() {
+  static bool is_initialised = false;
+  if (is_initialised) {
+    return;
+  }
+
+  for (const int offered_qps : kOfferedLoads) {
+    registerOpenLoop(offered_qps);
+  }
+  for (const size_t sessions : kSessionCounts) {
+    registerClosedLoop(sessions);
+  }
+
+  is_initialised = true;
+}
+}
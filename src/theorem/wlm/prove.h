@@ -1,9 +1,5 @@
 #pragma once
-#include <string>
-#include <vector>
 
-namespace wlm {
-    void prove(std::vector<std::string> theorems, sql::Engine engine, const sql::Credential credentials) {
-
-    }
+namespace dbprove::theorem::wlm {
+void init();
 }